@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ActionLatencyRecorder.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "Misc/ScopeLock.h"
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(ActionLatencyChannel)
+
+UE_TRACE_EVENT_BEGIN(NightFisherman, ActionLatency)
+	UE_TRACE_EVENT_FIELD(uint64, ReceiptCycle)
+	UE_TRACE_EVENT_FIELD(uint64, HandlerCycle)
+	UE_TRACE_EVENT_FIELD(uint64, VisibleCycle)
+	UE_TRACE_EVENT_FIELD(uint8, Action)
+UE_TRACE_EVENT_END()
+
+namespace ActionLatencyRecorder
+{
+	/** Milliseconds Stage took in Sample, or a negative value if the sample has no receipt to measure it from */
+	static float GetStageMs(const FActionLatencySample& Sample, FActionLatencyRecorder::EStage Stage)
+	{
+		using EStage = FActionLatencyRecorder::EStage;
+
+		const bool bNeedsReceipt = Stage != EStage::HandlerToVisible;
+		if (bNeedsReceipt && Sample.ReceiptCycles == 0)
+		{
+			return -1.0f;
+		}
+
+		const uint64 Begin = bNeedsReceipt ? Sample.ReceiptCycles : Sample.HandlerCycles;
+		const uint64 End = Stage == EStage::InputToHandler ? Sample.HandlerCycles : Sample.VisibleCycles;
+		return static_cast<float>(FPlatformTime::ToMilliseconds64(End - Begin));
+	}
+
+	/** Nearest-rank percentile of sorted values */
+	static float GetPercentile(const TArray<float>& Sorted, float Percent)
+	{
+		const int32 Rank = FMath::CeilToInt32(Percent / 100.0f * Sorted.Num());
+		return Sorted[FMath::Clamp(Rank - 1, 0, Sorted.Num() - 1)];
+	}
+}
+
+void FActionLatencyRecorder::Add(const FActionLatencySample& Sample)
+{
+	UE_TRACE_LOG(NightFisherman, ActionLatency, ActionLatencyChannel)
+		<< ActionLatency.ReceiptCycle(Sample.ReceiptCycles)
+		<< ActionLatency.HandlerCycle(Sample.HandlerCycles)
+		<< ActionLatency.VisibleCycle(Sample.VisibleCycles)
+		<< ActionLatency.Action(static_cast<uint8>(Sample.Action));
+
+	FScopeLock ScopeLock(&Lock);
+	if (Samples.Num() < Capacity)
+	{
+		Samples.Add(Sample);
+	}
+	else
+	{
+		Samples[NextSample] = Sample;
+		NextSample = (NextSample + 1) % Capacity;
+	}
+}
+
+void FActionLatencyRecorder::AddNoEffect(ETopDownInputAction Action)
+{
+	FScopeLock ScopeLock(&Lock);
+	++NumNoEffect[static_cast<int32>(Action)];
+}
+
+void FActionLatencyRecorder::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Samples.Reset();
+	NextSample = 0;
+	FMemory::Memzero(NumNoEffect);
+}
+
+int32 FActionLatencyRecorder::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Samples.Num();
+}
+
+FActionLatencyPercentiles FActionLatencyRecorder::ComputePercentiles(ETopDownInputAction Action, EStage Stage) const
+{
+	TArray<float> Values;
+	{
+		FScopeLock ScopeLock(&Lock);
+		for (const FActionLatencySample& Sample : Samples)
+		{
+			const float Ms = Sample.Action == Action ? ActionLatencyRecorder::GetStageMs(Sample, Stage) : -1.0f;
+			if (Ms >= 0.0f)
+			{
+				Values.Add(Ms);
+			}
+		}
+	}
+
+	FActionLatencyPercentiles Percentiles;
+	Percentiles.NumSamples = Values.Num();
+	if (Values.Num() > 0)
+	{
+		Values.Sort();
+		Percentiles.P50 = ActionLatencyRecorder::GetPercentile(Values, 50.0f);
+		Percentiles.P90 = ActionLatencyRecorder::GetPercentile(Values, 90.0f);
+		Percentiles.P99 = ActionLatencyRecorder::GetPercentile(Values, 99.0f);
+		Percentiles.Max = Values.Last();
+	}
+	return Percentiles;
+}
+
+int32 FActionLatencyRecorder::GetNumNoEffect(ETopDownInputAction Action) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return NumNoEffect[static_cast<int32>(Action)];
+}
+
+void FActionLatencyRecorder::Report(const FString& Name) const
+{
+	NightFishermanBenchmark::FCsvWriter Csv(Name, { TEXT("Action"), TEXT("Stage"), TEXT("Samples"), TEXT("NoEffect"), TEXT("P50Ms"), TEXT("P90Ms"), TEXT("P99Ms"), TEXT("MaxMs") });
+
+	for (int32 ActionIndex = 0; ActionIndex < static_cast<int32>(ETopDownInputAction::Count); ++ActionIndex)
+	{
+		const ETopDownInputAction Action = static_cast<ETopDownInputAction>(ActionIndex);
+		const FString ActionName = StaticEnum<ETopDownInputAction>()->GetNameStringByValue(ActionIndex);
+		const int32 NoEffect = GetNumNoEffect(Action);
+
+		const FActionLatencyPercentiles Handled = ComputePercentiles(Action, EStage::HandlerToVisible);
+		if (Handled.NumSamples == 0 && NoEffect == 0)
+		{
+			continue;
+		}
+
+		for (int32 StageIndex = 0; StageIndex < static_cast<int32>(EStage::Count); ++StageIndex)
+		{
+			const EStage Stage = static_cast<EStage>(StageIndex);
+			const FActionLatencyPercentiles Percentiles = ComputePercentiles(Action, Stage);
+			Csv.AddRow(ActionName, GetStageName(Stage), Percentiles.NumSamples, NoEffect, Percentiles.P50, Percentiles.P90, Percentiles.P99, Percentiles.Max);
+
+			if (Stage == EStage::InputToVisible)
+			{
+				UE_LOG(LogNightFisherman, Display, TEXT("%s latency over %d presses (%d without effect): p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms"),
+					*ActionName, Percentiles.NumSamples, NoEffect, Percentiles.P50, Percentiles.P90, Percentiles.P99, Percentiles.Max);
+			}
+		}
+	}
+
+	if (Csv.NumRows() == 0)
+	{
+		UE_LOG(LogNightFisherman, Display, TEXT("No action latency samples recorded yet"));
+		return;
+	}
+	Csv.Save();
+}
+
+const TCHAR* FActionLatencyRecorder::GetStageName(EStage Stage)
+{
+	switch (Stage)
+	{
+	case EStage::InputToHandler:
+		return TEXT("InputToHandler");
+	case EStage::HandlerToVisible:
+		return TEXT("HandlerToVisible");
+	case EStage::InputToVisible:
+		return TEXT("InputToVisible");
+	default:
+		return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,85 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TopDownCharacter.h"
+#include "HAL/CriticalSection.h"
+
+/** Timestamps of one press of an action, in FPlatformTime cycles */
+struct FActionLatencySample
+{
+	/** The input event reached the game, or 0 if no key press was seen for it, e.g. an analog trigger */
+	uint64 ReceiptCycles = 0;
+
+	/** The character's handler started */
+	uint64 HandlerCycles = 0;
+
+	/** The render thread finished the frame that first shows the action's effect */
+	uint64 VisibleCycles = 0;
+
+	ETopDownInputAction Action = ETopDownInputAction::Count;
+};
+
+/** Latency percentiles of one stage of one action, in milliseconds */
+struct FActionLatencyPercentiles
+{
+	int32 NumSamples = 0;
+	float P50 = 0.0f;
+	float P90 = 0.0f;
+	float P99 = 0.0f;
+	float Max = 0.0f;
+};
+
+/**
+ * Keeps the latest Capacity action latency samples in a ring buffer and summarizes them as percentiles.
+ * Every sample is also traced as a NightFisherman.ActionLatency event on the ActionLatency channel, so
+ * Unreal Insights captures started with -trace=default,ActionLatency line presses up with the frames around them.
+ * Samples complete on the render thread while reports run on the game thread, so every call takes a lock;
+ * there is one sample per button press, so it is never contended.
+ */
+class NIGHT_FISHERMAN_API FActionLatencyRecorder
+{
+public:
+	static constexpr int32 Capacity = 4096;
+
+	enum class EStage : uint8
+	{
+		/** Receipt to handler: waiting for the next input evaluation in the player controller tick */
+		InputToHandler,
+		/** Handler to visible: the rest of the game frame and the render thread frame */
+		HandlerToVisible,
+		/** Receipt to visible, what the player feels */
+		InputToVisible,
+		Count
+	};
+
+	/** Stores a completed sample, overwriting the oldest one once full, and traces it */
+	void Add(const FActionLatencySample& Sample);
+
+	/** Counts a press whose handler ran without a visible effect, e.g. a dodge still on cooldown */
+	void AddNoEffect(ETopDownInputAction Action);
+
+	void Reset();
+
+	int32 Num() const;
+
+	/** Percentiles of Stage over the retained samples of Action */
+	FActionLatencyPercentiles ComputePercentiles(ETopDownInputAction Action, EStage Stage) const;
+
+	int32 GetNumNoEffect(ETopDownInputAction Action) const;
+
+	/** Logs the percentiles of every action with samples and writes them to Saved/Benchmarks/<Name>.csv */
+	void Report(const FString& Name) const;
+
+	static const TCHAR* GetStageName(EStage Stage);
+
+private:
+	mutable FCriticalSection Lock;
+	TArray<FActionLatencySample> Samples;
+
+	/** Slot the next sample goes into once the ring is full */
+	int32 NextSample = 0;
+
+	int32 NumNoEffect[static_cast<int32>(ETopDownInputAction::Count)] = {};
+};
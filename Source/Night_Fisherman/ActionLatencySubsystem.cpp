@@ -0,0 +1,199 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ActionLatencySubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/World.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "Misc/CoreDelegates.h"
+#include "RenderingThread.h"
+
+/** Sees key and mouse button presses as Slate receives them, before widgets or the player controller do */
+class FActionLatencyInputProcessor : public IInputProcessor
+{
+public:
+	explicit FActionLatencyInputProcessor(UActionLatencySubsystem& InOwner)
+		: Owner(&InOwner)
+	{
+	}
+
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
+	{
+	}
+
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override
+	{
+		if (!InKeyEvent.IsRepeat())
+		{
+			Owner->HandleKeyDown(InKeyEvent.GetKey());
+		}
+		return false;
+	}
+
+	virtual bool HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override
+	{
+		Owner->HandleKeyDown(MouseEvent.GetEffectingButton());
+		return false;
+	}
+
+	virtual const TCHAR* GetDebugName() const override
+	{
+		return TEXT("NightFishermanActionLatency");
+	}
+
+private:
+	/** Unregisters this processor before it goes away */
+	UActionLatencySubsystem* Owner;
+};
+
+namespace ActionLatency
+{
+	/** A press older than this when its handler runs was not what triggered it, e.g. a UI widget consumed it */
+	static constexpr double MaxReceiptAgeSeconds = 0.5;
+}
+
+void UActionLatencySubsystem::TrackAction(ETopDownInputAction Action, const UInputAction* InputAction, const UInputMappingContext* Mapping)
+{
+	if (!InputAction || !Mapping)
+	{
+		return;
+	}
+
+	bTracked[static_cast<int32>(Action)] = true;
+	for (const FEnhancedActionKeyMapping& KeyMapping : Mapping->GetMappings())
+	{
+		if (KeyMapping.Action == InputAction)
+		{
+			KeyActions.AddUnique(KeyMapping.Key, Action);
+		}
+	}
+}
+
+void UActionLatencySubsystem::HandleKeyDown(const FKey& Key)
+{
+	const uint64 Now = FPlatformTime::Cycles64();
+	for (auto It = KeyActions.CreateConstKeyIterator(Key); It; ++It)
+	{
+		PendingReceipt[static_cast<int32>(It.Value())] = Now;
+	}
+}
+
+void UActionLatencySubsystem::BeginAction(ETopDownInputAction Action)
+{
+	const int32 Index = static_cast<int32>(Action);
+	if (!bTracked[Index])
+	{
+		return;
+	}
+
+	const uint64 Now = FPlatformTime::Cycles64();
+	const uint64 Receipt = PendingReceipt[Index];
+	PendingReceipt[Index] = 0;
+
+	FActionLatencySample& Sample = InFlight[Index];
+	Sample.Action = Action;
+	Sample.ReceiptCycles = Receipt != 0 && FPlatformTime::ToSeconds64(Now - Receipt) <= ActionLatency::MaxReceiptAgeSeconds ? Receipt : 0;
+	Sample.HandlerCycles = Now;
+	Sample.VisibleCycles = 0;
+}
+
+void UActionLatencySubsystem::MarkEffect(ETopDownInputAction Action)
+{
+	FActionLatencySample& Sample = InFlight[static_cast<int32>(Action)];
+	if (Sample.HandlerCycles != 0)
+	{
+		FrameEffects.Add(Sample);
+		Sample.HandlerCycles = 0;
+	}
+}
+
+void UActionLatencySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FSlateApplication::IsInitialized())
+	{
+		InputProcessor = MakeShared<FActionLatencyInputProcessor>(*this);
+		FSlateApplication::Get().RegisterInputPreProcessor(InputProcessor);
+	}
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UActionLatencySubsystem::HandleEndFrame);
+}
+
+void UActionLatencySubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	if (InputProcessor && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().UnregisterInputPreProcessor(InputProcessor);
+	}
+	InputProcessor.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UActionLatencySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UActionLatencySubsystem::HandleEndFrame()
+{
+	// Handlers that did nothing visible, e.g. a dodge on cooldown, have no latency to measure
+	for (FActionLatencySample& Sample : InFlight)
+	{
+		if (Sample.HandlerCycles != 0)
+		{
+			Recorder->AddNoEffect(Sample.Action);
+			Sample.HandlerCycles = 0;
+		}
+	}
+
+	if (FrameEffects.IsEmpty())
+	{
+		return;
+	}
+
+	// Queued behind the frame's scene rendering, so it runs once the render thread has drawn the effect
+	ENQUEUE_RENDER_COMMAND(ActionLatencyVisible)([Recorder = Recorder, Samples = MoveTemp(FrameEffects)](FRHICommandListImmediate& RHICmdList) mutable
+	{
+		const uint64 Now = FPlatformTime::Cycles64();
+		for (FActionLatencySample& Sample : Samples)
+		{
+			Sample.VisibleCycles = Now;
+			Recorder->Add(Sample);
+		}
+	});
+	FrameEffects.Reset();
+}
+
+namespace ActionLatency
+{
+	static FAutoConsoleCommandWithWorldAndArgs ReportCommand(
+		TEXT("NF.Latency.Report"),
+		TEXT("Logs press-to-visible latency percentiles of the player's actions and writes them to Saved/Benchmarks. Usage: NF.Latency.Report [Name=ActionLatency]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const UActionLatencySubsystem* Latency = World ? World->GetSubsystem<UActionLatencySubsystem>() : nullptr;
+			if (!Latency)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Latency.Report needs a game world"));
+				return;
+			}
+
+			Latency->GetRecorder().Report(Args.IsValidIndex(0) ? Args[0] : FString(TEXT("ActionLatency")));
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs ResetCommand(
+		TEXT("NF.Latency.Reset"),
+		TEXT("Discards the action latency samples recorded so far."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UActionLatencySubsystem* Latency = World ? World->GetSubsystem<UActionLatencySubsystem>() : nullptr)
+			{
+				Latency->ResetRecorder();
+			}
+		}));
+}
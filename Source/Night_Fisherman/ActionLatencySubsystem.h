@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActionLatencyRecorder.h"
+#include "InputCoreTypes.h"
+#include "ActionLatencySubsystem.generated.h"
+
+class UInputAction;
+class UInputMappingContext;
+
+/**
+ * Measures how long ATopDownCharacter's button actions take from press to effect on screen:
+ *  - receipt, when Slate hands the key or mouse button press to the game, before any input evaluation;
+ *  - handler entry, when Enhanced Input calls the character's handler from the player controller tick;
+ *  - visible, when the render thread has finished the frame in which the handler's effect first appears.
+ * GPU and display time after the render thread frame are not included. Completed samples go to an
+ * FActionLatencyRecorder; NF.Latency.Report exports per-action percentiles.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UActionLatencySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Times presses of every key Mapping maps to InputAction as receipts of Action */
+	void TrackAction(ETopDownInputAction Action, const UInputAction* InputAction, const UInputMappingContext* Mapping);
+
+	/** Called as the handler of a live press starts. Untracked actions are ignored. */
+	void BeginAction(ETopDownInputAction Action);
+
+	/** Called where the action's first visible effect is applied, in the same frame as BeginAction */
+	void MarkEffect(ETopDownInputAction Action);
+
+	const FActionLatencyRecorder& GetRecorder() const { return *Recorder; }
+	void ResetRecorder() { Recorder->Reset(); }
+
+	/** Called by the input preprocessor for every key and mouse button press */
+	void HandleKeyDown(const FKey& Key);
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	static constexpr int32 NumActions = static_cast<int32>(ETopDownInputAction::Count);
+
+	/** Hands the frame's effects to the render thread, which stamps them once it has drawn the frame */
+	void HandleEndFrame();
+
+	/** Shared with render commands that may still be queued when the world goes away */
+	TSharedRef<FActionLatencyRecorder, ESPMode::ThreadSafe> Recorder = MakeShared<FActionLatencyRecorder, ESPMode::ThreadSafe>();
+
+	TSharedPtr<class FActionLatencyInputProcessor> InputProcessor;
+
+	/** Actions each tracked key triggers */
+	TMultiMap<FKey, ETopDownInputAction> KeyActions;
+
+	bool bTracked[NumActions] = {};
+
+	/** Cycles of each action's latest press not yet handled, 0 if none */
+	uint64 PendingReceipt[NumActions] = {};
+
+	/** Presses handled this frame still waiting for their effect; HandlerCycles is 0 for none */
+	FActionLatencySample InFlight[NumActions];
+
+	/** Presses whose effect was applied this frame */
+	TArray<FActionLatencySample> FrameEffects;
+
+	FDelegateHandle EndFrameHandle;
+};
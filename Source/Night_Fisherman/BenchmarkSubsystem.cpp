@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "RenderCore.h"
+
+using namespace NightFishermanBenchmark;
+
+bool UBenchmarkSubsystem::StartScenario(TUniquePtr<FScenario> InScenario, int32 InNumFrames, int32 InNumWarmupFrames)
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogNightFisherman, Warning, TEXT("Benchmark %s is already running, ignoring %s"), *Scenario->GetName(), *InScenario->GetName());
+		return false;
+	}
+
+	Scenario = MoveTemp(InScenario);
+	NumFrames = FMath::Max(InNumFrames, 1);
+	NumWarmupFrames = FMath::Max(InNumWarmupFrames, 0);
+	FrameIndex = -NumWarmupFrames;
+
+	TArray<FString> Columns = { TEXT("Frame"), TEXT("FrameMs"), TEXT("GameThreadMs"), TEXT("RenderThreadMs"),
+		TEXT("CharacterTickMs"), TEXT("CharacterTicks"), TEXT("CameraTransformUpdates"), TEXT("Allocations"), TEXT("AllocatedKB") };
+	Scenario->GetExtraColumns(Columns);
+	Csv = MakeUnique<FCsvWriter>(Scenario->GetName(), Columns);
+
+	Scenario->Setup(*GetWorld());
+
+	UE_LOG(LogNightFisherman, Display, TEXT("Benchmark %s: %d warmup + %d recorded frames"), *Scenario->GetName(), NumWarmupFrames, NumFrames);
+	return true;
+}
+
+void UBenchmarkSubsystem::Deinitialize()
+{
+	if (IsRunning())
+	{
+		UE_LOG(LogNightFisherman, Warning, TEXT("Benchmark %s interrupted after %d frames"), *Scenario->GetName(), FMath::Max(FrameIndex, 0));
+		FinishScenario();
+	}
+
+	Super::Deinitialize();
+}
+
+bool UBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	// Tickables run after every tick group, so the counters hold the whole frame that just finished
+	if (FrameIndex > 0)
+	{
+		const uint64 Allocations = AllocationCounter->GetAllocations();
+		const uint64 AllocatedBytes = AllocationCounter->GetAllocatedBytes();
+
+		TArray<FString> Values = {
+			LexToString(FrameIndex - 1),
+			LexToString(DeltaTime * 1000.0f),
+			LexToString(FPlatformTime::ToMilliseconds(GGameThreadTime)),
+			LexToString(FPlatformTime::ToMilliseconds(GRenderThreadTime)),
+			LexToString(FPlatformTime::ToMilliseconds64(FFrameCounters::CharacterTickCycles.load(std::memory_order_relaxed))),
+			LexToString(FFrameCounters::CharacterTicks.load(std::memory_order_relaxed)),
+			LexToString(FFrameCounters::CameraTransformUpdates.load(std::memory_order_relaxed)),
+			LexToString(Allocations - LastAllocations),
+			LexToString((AllocatedBytes - LastAllocatedBytes) / 1024.0)
+		};
+		Scenario->GetExtraValues(Values);
+		Csv->AddRowValues(Values);
+
+		LastAllocations = Allocations;
+		LastAllocatedBytes = AllocatedBytes;
+	}
+
+	if (FrameIndex == NumFrames)
+	{
+		FinishScenario();
+		return;
+	}
+
+	if (FrameIndex == 0)
+	{
+		FFrameCounters::bRecording = true;
+		AllocationCounter = MakeUnique<FScopedAllocationCounter>();
+		LastAllocations = 0;
+		LastAllocatedBytes = 0;
+	}
+
+	FFrameCounters::Reset();
+	Scenario->PreFrame(*GetWorld(), FrameIndex, DeltaTime);
+	++FrameIndex;
+}
+
+TStatId UBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UBenchmarkSubsystem::FinishScenario()
+{
+	FFrameCounters::bRecording = false;
+	AllocationCounter.Reset();
+
+	Csv->Save();
+	Csv.Reset();
+
+	Scenario->Teardown(*GetWorld());
+	Scenario.Reset();
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("BenchmarkExit")))
+	{
+		FPlatformMisc::RequestExit(false, TEXT("UBenchmarkSubsystem"));
+	}
+}
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NightFishermanBenchmark.h"
+#include "BenchmarkSubsystem.generated.h"
+
+/**
+ * Drives a benchmark scenario frame by frame and records per-frame game thread, render thread,
+ * character tick and allocation cost to CSV.
+ *
+ * Meant to run headless, e.g.:
+ *   UnrealEditor Night_Fisherman.uproject /Game/Untitled -game -nullrhi -unattended -BenchmarkExit
+ *     -ExecCmds="NF.Benchmark.Characters 256 600"
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Records NumFrames frames of the scenario after NumWarmupFrames unrecorded ones. Fails if a run is in progress. */
+	bool StartScenario(TUniquePtr<NightFishermanBenchmark::FScenario> InScenario, int32 InNumFrames, int32 InNumWarmupFrames = 30);
+
+	/** True while a scenario is warming up or recording */
+	bool IsRunning() const { return Scenario.IsValid(); }
+
+	// USubsystem implementation
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** Writes the CSV, tears the scenario down and optionally exits (-BenchmarkExit) */
+	void FinishScenario();
+
+	TUniquePtr<NightFishermanBenchmark::FScenario> Scenario;
+	TUniquePtr<NightFishermanBenchmark::FCsvWriter> Csv;
+	TUniquePtr<NightFishermanBenchmark::FScopedAllocationCounter> AllocationCounter;
+
+	int32 FrameIndex = 0;
+	int32 NumFrames = 0;
+	int32 NumWarmupFrames = 0;
+	uint64 LastAllocations = 0;
+	uint64 LastAllocatedBytes = 0;
+};
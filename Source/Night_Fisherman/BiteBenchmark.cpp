@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BiteSubsystem.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "TimingWheel.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	/**
+	 * Times the bite scheduler's timing wheel with thousands of lines in the water: casting, reeling in, and
+	 * a minute of 60 Hz frames in which every fired bite is followed by the next one, the way lines behave.
+	 */
+	static void RunBiteBenchmark(const TArray<FString>& Args)
+	{
+		static const int32 LineCounts[] = { 1000, 5000, 20000, 100000 };
+		const float MeanBiteSeconds = FMath::Max(Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 20.0f, 0.1f);
+		constexpr int32 NumFrames = 3600;
+		constexpr double FrameSeconds = 1.0 / 60.0;
+
+		FCsvWriter Csv(TEXT("Bites"), { TEXT("Lines"), TEXT("CastNs"), TEXT("ReelInNs"), TEXT("FrameUs"), TEXT("BitesPerFrame") });
+
+		for (const int32 NumLines : LineCounts)
+		{
+			FRandomStream Random(NumLines);
+			const auto BiteTick = [&Random, MeanBiteSeconds](uint64 Now)
+			{
+				return Now + static_cast<uint64>(-FMath::Loge(1.0 - Random.GetFraction()) * MeanBiteSeconds * UBiteSubsystem::TicksPerSecond) + 1;
+			};
+
+			FTimingWheel Wheel;
+			TArray<FTimingWheelHandle> Handles;
+			Handles.SetNumUninitialized(NumLines);
+
+			const double CastMs = TimeAverageMs(1, [&]
+			{
+				for (int32 Line = 0; Line < NumLines; ++Line)
+				{
+					Handles[Line] = Wheel.Schedule(BiteTick(0), Line);
+				}
+			});
+
+			// Reel in and recast a tenth of the lines, timing only the cancels
+			const int32 NumReeled = NumLines / 10;
+			const double ReelInMs = TimeAverageMs(1, [&]
+			{
+				for (int32 Line = 0; Line < NumReeled; ++Line)
+				{
+					Wheel.Cancel(Handles[Line * 10]);
+				}
+			});
+			for (int32 Line = 0; Line < NumReeled; ++Line)
+			{
+				Handles[Line * 10] = Wheel.Schedule(BiteTick(0), Line * 10);
+			}
+
+			TArray<uint32> Fired;
+			int64 NumBites = 0;
+			const double FrameMs = TimeAverageMs(NumFrames, [&, Frame = 0]() mutable
+			{
+				const uint64 Now = static_cast<uint64>(++Frame * FrameSeconds * UBiteSubsystem::TicksPerSecond);
+				Fired.Reset();
+				Wheel.Advance(Now, Fired);
+				for (const uint32 Line : Fired)
+				{
+					Handles[Line] = Wheel.Schedule(BiteTick(Now), Line);
+				}
+				NumBites += Fired.Num();
+			});
+
+			if (Wheel.Num() != NumLines)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("Bites %d lines: %d events pending at the end"), NumLines, Wheel.Num());
+			}
+
+			const double CastNs = CastMs * 1.0e6 / NumLines;
+			const double ReelInNs = ReelInMs * 1.0e6 / FMath::Max(NumReeled, 1);
+			const double BitesPerFrame = static_cast<double>(NumBites) / NumFrames;
+			Csv.AddRow(NumLines, CastNs, ReelInNs, FrameMs * 1000.0, BitesPerFrame);
+
+			UE_LOG(LogNightFisherman, Display, TEXT("Bites %6d lines: cast %.1f ns, reel in %.1f ns, %.2f us per frame for %.1f bites (%.1f KB)"),
+				NumLines, CastNs, ReelInNs, FrameMs * 1000.0, BitesPerFrame, Wheel.GetAllocatedSize() / 1024.0);
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommand BiteBenchmarkCommand(
+		TEXT("NF.Benchmark.Bites"),
+		TEXT("Times casting, reeling in and a minute of frames of the bite scheduler for 1000 to 100000 lines and writes Bites.csv. Usage: NF.Benchmark.Bites [MeanBiteSeconds=20]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunBiteBenchmark));
+}
@@ -0,0 +1,187 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BiteSubsystem.h"
+#include "DeterminismSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Fishing Lines"), STAT_FishingLines, STATGROUP_NightFisherman);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pending Bite Events"), STAT_PendingBiteEvents, STATGROUP_NightFisherman);
+
+static TAutoConsoleVariable<float> CVarFishBiteRate(
+	TEXT("NF.Fish.BiteRate"),
+	0.1f,
+	TEXT("Bites per second a fully ready fish near a lure adds to the line's bite rate."));
+
+static TAutoConsoleVariable<float> CVarFishHookWindow(
+	TEXT("NF.Fish.HookWindow"),
+	1.5f,
+	TEXT("Seconds a hooked fish stays on the line before it escapes."));
+
+FBiteLineHandle UBiteSubsystem::CastLine(const UObject* Caster, TConstArrayView<FFishSighting> NearbyFish, float MinReadiness)
+{
+	int32 Index = FirstFreeLine;
+	if (Index != INDEX_NONE)
+	{
+		FirstFreeLine = Lines[Index].NextFree;
+	}
+	else
+	{
+		Index = Lines.AddDefaulted();
+	}
+	++NumLines;
+
+	FLine& Line = Lines[Index];
+	Line.Caster = Caster;
+	Line.Fish = FFishSighting();
+	Line.BiteRate = 0.0f;
+	Line.bCast = true;
+	Line.bHooked = false;
+
+	const float RatePerFish = FMath::Max(CVarFishBiteRate.GetValueOnGameThread(), 0.0f);
+	for (const FFishSighting& Fish : NearbyFish)
+	{
+		if (Fish.BiteReadiness >= MinReadiness)
+		{
+			if (Line.BiteRate <= 0.0f)
+			{
+				Line.Fish = Fish;
+			}
+			Line.BiteRate += RatePerFish * Fish.BiteReadiness;
+		}
+	}
+
+	ScheduleBite(Index);
+	return { Index, Line.Serial };
+}
+
+bool UBiteSubsystem::ReelIn(FBiteLineHandle Line, FFishSighting& OutFish)
+{
+	FLine* Found = FindLine(Line);
+	if (!Found)
+	{
+		return false;
+	}
+
+	const bool bCaught = Found->bHooked;
+	OutFish = Found->Fish;
+	Wheel.Cancel(Found->Pending);
+	ReleaseLine(Line.Index);
+	return bCaught;
+}
+
+bool UBiteSubsystem::IsCast(FBiteLineHandle Line) const
+{
+	return FindLine(Line) != nullptr;
+}
+
+bool UBiteSubsystem::IsHooked(FBiteLineHandle Line) const
+{
+	const FLine* Found = FindLine(Line);
+	return Found && Found->bHooked;
+}
+
+void UBiteSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Wheel.Reset(GetTick(GetWorld()->GetTimeSeconds()));
+	Random.Initialize(UDeterminismSubsystem::MakeSeed(GetTypeHash(GetWorld()->GetFName())));
+}
+
+bool UBiteSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBiteSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Events are never early: scheduling rounds up to a tick and advancing rounds down
+	const double Now = GetWorld()->GetTimeSeconds();
+	Fired.Reset();
+	Wheel.Advance(static_cast<uint64>(Now * TicksPerSecond), Fired);
+
+	// Listeners may cast or reel in lines, so they only hear about bites once every event is handled
+	TArray<TPair<TWeakObjectPtr<const UObject>, FFishSighting>, TInlineAllocator<8>> Bites;
+	for (const uint32 Payload : Fired)
+	{
+		const int32 Index = static_cast<int32>(Payload >> 1);
+		FLine& Line = Lines[Index];
+		Line.Pending.Reset();
+
+		if (!Line.Caster.IsValid())
+		{
+			ReleaseLine(Index);
+			continue;
+		}
+
+		if (static_cast<EBiteEvent>(Payload & 1) == EBiteEvent::Bite)
+		{
+			Line.bHooked = true;
+			Line.Pending = Wheel.Schedule(GetTick(Now + CVarFishHookWindow.GetValueOnGameThread()), MakePayload(Index, EBiteEvent::Escape));
+			Bites.Emplace(Line.Caster, Line.Fish);
+		}
+		else
+		{
+			Line.bHooked = false;
+			ScheduleBite(Index);
+		}
+	}
+
+	for (const TPair<TWeakObjectPtr<const UObject>, FFishSighting>& Bite : Bites)
+	{
+		OnFishBite.Broadcast(Bite.Key.Get(), Bite.Value);
+	}
+
+	SET_DWORD_STAT(STAT_FishingLines, NumLines);
+	SET_DWORD_STAT(STAT_PendingBiteEvents, Wheel.Num());
+}
+
+TStatId UBiteSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBiteSubsystem, STATGROUP_Tickables);
+}
+
+void UBiteSubsystem::ScheduleBite(int32 LineIndex)
+{
+	FLine& Line = Lines[LineIndex];
+	if (Line.BiteRate <= 0.0f)
+	{
+		return;
+	}
+
+	// Exponentially distributed wait, the gap between arrivals of a Poisson process
+	const double Delay = -FMath::Loge(1.0 - Random.GetFraction()) / Line.BiteRate;
+	Line.Pending = Wheel.Schedule(GetTick(GetWorld()->GetTimeSeconds() + Delay), MakePayload(LineIndex, EBiteEvent::Bite));
+}
+
+void UBiteSubsystem::ReleaseLine(int32 LineIndex)
+{
+	FLine& Line = Lines[LineIndex];
+	Line.Caster.Reset();
+	Line.Pending.Reset();
+	Line.bCast = false;
+	Line.bHooked = false;
+	++Line.Serial;
+	Line.NextFree = FirstFreeLine;
+	FirstFreeLine = LineIndex;
+	--NumLines;
+}
+
+uint64 UBiteSubsystem::GetTick(double Seconds) const
+{
+	return static_cast<uint64>(FMath::CeilToDouble(FMath::Max(Seconds, 0.0) * TicksPerSecond));
+}
+
+UBiteSubsystem::FLine* UBiteSubsystem::FindLine(FBiteLineHandle Line)
+{
+	return const_cast<FLine*>(static_cast<const UBiteSubsystem*>(this)->FindLine(Line));
+}
+
+const UBiteSubsystem::FLine* UBiteSubsystem::FindLine(FBiteLineHandle Line) const
+{
+	return Lines.IsValidIndex(Line.Index) && Lines[Line.Index].bCast && Lines[Line.Index].Serial == Line.Serial ? &Lines[Line.Index] : nullptr;
+}
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "FishPopulation.h"
+#include "TimingWheel.h"
+#include "BiteSubsystem.generated.h"
+
+/** Names a fishing line in UBiteSubsystem; goes stale once the line is reeled in */
+struct FBiteLineHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { *this = FBiteLineHandle(); }
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnFishBite, const UObject* /*Caster*/, const FFishSighting& /*Fish*/);
+
+/**
+ * Decides when fish bite on cast lines. Each line keeps at most one pending event, a bite or the end of the
+ * hook window that follows it, in an FTimingWheel keyed by game time, so casting and reeling in are O(1) and
+ * lines cost nothing per frame while they wait, however many are in the water.
+ *
+ * Bites arrive as a Poisson process: the rate is NF.Fish.BiteRate for every fish near the lure at cast time
+ * that was at least as ready to bite as the caster asked, weighted by its readiness. The nearest such fish
+ * is the one that bites. A hooked fish escapes after NF.Fish.HookWindow seconds and may bite again later.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UBiteSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Wheel ticks per second of game time */
+	static constexpr double TicksPerSecond = 20.0;
+
+	/** Puts a line in the water and schedules its first bite from the fish near the lure, nearest first */
+	FBiteLineHandle CastLine(const UObject* Caster, TConstArrayView<FFishSighting> NearbyFish, float MinReadiness);
+
+	/** Takes a line out of the water, returning true and the fish if one was hooked */
+	bool ReelIn(FBiteLineHandle Line, FFishSighting& OutFish);
+
+	bool IsCast(FBiteLineHandle Line) const;
+	bool IsHooked(FBiteLineHandle Line) const;
+
+	int32 GetNumLines() const { return NumLines; }
+	int32 GetNumPendingEvents() const { return Wheel.Num(); }
+
+	/** Called when a fish takes the lure of a line */
+	FOnFishBite OnFishBite;
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	enum class EBiteEvent : uint32
+	{
+		Bite,
+		Escape,
+	};
+
+	struct FLine
+	{
+		TWeakObjectPtr<const UObject> Caster;
+		FFishSighting Fish;
+		/** Bites per second, 0 when no fish near the lure was ready */
+		float BiteRate = 0.0f;
+		FTimingWheelHandle Pending;
+		uint32 Serial = 0;
+		bool bCast = false;
+		bool bHooked = false;
+		/** Next free line while not cast */
+		int32 NextFree = INDEX_NONE;
+	};
+
+	/** Schedules the next bite of a line, if any fish is interested */
+	void ScheduleBite(int32 LineIndex);
+
+	void ReleaseLine(int32 LineIndex);
+
+	uint64 GetTick(double Seconds) const;
+
+	FLine* FindLine(FBiteLineHandle Line);
+	const FLine* FindLine(FBiteLineHandle Line) const;
+
+	static uint32 MakePayload(int32 LineIndex, EBiteEvent Event) { return static_cast<uint32>(LineIndex) << 1 | static_cast<uint32>(Event); }
+
+	FTimingWheel Wheel;
+	TArray<FLine> Lines;
+	int32 FirstFreeLine = INDEX_NONE;
+	int32 NumLines = 0;
+
+	/** Payloads fired by the last Advance, kept to reuse the allocation */
+	TArray<uint32> Fired;
+
+	FRandomStream Random;
+};
@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CameraOcclusionComponent.h"
+#include "Night_Fisherman.h"
+#include "Camera/CameraComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Occlusion Queries"), STAT_CameraOcclusionQueries, STATGROUP_NightFisherman);
+
+static const FName OcclusionFadeName(TEXT("OcclusionFade"));
+static const FName OcclusionCameraName(TEXT("OcclusionCamera"));
+static const FName OcclusionTargetName(TEXT("OcclusionTarget"));
+
+UCameraOcclusionComponent::UCameraOcclusionComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCameraOcclusionComponent::SetCamera(UCameraComponent* InCamera)
+{
+	Camera = InCamera;
+}
+
+void UCameraOcclusionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearOccluders();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCameraOcclusionComponent::Update(float DeltaTime)
+{
+	const AActor* Owner = GetOwner();
+	if (!Camera || !Owner)
+	{
+		return;
+	}
+
+	const FVector CameraLocation = Camera->GetComponentLocation();
+	const FVector TargetLocation = Owner->GetActorLocation();
+
+	// Rotating or zooming moves the camera across cells too, so both ends are tracked
+	const FIntVector NewCameraCell = GetCell(CameraLocation);
+	const FIntVector NewTargetCell = GetCell(TargetLocation);
+	if (NewCameraCell != CameraCell || NewTargetCell != TargetCell)
+	{
+		CameraCell = NewCameraCell;
+		TargetCell = NewTargetCell;
+		RefreshOccluders(CameraLocation, TargetLocation);
+	}
+
+	const float PreviousFade = FadeAmount;
+	FadeAmount = FMath::FInterpConstantTo(FadeAmount, Occluders.IsEmpty() ? 0.0f : 1.0f, DeltaTime, FadeSpeed);
+
+	UMaterialParameterCollectionInstance* Parameters = ParameterCollection ? GetWorld()->GetParameterCollectionInstance(ParameterCollection) : nullptr;
+	if (Parameters && (FadeAmount > 0.0f || PreviousFade > 0.0f))
+	{
+		Parameters->SetScalarParameterValue(OcclusionFadeName, FadeAmount);
+		Parameters->SetVectorParameterValue(OcclusionCameraName, FLinearColor(CameraLocation));
+		Parameters->SetVectorParameterValue(OcclusionTargetName, FLinearColor(TargetLocation));
+	}
+}
+
+void UCameraOcclusionComponent::RefreshOccluders(const FVector& CameraLocation, const FVector& TargetLocation)
+{
+	INC_DWORD_STAT(STAT_CameraOcclusionQueries);
+
+	// The ground under the owner is never an occluder
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CameraOcclusion), false, GetOwner());
+	if (const ACharacter* Character = GetOwner<ACharacter>())
+	{
+		QueryParams.AddIgnoredComponent(Character->GetMovementBase());
+	}
+
+	// Report everything the camera channel would hit as a touch, so the sweep runs through to the owner.
+	// It stops short of the owner so the probe does not graze the floor around its feet.
+	const FCollisionResponseParams ResponseParams(ECR_Overlap);
+	const FVector SweepEnd = TargetLocation + (CameraLocation - TargetLocation).GetSafeNormal() * ProbeRadius * 2.0f;
+	TArray<FHitResult> Hits;
+	GetWorld()->SweepMultiByChannel(Hits, CameraLocation, SweepEnd, FQuat::Identity, ECC_Camera, FCollisionShape::MakeSphere(ProbeRadius), QueryParams, ResponseParams);
+
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> NewOccluders;
+	for (const FHitResult& Hit : Hits)
+	{
+		if (UPrimitiveComponent* Component = Hit.GetComponent())
+		{
+			NewOccluders.AddUnique(Component);
+		}
+	}
+
+	// Only components entering or leaving the set are touched, as custom data changes dirty their render state
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Occluder : Occluders)
+	{
+		if (UPrimitiveComponent* Component = Occluder.Get(); Component && !NewOccluders.Contains(Occluder))
+		{
+			Component->SetCustomPrimitiveDataFloat(OccluderDataIndex, 0.0f);
+		}
+	}
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Occluder : NewOccluders)
+	{
+		if (!Occluders.Contains(Occluder))
+		{
+			Occluder->SetCustomPrimitiveDataFloat(OccluderDataIndex, 1.0f);
+		}
+	}
+
+	Occluders = MoveTemp(NewOccluders);
+}
+
+void UCameraOcclusionComponent::ClearOccluders()
+{
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Occluder : Occluders)
+	{
+		if (UPrimitiveComponent* Component = Occluder.Get())
+		{
+			Component->SetCustomPrimitiveDataFloat(OccluderDataIndex, 0.0f);
+		}
+	}
+	Occluders.Reset();
+	CameraCell = TargetCell = FIntVector(MAX_int32);
+
+	UMaterialParameterCollectionInstance* Parameters = ParameterCollection && FadeAmount > 0.0f ? GetWorld()->GetParameterCollectionInstance(ParameterCollection) : nullptr;
+	if (Parameters)
+	{
+		Parameters->SetScalarParameterValue(OcclusionFadeName, 0.0f);
+	}
+	FadeAmount = 0.0f;
+}
+
+FIntVector UCameraOcclusionComponent::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize), FMath::FloorToInt32(Location.Z / CellSize));
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CameraOcclusionComponent.generated.h"
+
+class UCameraComponent;
+class UMaterialParameterCollection;
+class UPrimitiveComponent;
+
+/**
+ * Fades out whatever stands between the top-down camera and its owner, without a per-frame spring arm trace.
+ *
+ * Occluders are found with one sphere sweep from the camera to the owner, repeated only when the owner or the
+ * camera moves into another grid cell. Each occluder gets custom primitive data OccluderDataIndex set to 1.
+ * The parameter collection receives the fade amount, eased over time, plus the camera and owner locations, so
+ * occluder materials can dither out the pixels near the line of sight:
+ *   OcclusionFade (scalar), OcclusionCamera (vector), OcclusionTarget (vector)
+ */
+UCLASS(ClassGroup = (Camera), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UCameraOcclusionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCameraOcclusionComponent();
+
+	/** Collection receiving the fade parameters; occluders are still flagged without one */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	UMaterialParameterCollection* ParameterCollection;
+
+	/** Size of the grid cells whose crossing refreshes the occluders */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "10.0"))
+	float CellSize = 200.0f;
+
+	/** Radius of the sweep from the camera to the owner */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0"))
+	float ProbeRadius = 40.0f;
+
+	/** Fade amount change per second */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.01"))
+	float FadeSpeed = 4.0f;
+
+	/** Custom primitive data index set to 1 on occluders and 0 once they stop occluding */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0"))
+	int32 OccluderDataIndex = 0;
+
+	/** Sets the camera looking at the owner */
+	void SetCamera(UCameraComponent* InCamera);
+
+	/** Refreshes the occluders if a cell was crossed and eases the fade */
+	void Update(float DeltaTime);
+
+	/** Unflags every occluder and drops the fade, e.g. when the view moves to another pawn */
+	void ClearOccluders();
+
+protected:
+	// UActorComponent implementation
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/** Sweeps from the camera to the owner and flags the occluders found */
+	void RefreshOccluders(const FVector& CameraLocation, const FVector& TargetLocation);
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	UPROPERTY()
+	TObjectPtr<UCameraComponent> Camera;
+
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> Occluders;
+
+	/** Cells of the camera and owner at the last refresh */
+	FIntVector CameraCell = FIntVector(MAX_int32);
+	FIntVector TargetCell = FIntVector(MAX_int32);
+
+	float FadeAmount = 0.0f;
+};
@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CameraRigComponent.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "GameFramework/SpringArmComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Transform Updates"), STAT_CameraTransformUpdates, STATGROUP_NightFisherman);
+
+UCameraRigComponent::UCameraRigComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCameraRigComponent::SetBoom(USpringArmComponent* InBoom)
+{
+	Boom = InBoom;
+}
+
+void UCameraRigComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (Boom)
+	{
+		TargetRotation = Boom->GetRelativeRotation();
+		TargetArmLength = Boom->TargetArmLength;
+	}
+
+#if !UE_BUILD_SHIPPING
+	BindTransformCounters(true);
+#endif
+}
+
+void UCameraRigComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if !UE_BUILD_SHIPPING
+	BindTransformCounters(false);
+#endif
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UCameraRigComponent::AddRotationInput(const FVector2D& Input)
+{
+	PendingInput += Input;
+	bHasPendingInput = true;
+}
+
+void UCameraRigComponent::AddZoomInput(float Input)
+{
+	PendingZoom += Input;
+	bHasPendingInput = true;
+}
+
+bool UCameraRigComponent::Update(float DeltaTime)
+{
+	if (!Boom)
+	{
+		return false;
+	}
+
+	const bool bHadInput = bHasPendingInput;
+	if (bHasPendingInput)
+	{
+		const FVector2D Turn = PendingInput * (bRotationInputIsRate ? RotationRate * DeltaTime : RotationRate);
+		TargetRotation.Yaw = FRotator::NormalizeAxis(TargetRotation.Yaw + Turn.X);
+		TargetRotation.Pitch = FMath::Clamp(TargetRotation.Pitch + Turn.Y, MinPitch, MaxPitch);
+		TargetArmLength = FMath::Clamp(TargetArmLength - PendingZoom * ZoomRate, MinArmLength, MaxArmLength);
+		PendingInput = FVector2D::ZeroVector;
+		PendingZoom = 0.0f;
+		bHasPendingInput = false;
+	}
+
+	const bool bSmooth = RotationSmoothingSpeed > 0.0f;
+	const FRotator CurrentRotation = Boom->GetRelativeRotation();
+	const FRotator NewRotation = bSmooth ? FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, RotationSmoothingSpeed) : TargetRotation;
+	if (!NewRotation.Equals(CurrentRotation))
+	{
+		Boom->SetRelativeRotation(NewRotation);
+	}
+
+	// The spring arm reads its length when it updates, so changing it dirties nothing by itself
+	Boom->TargetArmLength = bSmooth ? FMath::FInterpTo(Boom->TargetArmLength, TargetArmLength, DeltaTime, RotationSmoothingSpeed) : TargetArmLength;
+
+	// Stay active for a frame after input so steady input does not toggle the owner's tick every frame
+	return bHadInput || !NewRotation.Equals(TargetRotation) || !FMath::IsNearlyEqual(Boom->TargetArmLength, TargetArmLength, 1.0f);
+}
+
+#if !UE_BUILD_SHIPPING
+void UCameraRigComponent::CountTransformUpdate(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	INC_DWORD_STAT(STAT_CameraTransformUpdates);
+	if (NightFishermanBenchmark::FFrameCounters::bRecording.load(std::memory_order_relaxed))
+	{
+		NightFishermanBenchmark::FFrameCounters::CameraTransformUpdates.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void UCameraRigComponent::BindTransformCounters(bool bBind)
+{
+	if (!Boom)
+	{
+		return;
+	}
+
+	TArray<USceneComponent*> Hierarchy;
+	Boom->GetChildrenComponents(true, Hierarchy);
+	Hierarchy.Add(Boom);
+	for (USceneComponent* Component : Hierarchy)
+	{
+		if (bBind)
+		{
+			Component->TransformUpdated.AddUObject(this, &UCameraRigComponent::CountTransformUpdate);
+		}
+		else
+		{
+			Component->TransformUpdated.RemoveAll(this);
+		}
+	}
+}
+#endif
@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CameraRigComponent.generated.h"
+
+class USpringArmComponent;
+
+/**
+ * Drives the top-down camera boom from accumulated input. Camera and zoom input events only add to a pending
+ * total; Update applies it as one clamped rotation and arm length change per frame, optionally smoothed, so
+ * high-rate mice no longer dirty the boom and camera transforms several times a frame.
+ */
+UCLASS(ClassGroup = (Camera), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UCameraRigComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCameraRigComponent();
+
+	/** Degrees per second the boom turns per unit of camera input, or degrees per unit if bRotationInputIsRate is off */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float RotationRate = 120.0f;
+
+	/**
+	 * Camera input is a turn rate, like a held stick, and is scaled by frame time so the camera turns equally fast
+	 * at any frame rate. Turn off for input that is already a per-frame distance, like raw mouse deltas.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	bool bRotationInputIsRate = true;
+
+	/** Lowest boom pitch, looking straight down at -90 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "-89.0", ClampMax = "0.0"))
+	float MinPitch = -80.0f;
+
+	/** Highest boom pitch */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "-89.0", ClampMax = "0.0"))
+	float MaxPitch = -20.0f;
+
+	/** Change in arm length per unit of zoom input; positive input zooms in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera)
+	float ZoomRate = 100.0f;
+
+	/** Shortest arm length zoom allows */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0"))
+	float MinArmLength = 400.0f;
+
+	/** Longest arm length zoom allows */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0"))
+	float MaxArmLength = 1600.0f;
+
+	/** How quickly the boom catches up with the input; 0 applies it immediately */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Camera, meta = (ClampMin = "0.0"))
+	float RotationSmoothingSpeed = 0.0f;
+
+	/** Sets the boom this rig drives */
+	void SetBoom(USpringArmComponent* InBoom);
+
+	/** Adds camera input to be applied at the next Update. X turns yaw, Y turns pitch. */
+	void AddRotationInput(const FVector2D& Input);
+
+	/** Adds zoom input to be applied at the next Update */
+	void AddZoomInput(float Input);
+
+	/** Applies the input gathered since the last call in one boom update. Returns false once there is nothing left to do. */
+	bool Update(float DeltaTime);
+
+protected:
+	// UActorComponent implementation
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+#if !UE_BUILD_SHIPPING
+	/** Counts transform updates of the boom and everything attached to it */
+	void CountTransformUpdate(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	void BindTransformCounters(bool bBind);
+#endif
+
+	UPROPERTY()
+	TObjectPtr<USpringArmComponent> Boom;
+
+	/** Rotation the boom is heading towards */
+	FRotator TargetRotation = FRotator::ZeroRotator;
+
+	/** Arm length the boom is heading towards */
+	float TargetArmLength = 0.0f;
+
+	FVector2D PendingInput = FVector2D::ZeroVector;
+	float PendingZoom = 0.0f;
+
+	/** Whether input arrived since the last Update */
+	bool bHasPendingInput = false;
+};
@@ -0,0 +1,160 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkSubsystem.h"
+#include "DashComponent.h"
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "AIController.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+#include "EngineUtils.h"
+
+namespace NightFishermanBenchmark
+{
+	/** Spawns a grid of AI-possessed ATopDownCharacters and feeds them synthetic Move and CameraControl input, with everyone dodging at once every DodgeInterval frames */
+	class FCharacterScenario : public FScenario
+	{
+	public:
+		FCharacterScenario(int32 InNumCharacters, UClass* InCharacterClass)
+			: NumCharacters(InNumCharacters)
+			, CharacterClass(InCharacterClass)
+		{
+		}
+
+		virtual FString GetName() const override
+		{
+			return FString::Printf(TEXT("Characters_%d"), NumCharacters);
+		}
+
+		virtual void Setup(UWorld& World) override
+		{
+			FVector Origin = FVector::ZeroVector;
+			if (TActorIterator<APlayerStart> It(&World); It)
+			{
+				Origin = It->GetActorLocation();
+			}
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+			const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters)));
+			Characters.Reserve(NumCharacters);
+			for (int32 Index = 0; Index < NumCharacters; ++Index)
+			{
+				const FVector Offset((Index % GridSize - GridSize / 2) * Spacing, (Index / GridSize - GridSize / 2) * Spacing, 0.0f);
+				ATopDownCharacter* Character = World.SpawnActor<ATopDownCharacter>(CharacterClass, Origin + Offset, FRotator::ZeroRotator, SpawnParams);
+				if (!Character)
+				{
+					continue;
+				}
+
+				if (AAIController* AIController = World.SpawnActor<AAIController>(SpawnParams))
+				{
+					AIController->Possess(Character);
+					Controllers.Add(AIController);
+				}
+				Characters.Add(Character);
+			}
+
+			UE_LOG(LogNightFisherman, Display, TEXT("Benchmark %s: spawned %d of %s"), *GetName(), Characters.Num(), *CharacterClass->GetName());
+		}
+
+		virtual void PreFrame(UWorld& World, int32 FrameIndex, float DeltaTime) override
+		{
+			// Each character walks its own slowly rotating heading and nudges the camera, deterministic per frame
+			for (int32 Index = 0; Index < Characters.Num(); ++Index)
+			{
+				ATopDownCharacter* Character = Characters[Index].Get();
+				if (!Character)
+				{
+					continue;
+				}
+
+				const float Phase = FrameIndex * 0.05f + Index * 0.37f;
+				Character->InjectInput(ETopDownInputAction::Move, FInputActionValue(FVector2D(FMath::Cos(Phase), FMath::Sin(Phase))));
+				Character->InjectInput(ETopDownInputAction::CameraControl, FInputActionValue(FVector2D(FMath::Sin(Phase * 0.5f), 0.25f * FMath::Cos(Phase))));
+				if (FrameIndex % DodgeInterval == 0)
+				{
+					Character->InjectInput(ETopDownInputAction::Dodge, FInputActionValue(true));
+				}
+			}
+		}
+
+		virtual void GetExtraColumns(TArray<FString>& OutColumns) const override
+		{
+			OutColumns.Add(TEXT("Characters"));
+			OutColumns.Add(TEXT("Dashing"));
+		}
+
+		virtual void GetExtraValues(TArray<FString>& OutValues) const override
+		{
+			OutValues.Add(LexToString(Characters.Num()));
+
+			int32 NumDashing = 0;
+			for (const TWeakObjectPtr<ATopDownCharacter>& Character : Characters)
+			{
+				NumDashing += Character.IsValid() && Character->GetDash()->IsDashing();
+			}
+			OutValues.Add(LexToString(NumDashing));
+		}
+
+		virtual void Teardown(UWorld& World) override
+		{
+			for (const TWeakObjectPtr<AAIController>& Controller : Controllers)
+			{
+				if (Controller.IsValid())
+				{
+					Controller->Destroy();
+				}
+			}
+			for (const TWeakObjectPtr<ATopDownCharacter>& Character : Characters)
+			{
+				if (Character.IsValid())
+				{
+					Character->Destroy();
+				}
+			}
+			Controllers.Reset();
+			Characters.Reset();
+		}
+
+	private:
+		static constexpr float Spacing = 200.0f;
+		static constexpr int32 DodgeInterval = 120;
+
+		int32 NumCharacters;
+		UClass* CharacterClass;
+		TArray<TWeakObjectPtr<ATopDownCharacter>> Characters;
+		TArray<TWeakObjectPtr<AAIController>> Controllers;
+	};
+
+	static FAutoConsoleCommandWithWorldAndArgs CharacterBenchmarkCommand(
+		TEXT("NF.Benchmark.Characters"),
+		TEXT("Spawns N ATopDownCharacters fed with synthetic input and records per-frame cost to CSV. Usage: NF.Benchmark.Characters [Count=64] [Frames=600] [CharacterClassPath]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<UBenchmarkSubsystem>() : nullptr;
+			if (!Benchmark)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.Characters needs a game world"));
+				return;
+			}
+
+			const int32 NumCharacters = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 64;
+			const int32 NumFrames = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 600;
+
+			UClass* CharacterClass = ATopDownCharacter::StaticClass();
+			if (Args.IsValidIndex(2))
+			{
+				CharacterClass = LoadClass<ATopDownCharacter>(nullptr, *Args[2]);
+				if (!CharacterClass)
+				{
+					UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.Characters: %s is not an ATopDownCharacter class"), *Args[2]);
+					return;
+				}
+			}
+
+			Benchmark->StartScenario(MakeUnique<FCharacterScenario>(FMath::Max(NumCharacters, 1), CharacterClass), NumFrames);
+		}));
+}
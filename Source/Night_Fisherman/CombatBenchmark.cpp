@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatHitResolver.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	static void RunCombatBenchmark(const TArray<FString>& Args)
+	{
+		static const int32 HurtboxCounts[] = { 100, 250, 500, 1000, 2500, 5000 };
+		const int32 NumAttackers = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 500, 1);
+		const int32 NumIterations = FMath::Max(Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 100, 1);
+
+		FCsvWriter Csv(TEXT("Combat"), { TEXT("Attacks"), TEXT("Hurtboxes"), TEXT("SimdMs"), TEXT("ScalarMs"), TEXT("Speedup"), TEXT("Hits") });
+
+		for (const int32 NumHurtboxes : HurtboxCounts)
+		{
+			// Keep density constant so hits per swing stay comparable across sizes
+			const float HalfExtent = FMath::Sqrt(NumHurtboxes * 40000.0f) * 0.5f;
+
+			FRandomStream Random(NumHurtboxes);
+			FCombatHitResolver Resolver;
+			for (int32 Index = 0; Index < NumHurtboxes; ++Index)
+			{
+				const FVector3f Location(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 90.0f);
+				Resolver.AddHurtbox(Location, 40.0f, 50.0f, Index + 1, static_cast<uint8>(Index % 3));
+			}
+			for (int32 Index = 0; Index < NumAttackers; ++Index)
+			{
+				// Attackers reuse hurtbox owner ids so owner filtering is exercised
+				const FVector3f Center(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 90.0f);
+				Resolver.AddAttack(Center, Random.FRandRange(80.0f, 140.0f), Index % NumHurtboxes + 1, static_cast<uint8>(Index % 3));
+			}
+
+			Resolver.Resolve(false);
+			const int32 ScalarHits = Resolver.NumHits();
+			Resolver.Resolve(true);
+			const int32 SimdHits = Resolver.NumHits();
+			if (SimdHits != ScalarHits)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("Combat %d hurtboxes: SIMD path found %d hits, scalar path %d"), NumHurtboxes, SimdHits, ScalarHits);
+			}
+
+			const double SimdMs = TimeAverageMs(NumIterations, [&] { Resolver.Resolve(true); });
+			const double ScalarMs = TimeAverageMs(NumIterations, [&] { Resolver.Resolve(false); });
+
+			Csv.AddRow(NumAttackers, NumHurtboxes, SimdMs, ScalarMs, ScalarMs / FMath::Max(SimdMs, UE_DOUBLE_SMALL_NUMBER), SimdHits);
+
+			UE_LOG(LogNightFisherman, Display, TEXT("Combat %d swings vs %5d hurtboxes: %.3f ms SIMD, %.3f ms scalar (%d hits)"),
+				NumAttackers, NumHurtboxes, SimdMs, ScalarMs, SimdHits);
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommand CombatBenchmarkCommand(
+		TEXT("NF.Benchmark.Combat"),
+		TEXT("Times batched melee hit resolution, SIMD against the scalar reference, for 100 to 5000 hurtboxes and writes Combat.csv. Usage: NF.Benchmark.Combat [Attacks=500] [Iterations=100]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunCombatBenchmark));
+}
@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatHitResolver.h"
+#include "Night_Fisherman.h"
+#include "Algo/Sort.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Resolve"), STAT_CombatResolve, STATGROUP_NightFisherman);
+
+void FCombatHitResolver::Reset()
+{
+	ResetHurtboxes();
+	ResetAttacks();
+}
+
+void FCombatHitResolver::ResetHurtboxes()
+{
+	HurtboxX.Reset();
+	HurtboxY.Reset();
+	HurtboxZ.Reset();
+	HurtboxRadius.Reset();
+	HurtboxHalfHeight.Reset();
+	HurtboxOwner.Reset();
+	HurtboxTeam.Reset();
+	MaxHurtboxRadius = 0.0f;
+}
+
+void FCombatHitResolver::ResetAttacks()
+{
+	AttackCenters.Reset();
+	AttackRadius.Reset();
+	AttackOwner.Reset();
+	AttackTeam.Reset();
+
+	AttackHitRanges.Reset();
+	Hits.Reset();
+}
+
+int32 FCombatHitResolver::AddHurtbox(const FVector3f& Location, float Radius, float HalfHeight, uint32 OwnerId, uint8 Team)
+{
+	HurtboxX.Add(Location.X);
+	HurtboxY.Add(Location.Y);
+	HurtboxZ.Add(Location.Z);
+	HurtboxRadius.Add(Radius);
+	HurtboxHalfHeight.Add(HalfHeight);
+	HurtboxOwner.Add(OwnerId);
+	MaxHurtboxRadius = FMath::Max(MaxHurtboxRadius, Radius);
+	return HurtboxTeam.Add(Team);
+}
+
+int32 FCombatHitResolver::AddAttack(const FVector3f& Center, float Radius, uint32 OwnerId, uint8 Team)
+{
+	AttackRadius.Add(Radius);
+	AttackOwner.Add(OwnerId);
+	AttackTeam.Add(Team);
+	return AttackCenters.Add(Center);
+}
+
+void FCombatHitResolver::Resolve(bool bUseSimd)
+{
+	SCOPE_CYCLE_COUNTER(STAT_CombatResolve);
+
+	Hits.Reset();
+	AttackHitRanges.SetNumUninitialized(NumAttacks());
+	if (NumAttacks() == 0)
+	{
+		return;
+	}
+
+	BuildBroadphase();
+
+	for (int32 AttackIndex = 0; AttackIndex < NumAttacks(); ++AttackIndex)
+	{
+		const FVector3f& Center = AttackCenters[AttackIndex];
+		const float Reach = AttackRadius[AttackIndex] + MaxHurtboxRadius;
+		const FIntPoint MinCell = GetCell(Center.X - Reach, Center.Y - Reach);
+		const FIntPoint MaxCell = GetCell(Center.X + Reach, Center.Y + Reach);
+
+		const int32 FirstHit = Hits.Num();
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+			{
+				if (const FIndexRange* Range = CellRanges.Find(FIntPoint(CellX, CellY)))
+				{
+					if (bUseSimd)
+					{
+						TestRangeSimd(AttackIndex, Range->Begin, Range->End);
+					}
+					else
+					{
+						TestRangeScalar(AttackIndex, Range->Begin, Range->End);
+					}
+				}
+			}
+		}
+		AttackHitRanges[AttackIndex] = { FirstHit, Hits.Num() };
+	}
+}
+
+TConstArrayView<int32> FCombatHitResolver::GetHits(int32 AttackIndex) const
+{
+	const FIndexRange& Range = AttackHitRanges[AttackIndex];
+	return TConstArrayView<int32>(Hits.GetData() + Range.Begin, Range.End - Range.Begin);
+}
+
+FIntPoint FCombatHitResolver::GetCell(float X, float Y)
+{
+	return FIntPoint(FMath::FloorToInt32(X / CellSize), FMath::FloorToInt32(Y / CellSize));
+}
+
+void FCombatHitResolver::BuildBroadphase()
+{
+	const int32 Num = NumHurtboxes();
+
+	// Sort by cell so each cell's hurtboxes are contiguous
+	CellOrder.SetNumUninitialized(Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		CellOrder[Index] = { GetCell(HurtboxX[Index], HurtboxY[Index]), Index };
+	}
+	Algo::Sort(CellOrder, [](const FCellEntry& A, const FCellEntry& B)
+	{
+		return A.Cell.Y != B.Cell.Y ? A.Cell.Y < B.Cell.Y : A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Index < B.Index;
+	});
+
+	const int32 PaddedNum = Num + 3;
+	SortedX.SetNumZeroed(PaddedNum);
+	SortedY.SetNumZeroed(PaddedNum);
+	SortedZ.SetNumZeroed(PaddedNum);
+	SortedRadius.SetNumZeroed(PaddedNum);
+	SortedHalfHeight.SetNumZeroed(PaddedNum);
+	SortedToHurtbox.SetNumUninitialized(Num);
+	CellRanges.Reset();
+
+	for (int32 SortedIndex = 0; SortedIndex < Num; ++SortedIndex)
+	{
+		const FIntPoint Cell = CellOrder[SortedIndex].Cell;
+		const int32 Index = CellOrder[SortedIndex].Index;
+		SortedX[SortedIndex] = HurtboxX[Index];
+		SortedY[SortedIndex] = HurtboxY[Index];
+		SortedZ[SortedIndex] = HurtboxZ[Index];
+		SortedRadius[SortedIndex] = HurtboxRadius[Index];
+		SortedHalfHeight[SortedIndex] = HurtboxHalfHeight[Index];
+		SortedToHurtbox[SortedIndex] = Index;
+
+		if (SortedIndex == 0 || Cell != CellOrder[SortedIndex - 1].Cell)
+		{
+			CellRanges.Add(Cell, { SortedIndex, SortedIndex + 1 });
+		}
+		else
+		{
+			CellRanges.FindChecked(Cell).End = SortedIndex + 1;
+		}
+	}
+}
+
+void FCombatHitResolver::TestRangeSimd(int32 AttackIndex, int32 Begin, int32 End)
+{
+	const FVector3f& Center = AttackCenters[AttackIndex];
+	const VectorRegister4Float CenterX = VectorSetFloat1(Center.X);
+	const VectorRegister4Float CenterY = VectorSetFloat1(Center.Y);
+	const VectorRegister4Float CenterZ = VectorSetFloat1(Center.Z);
+	const VectorRegister4Float Radius = VectorSetFloat1(AttackRadius[AttackIndex]);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	for (int32 Index = Begin; Index < End; Index += 4)
+	{
+		// Distance from the sphere centre to each capsule's vertical segment
+		const VectorRegister4Float DeltaX = VectorSubtract(VectorLoad(&SortedX[Index]), CenterX);
+		const VectorRegister4Float DeltaY = VectorSubtract(VectorLoad(&SortedY[Index]), CenterY);
+		const VectorRegister4Float AbsDeltaZ = VectorAbs(VectorSubtract(VectorLoad(&SortedZ[Index]), CenterZ));
+		const VectorRegister4Float DeltaZ = VectorMax(VectorSubtract(AbsDeltaZ, VectorLoad(&SortedHalfHeight[Index])), Zero);
+		const VectorRegister4Float DistanceSquared = VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ)));
+		const VectorRegister4Float Reach = VectorAdd(VectorLoad(&SortedRadius[Index]), Radius);
+
+		uint32 Mask = static_cast<uint32>(VectorMaskBits(VectorCompareLE(DistanceSquared, VectorMultiply(Reach, Reach))));
+
+		// Lanes past the end of the cell belong to the next cell or the padding
+		const int32 NumLanes = End - Index;
+		if (NumLanes < 4)
+		{
+			Mask &= (1u << NumLanes) - 1u;
+		}
+
+		while (Mask != 0)
+		{
+			const uint32 Lane = FMath::CountTrailingZeros(Mask);
+			Mask &= Mask - 1u;
+			AddHitIfAllowed(AttackIndex, Index + static_cast<int32>(Lane));
+		}
+	}
+}
+
+void FCombatHitResolver::TestRangeScalar(int32 AttackIndex, int32 Begin, int32 End)
+{
+	const FVector3f& Center = AttackCenters[AttackIndex];
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		const float DeltaX = SortedX[Index] - Center.X;
+		const float DeltaY = SortedY[Index] - Center.Y;
+		const float DeltaZ = FMath::Max(FMath::Abs(SortedZ[Index] - Center.Z) - SortedHalfHeight[Index], 0.0f);
+		const float Reach = SortedRadius[Index] + AttackRadius[AttackIndex];
+		if (DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ <= Reach * Reach)
+		{
+			AddHitIfAllowed(AttackIndex, Index);
+		}
+	}
+}
+
+void FCombatHitResolver::AddHitIfAllowed(int32 AttackIndex, int32 SortedIndex)
+{
+	const int32 HurtboxIndex = SortedToHurtbox[SortedIndex];
+	if (HurtboxOwner[HurtboxIndex] == AttackOwner[AttackIndex])
+	{
+		return;
+	}
+
+	const uint8 Team = AttackTeam[AttackIndex];
+	if (Team != 0 && HurtboxTeam[HurtboxIndex] == Team)
+	{
+		return;
+	}
+
+	Hits.Add(HurtboxIndex);
+}
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Resolves every melee swing of a frame against every hurtbox in one pass.
+ *
+ * Hurtboxes are vertical capsules, swings are spheres. Resolve buckets the hurtboxes into a uniform 2D grid,
+ * stores each bucket contiguously as structure-of-arrays and tests four hurtboxes per SIMD instruction.
+ * Swings and hurtboxes carry an owner id (a swing never hits its own owner) and a team (non-zero teams
+ * do not hit themselves).
+ */
+class NIGHT_FISHERMAN_API FCombatHitResolver
+{
+public:
+	/** Side length of a broadphase cell in cm */
+	static constexpr float CellSize = 400.0f;
+
+	/** Removes all hurtboxes, attacks and results */
+	void Reset();
+
+	/** Removes all hurtboxes, e.g. before gathering their current locations */
+	void ResetHurtboxes();
+
+	/** Removes all attacks and their results, e.g. once they have been dispatched */
+	void ResetAttacks();
+
+	/** Returns the hurtbox index reported by GetHits */
+	int32 AddHurtbox(const FVector3f& Location, float Radius, float HalfHeight, uint32 OwnerId, uint8 Team);
+
+	/** Returns the attack index to pass to GetHits */
+	int32 AddAttack(const FVector3f& Center, float Radius, uint32 OwnerId, uint8 Team);
+
+	/** Tests every attack against every hurtbox. bUseSimd = false runs the scalar reference path. */
+	void Resolve(bool bUseSimd = true);
+
+	/** Hurtbox indices hit by an attack during the last Resolve */
+	TConstArrayView<int32> GetHits(int32 AttackIndex) const;
+
+	int32 NumHurtboxes() const { return HurtboxX.Num(); }
+	int32 NumAttacks() const { return AttackCenters.Num(); }
+	int32 NumHits() const { return Hits.Num(); }
+
+private:
+	struct FIndexRange
+	{
+		int32 Begin;
+		int32 End;
+	};
+
+	struct FCellEntry
+	{
+		FIntPoint Cell;
+		int32 Index;
+	};
+
+	static FIntPoint GetCell(float X, float Y);
+
+	/** Sorts hurtboxes by cell into the Sorted* arrays and fills CellRanges */
+	void BuildBroadphase();
+
+	/** Appends to Hits the hurtboxes in [Begin, End) of the sorted arrays overlapping AttackIndex */
+	void TestRangeSimd(int32 AttackIndex, int32 Begin, int32 End);
+	void TestRangeScalar(int32 AttackIndex, int32 Begin, int32 End);
+
+	/** Applies owner and team filtering to a candidate, then records the hit */
+	void AddHitIfAllowed(int32 AttackIndex, int32 SortedIndex);
+
+	// Hurtboxes in insertion order
+	TArray<float> HurtboxX;
+	TArray<float> HurtboxY;
+	TArray<float> HurtboxZ;
+	TArray<float> HurtboxRadius;
+	TArray<float> HurtboxHalfHeight;
+	TArray<uint32> HurtboxOwner;
+	TArray<uint8> HurtboxTeam;
+	float MaxHurtboxRadius = 0.0f;
+
+	// Hurtboxes sorted by cell, padded by three so a four-wide load starting at any hurtbox stays in bounds
+	TArray<float> SortedX;
+	TArray<float> SortedY;
+	TArray<float> SortedZ;
+	TArray<float> SortedRadius;
+	TArray<float> SortedHalfHeight;
+	TArray<int32> SortedToHurtbox;
+	TArray<FCellEntry> CellOrder;
+	TMap<FIntPoint, FIndexRange> CellRanges;
+
+	// Attacks
+	TArray<FVector3f> AttackCenters;
+	TArray<float> AttackRadius;
+	TArray<uint32> AttackOwner;
+	TArray<uint8> AttackTeam;
+
+	// Results: AttackHitRanges[Attack] indexes into Hits
+	TArray<FIndexRange> AttackHitRanges;
+	TArray<int32> Hits;
+};
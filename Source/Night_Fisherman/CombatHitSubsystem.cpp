@@ -0,0 +1,122 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CombatHitSubsystem.h"
+#include "HurtboxComponent.h"
+#include "Night_Fisherman.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarCombatSimd(
+	TEXT("NF.Combat.Simd"),
+	true,
+	TEXT("Resolve melee swings with the SIMD overlap test instead of the scalar reference."));
+
+void UCombatHitSubsystem::RegisterHurtbox(UHurtboxComponent* Hurtbox)
+{
+	check(Hurtbox);
+	if (Hurtbox->HurtboxIndex == INDEX_NONE)
+	{
+		Hurtbox->HurtboxIndex = Hurtboxes.Add(Hurtbox);
+	}
+}
+
+void UCombatHitSubsystem::UnregisterHurtbox(UHurtboxComponent* Hurtbox)
+{
+	check(Hurtbox);
+	const int32 Index = Hurtbox->HurtboxIndex;
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	Hurtboxes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Hurtboxes.IsValidIndex(Index))
+	{
+		Hurtboxes[Index]->HurtboxIndex = Index;
+	}
+	Hurtbox->HurtboxIndex = INDEX_NONE;
+}
+
+int32 UCombatHitSubsystem::QueueAttack(AActor* Attacker, const FVector& Center, float Radius, float Damage, uint8 Team)
+{
+	Resolver.AddAttack(FVector3f(Center), Radius, Attacker ? Attacker->GetUniqueID() : 0, Team);
+	return PendingAttacks.Add({ Attacker, Damage });
+}
+
+void UCombatHitSubsystem::GetHitsForAttacker(const AActor* Attacker, TArray<UHurtboxComponent*>& OutHits) const
+{
+	for (const FCombatHit& Hit : LastHits)
+	{
+		if (Hit.Attacker.Get() == Attacker)
+		{
+			if (UHurtboxComponent* Hurtbox = Hit.Hurtbox.Get())
+			{
+				OutHits.Add(Hurtbox);
+			}
+		}
+	}
+}
+
+bool UCombatHitSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatHitSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!PendingAttacks.IsEmpty())
+	{
+		ResolvePendingAttacks();
+	}
+}
+
+TStatId UCombatHitSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatHitSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatHitSubsystem::ResolvePendingAttacks()
+{
+	// Hurtboxes move every frame, so gather their current capsules only when there is something to resolve
+	Resolver.ResetHurtboxes();
+	ResolvedHurtboxes.Reset();
+	for (UHurtboxComponent* Hurtbox : Hurtboxes)
+	{
+		if (Hurtbox->bInvulnerable)
+		{
+			continue;
+		}
+
+		const AActor* Owner = Hurtbox->GetOwner();
+		Resolver.AddHurtbox(FVector3f(Hurtbox->GetComponentLocation()), Hurtbox->Radius, Hurtbox->HalfHeight, Owner ? Owner->GetUniqueID() : 0, Hurtbox->Team);
+		ResolvedHurtboxes.Add(Hurtbox);
+	}
+
+	Resolver.Resolve(CVarCombatSimd.GetValueOnGameThread());
+
+	LastHits.Reset();
+	for (int32 AttackIndex = 0; AttackIndex < PendingAttacks.Num(); ++AttackIndex)
+	{
+		const FPendingAttack& Attack = PendingAttacks[AttackIndex];
+		for (const int32 HurtboxIndex : Resolver.GetHits(AttackIndex))
+		{
+			LastHits.Add({ Attack.Attacker, ResolvedHurtboxes[HurtboxIndex], Attack.Damage, AttackIndex });
+		}
+	}
+
+	// Swings queued by OnHurt handlers below are resolved next frame
+	Resolver.ResetAttacks();
+	PendingAttacks.Reset();
+
+	for (const FCombatHit& Hit : LastHits)
+	{
+		if (UHurtboxComponent* Hurtbox = Hit.Hurtbox.Get())
+		{
+			Hurtbox->OnHurt.Broadcast(Hit.Attacker.Get(), Hit.Damage);
+		}
+	}
+
+	OnAttacksResolved.Broadcast();
+}
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "CombatHitResolver.h"
+#include "CombatHitSubsystem.generated.h"
+
+class UHurtboxComponent;
+
+/** A hurtbox hit by a swing during the last resolve */
+struct FCombatHit
+{
+	TWeakObjectPtr<AActor> Attacker;
+	TWeakObjectPtr<UHurtboxComponent> Hurtbox;
+	float Damage;
+
+	/** Index QueueAttack returned for the swing */
+	int32 AttackIndex;
+};
+
+/**
+ * Collects every melee swing issued during a frame and resolves them together at the end of the frame
+ * against all registered hurtboxes, instead of running one physics overlap per swing.
+ * Hit hurtboxes are notified through OnHurt; attackers can read back what they hit until the next resolve.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UCombatHitSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterHurtbox(UHurtboxComponent* Hurtbox);
+	void UnregisterHurtbox(UHurtboxComponent* Hurtbox);
+
+	/** Queues a spherical swing to be resolved with the rest of this frame's swings, returning its index among them */
+	int32 QueueAttack(AActor* Attacker, const FVector& Center, float Radius, float Damage, uint8 Team = 0);
+
+	/** Hurtboxes hit by Attacker's swings in the last resolved frame */
+	void GetHitsForAttacker(const AActor* Attacker, TArray<UHurtboxComponent*>& OutHits) const;
+
+	/** Every hit of the last resolve, grouped by attack */
+	TConstArrayView<FCombatHit> GetLastHits() const { return LastHits; }
+
+	/** Broadcast after queued swings are resolved and OnHurt has been dispatched */
+	FSimpleMulticastDelegate OnAttacksResolved;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FPendingAttack
+	{
+		TWeakObjectPtr<AActor> Attacker;
+		float Damage;
+	};
+
+	/** Resolves the queued swings and notifies the hurtboxes they hit */
+	void ResolvePendingAttacks();
+
+	TArray<UHurtboxComponent*> Hurtboxes;
+
+	/** Queued swings, parallel to the resolver's attacks */
+	TArray<FPendingAttack> PendingAttacks;
+
+	/** Hurtboxes in resolver order, weak so OnHurt handlers may destroy them while hits are dispatched */
+	TArray<TWeakObjectPtr<UHurtboxComponent>> ResolvedHurtboxes;
+
+	TArray<FCombatHit> LastHits;
+
+	FCombatHitResolver Resolver;
+};
@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DashComponent.h"
+#include "Night_Fisherman.h"
+#include "Components/CapsuleComponent.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dash Sweeps"), STAT_DashSweeps, STATGROUP_NightFisherman);
+
+/** How far a watched obstacle may move along the path before the rest of the dash is swept again */
+static constexpr double DashObstacleTolerance = 1.0;
+
+UDashComponent::UDashComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UDashComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	for (int32 Sample = 0; Sample <= NumCurveSamples; ++Sample)
+	{
+		const float Alpha = static_cast<float>(Sample) / NumCurveSamples;
+		DistanceTable[Sample] = DashCurve ? DashCurve->GetFloatValue(Alpha) : 1.0f - FMath::Square(1.0f - Alpha);
+	}
+}
+
+bool UDashComponent::StartDash(const FVector& Direction)
+{
+	const AActor* Owner = GetOwner();
+	const FVector Direction2D = Direction.GetSafeNormal2D();
+	if (bDashing || !Owner || Direction2D.IsZero() || GetWorld()->GetTimeSeconds() < NextDashTime)
+	{
+		return false;
+	}
+
+	DashStart = Owner->GetActorLocation();
+	DashDirection = Direction2D;
+	Elapsed = 0.0f;
+	bDashing = true;
+	SweepPath(0.0f);
+	return true;
+}
+
+bool UDashComponent::Advance(float DeltaTime)
+{
+	AActor* Owner = GetOwner();
+	if (!bDashing || !Owner)
+	{
+		return false;
+	}
+
+	Elapsed += DeltaTime;
+	const float Alpha = FMath::Min(Elapsed / DashDuration, 1.0f);
+
+	const float Travelled = static_cast<float>(FVector::Dist2D(DashStart, Owner->GetActorLocation()));
+	if (HasPathChanged(Travelled))
+	{
+		SweepPath(Travelled);
+	}
+
+	const float Distance = FMath::Min(EvaluateDistance(Alpha) * DashDistance, ClearDistance);
+	FVector Location = DashStart + DashDirection * Distance;
+	Location.Z = Owner->GetActorLocation().Z;
+	Owner->SetActorLocation(FollowFloor(Location));
+
+	// The movement component's floor is stale after the move; rechecking it makes the character fall off ledges
+	const ACharacter* Character = Cast<ACharacter>(Owner);
+	if (UCharacterMovementComponent* Movement = Character ? Character->GetCharacterMovement() : nullptr)
+	{
+		Movement->bForceNextFloorCheck = true;
+	}
+
+	if (Alpha >= 1.0f)
+	{
+		bDashing = false;
+		WatchedObstacles.Reset();
+		NextDashTime = GetWorld()->GetTimeSeconds() + Cooldown;
+	}
+	return bDashing;
+}
+
+float UDashComponent::EvaluateDistance(float Alpha) const
+{
+	const float Position = FMath::Clamp(Alpha, 0.0f, 1.0f) * NumCurveSamples;
+	const int32 Sample = FMath::Min(FMath::FloorToInt32(Position), NumCurveSamples - 1);
+	return FMath::Lerp(DistanceTable[Sample], DistanceTable[Sample + 1], Position - Sample);
+}
+
+FVector UDashComponent::FollowFloor(const FVector& Location) const
+{
+	const ACharacter* Character = GetOwner<ACharacter>();
+	const UCharacterMovementComponent* Movement = Character ? Character->GetCharacterMovement() : nullptr;
+	if (!Movement)
+	{
+		return Location;
+	}
+
+	// Look for floor from a step above the current height down to a step below it
+	const float StepHeight = Movement->MaxStepHeight;
+	const FVector Probe = Location + FVector(0.0, 0.0, StepHeight);
+	FFindFloorResult Floor;
+	Movement->ComputeFloorDist(Probe, 2.0f * StepHeight, 2.0f * StepHeight, Floor, Character->GetCapsuleComponent()->GetScaledCapsuleRadius());
+	if (!Floor.IsWalkableFloor())
+	{
+		return Location;
+	}
+
+	// Hover where the movement component keeps a walking character
+	const float Hover = 0.5f * (UCharacterMovementComponent::MIN_FLOOR_DIST + UCharacterMovementComponent::MAX_FLOOR_DIST);
+	return Probe - FVector(0.0, 0.0, Floor.FloorDist - Hover);
+}
+
+void UDashComponent::SweepPath(float Travelled)
+{
+	INC_DWORD_STAT(STAT_DashSweeps);
+
+	ClearDistance = DashDistance;
+	WatchedObstacles.Reset();
+
+	const ACharacter* Character = GetOwner<ACharacter>();
+	const UCapsuleComponent* Capsule = Character ? Character->GetCapsuleComponent() : nullptr;
+	const UCharacterMovementComponent* Movement = Character ? Character->GetCharacterMovement() : nullptr;
+	if (!Capsule || !Movement || Travelled >= DashDistance)
+	{
+		return;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(DashSweep), false, Character);
+	FCollisionResponseParams ResponseParams;
+	Capsule->InitSweepCollisionParams(QueryParams, ResponseParams);
+
+	// Movable bodies come back as touches instead of ending the sweep, so every one along the path can be watched
+	for (const ECollisionChannel Channel : { ECC_Pawn, ECC_PhysicsBody, ECC_Vehicle, ECC_Destructible })
+	{
+		if (ResponseParams.CollisionResponse.GetResponse(Channel) == ECR_Block)
+		{
+			ResponseParams.CollisionResponse.SetResponse(Channel, ECR_Overlap);
+		}
+	}
+
+	// Swept at the owner's current height, which follows the floor
+	FVector From = DashStart + DashDirection * Travelled;
+	FVector To = DashStart + DashDirection * DashDistance;
+	From.Z = To.Z = Character->GetActorLocation().Z;
+	TArray<FHitResult> Hits;
+	GetWorld()->SweepMultiByChannel(Hits, From, To, Capsule->GetComponentQuat(), Capsule->GetCollisionObjectType(), Capsule->GetCollisionShape(), QueryParams, ResponseParams);
+
+	for (const FHitResult& Hit : Hits)
+	{
+		// Something the owner already overlaps should not stop it from dashing away, nor should a slope it can walk up
+		if (Hit.bStartPenetrating || Movement->IsWalkable(Hit))
+		{
+			continue;
+		}
+
+		const float ContactDistance = Travelled + static_cast<float>(Hit.Distance);
+		ClearDistance = FMath::Min(ClearDistance, ContactDistance);
+
+		UPrimitiveComponent* Component = Hit.GetComponent();
+		if (Component && Component->Mobility == EComponentMobility::Movable)
+		{
+			const float Reach = Capsule->GetScaledCapsuleRadius() + static_cast<float>(Component->Bounds.BoxExtent.Size2D());
+			WatchedObstacles.Add({ Component, Component->GetComponentLocation(), ContactDistance, Reach });
+		}
+	}
+}
+
+bool UDashComponent::HasPathChanged(float Travelled) const
+{
+	for (const FWatchedObstacle& Obstacle : WatchedObstacles)
+	{
+		// Only the obstacle the dash stops at matters if it goes away; the others were beyond it
+		const bool bStopsDash = Obstacle.ContactDistance <= ClearDistance;
+		const UPrimitiveComponent* Component = Obstacle.Component.Get();
+		if (!Component)
+		{
+			if (bStopsDash)
+			{
+				return true;
+			}
+			continue;
+		}
+
+		// Moving along the path moves the contact by as much; moving across it can take the obstacle out of the way
+		const FVector Location = Component->GetComponentLocation();
+		const float Contact = Obstacle.ContactDistance + static_cast<float>(FVector::DotProduct(Location - Obstacle.Location, DashDirection));
+		const bool bInPath = FMath::Abs(FVector::CrossProduct(Location - DashStart, DashDirection).Z) <= Obstacle.Reach;
+		const bool bCameCloser = Contact > Travelled && Contact < ClearDistance - DashObstacleTolerance;
+		const bool bMovedOn = bStopsDash && Contact > ClearDistance + DashObstacleTolerance;
+		if (bInPath ? bCameCloser || bMovedOn : bStopsDash)
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,106 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Containers/StaticArray.h"
+#include "DashComponent.generated.h"
+
+class UCurveFloat;
+class UPrimitiveComponent;
+
+/**
+ * Root-motion-free dash for a character. The dash curve is sampled into a lookup table once at BeginPlay,
+ * and the position along the dash is a function of elapsed time only, so the result does not depend on
+ * frame rate or on how often the owner is ticked.
+ *
+ * The dash sets the owner's ground position directly; its height follows the walkable floor within the
+ * character's step height, and over a drop the character movement component takes over and falls.
+ *
+ * The path is resolved with one capsule sweep when the dash starts; walkable slopes do not stop it. Movable obstacles along it are
+ * remembered and the sweep is only repeated if one of them moves in front of where the dash would stop,
+ * or the one stopping it moves on, leaves the path or goes away; other movement of theirs costs no sweep. Obstacles
+ * that enter the path from outside after the sweep are not seen until the next dash.
+ */
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UDashComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDashComponent();
+
+	/** Distance covered by an unobstructed dash */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Dash, meta = (ClampMin = "0.0"))
+	float DashDistance = 500.0f;
+
+	/** Seconds a dash takes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Dash, meta = (ClampMin = "0.01"))
+	float DashDuration = 0.25f;
+
+	/** Seconds from the start of a dash during which the owner cannot be hit */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Dash, meta = (ClampMin = "0.0"))
+	float InvulnerableDuration = 0.2f;
+
+	/** Seconds after a dash ends before the next one can start */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Dash, meta = (ClampMin = "0.0"))
+	float Cooldown = 0.4f;
+
+	/** Fraction of DashDistance covered (0-1) over fraction of DashDuration elapsed (0-1). An ease-out is used when unset. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Dash)
+	UCurveFloat* DashCurve;
+
+	/** Starts a dash along Direction (flattened to the ground plane), returning false while dashing or cooling down */
+	bool StartDash(const FVector& Direction);
+
+	/** Moves the owner along the dash, returning false once the dash has finished */
+	bool Advance(float DeltaTime);
+
+	bool IsDashing() const { return bDashing; }
+	const FVector& GetDashDirection() const { return DashDirection; }
+	bool IsInvulnerable() const { return bDashing && Elapsed < InvulnerableDuration; }
+
+protected:
+	// UActorComponent implementation
+	virtual void BeginPlay() override;
+
+private:
+	static constexpr int32 NumCurveSamples = 64;
+
+	/** Fraction of DashDistance covered after Alpha of DashDuration, interpolated from DistanceTable */
+	float EvaluateDistance(float Alpha) const;
+
+	/** Location lifted or lowered onto the walkable floor within a step of it; unchanged over a drop */
+	FVector FollowFloor(const FVector& Location) const;
+
+	/** Sweeps the owner's capsule from Travelled along the path to its end, updating ClearDistance and WatchedObstacles */
+	void SweepPath(float Travelled);
+
+	/** Whether a movable obstacle seen by the last sweep has moved so that it changes ClearDistance */
+	bool HasPathChanged(float Travelled) const;
+
+	struct FWatchedObstacle
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		FVector Location;
+		/** Distance from DashStart at which the owner touched it, when it was at Location */
+		float ContactDistance;
+		/** Distance from the path's center line within which it is in the way */
+		float Reach;
+	};
+
+	TStaticArray<float, NumCurveSamples + 1> DistanceTable;
+
+	FVector DashStart = FVector::ZeroVector;
+	FVector DashDirection = FVector::ForwardVector;
+
+	/** Distance from DashStart the owner can travel before hitting an obstacle */
+	float ClearDistance = 0.0f;
+
+	float Elapsed = 0.0f;
+	double NextDashTime = 0.0;
+	bool bDashing = false;
+
+	TArray<FWatchedObstacle, TInlineAllocator<4>> WatchedObstacles;
+};
@@ -0,0 +1,211 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "DeterminismSubsystem.h"
+#include "BiteSubsystem.h"
+#include "FishingLineSubsystem.h"
+#include "FishPopulationSubsystem.h"
+#include "Night_Fisherman.h"
+#include "ProjectileSubsystem.h"
+#include "TopDownCharacter.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Crc.h"
+
+static TAutoConsoleVariable<bool> CVarDeterministic(
+	TEXT("NF.Deterministic"),
+	false,
+	TEXT("Run worlds started from now on deterministically: fixed timestep, random sources seeded from NF.Deterministic.Seed and no wall-clock time slicing. -Deterministic turns it on from the command line."));
+
+static TAutoConsoleVariable<int32> CVarDeterministicSeed(
+	TEXT("NF.Deterministic.Seed"),
+	0,
+	TEXT("Seed every random source is derived from in deterministic mode. -DeterministicSeed=N overrides it."));
+
+static TAutoConsoleVariable<float> CVarDeterministicFps(
+	TEXT("NF.Deterministic.Fps"),
+	60.0f,
+	TEXT("Fixed frame rate the engine steps at in deterministic mode."));
+
+namespace Determinism
+{
+	template <typename T>
+	static uint32 HashValue(const T& Value, uint32 Crc)
+	{
+		return FCrc::MemCrc32(&Value, sizeof(T), Crc);
+	}
+
+	template <typename T>
+	static uint32 HashView(TConstArrayView<T> View, uint32 Crc)
+	{
+		return FCrc::MemCrc32(View.GetData(), View.Num() * sizeof(T), Crc);
+	}
+
+	static int32 GetSeed()
+	{
+		int32 Seed = CVarDeterministicSeed.GetValueOnGameThread();
+		FParse::Value(FCommandLine::Get(), TEXT("DeterministicSeed="), Seed);
+		return Seed;
+	}
+}
+
+bool UDeterminismSubsystem::IsEnabled()
+{
+	static const bool bCommandLine = FParse::Param(FCommandLine::Get(), TEXT("Deterministic"));
+	return bCommandLine || CVarDeterministic.GetValueOnGameThread();
+}
+
+int32 UDeterminismSubsystem::MakeSeed(uint32 Key)
+{
+	if (!IsEnabled())
+	{
+		return static_cast<int32>(Key);
+	}
+
+	return static_cast<int32>(HashCombineFast(static_cast<uint32>(Determinism::GetSeed()), Key));
+}
+
+void UDeterminismSubsystem::SetTimestepOverride(float FixedDeltaTime)
+{
+	TimestepOverride = FMath::Max(FixedDeltaTime, 0.0f);
+	ApplyTimestep();
+}
+
+uint32 UDeterminismSubsystem::ComputeStateHash() const
+{
+	using namespace Determinism;
+
+	const UWorld* World = GetWorld();
+	uint32 Crc = HashValue(World->GetTimeSeconds(), 0);
+
+	// Actor iteration follows spawn order, which is itself deterministic
+	for (TActorIterator<ATopDownCharacter> It(World); It; ++It)
+	{
+		Crc = HashValue(It->GetActorLocation(), Crc);
+		Crc = HashValue(It->GetActorQuat(), Crc);
+		Crc = HashValue(It->GetVelocity(), Crc);
+	}
+
+	if (const UFishPopulationSubsystem* FishPopulation = World->GetSubsystem<UFishPopulationSubsystem>())
+	{
+		const FFishPopulation& Population = FishPopulation->GetPopulation();
+		Crc = HashView(Population.GetPositions(), Crc);
+		Crc = HashView(Population.GetHunger(), Crc);
+		Crc = HashView(Population.GetBiteReadiness(), Crc);
+	}
+
+	if (const UFishingLineSubsystem* FishingLines = World->GetSubsystem<UFishingLineSubsystem>())
+	{
+		const FFishingLineSolver& Solver = FishingLines->GetSolver();
+		for (int32 Line = 0; Line < Solver.GetCapacity(); ++Line)
+		{
+			if (Solver.IsActive(Line))
+			{
+				Crc = HashValue(Line, Crc);
+				Crc = HashValue(Solver.GetBobber(Line), Crc);
+				Crc = HashValue(Solver.GetLength(Line), Crc);
+			}
+		}
+	}
+
+	if (const UBiteSubsystem* Bites = World->GetSubsystem<UBiteSubsystem>())
+	{
+		Crc = HashValue(Bites->GetNumLines(), Crc);
+		Crc = HashValue(Bites->GetNumPendingEvents(), Crc);
+	}
+
+	if (const UProjectileSubsystem* Projectiles = World->GetSubsystem<UProjectileSubsystem>())
+	{
+		const FProjectilePool& Pool = Projectiles->GetPool();
+		Crc = HashView(Pool.GetPositions(), Crc);
+		Crc = HashView(Pool.GetVelocities(), Crc);
+	}
+
+	return Crc;
+}
+
+void UDeterminismSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bInitialized = true;
+	bEnabled = IsEnabled();
+	if (bEnabled)
+	{
+		// Engine and Blueprint randomness goes through the global streams
+		const int32 Seed = MakeSeed(GetTypeHash(GetWorld()->GetFName()));
+		FMath::RandInit(Seed);
+		FMath::SRandInit(Seed);
+
+		UE_LOG(LogNightFisherman, Display, TEXT("Deterministic mode: %.1f fps fixed timestep, seed %d"), CVarDeterministicFps.GetValueOnGameThread(), Determinism::GetSeed());
+	}
+	ApplyTimestep();
+}
+
+void UDeterminismSubsystem::Deinitialize()
+{
+	TimestepOverride = 0.0f;
+	bEnabled = false;
+	ApplyTimestep();
+
+	// Subsystems deinitialize in no particular order; one still running must not lock the timestep again
+	bInitialized = false;
+
+	Super::Deinitialize();
+}
+
+bool UDeterminismSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UDeterminismSubsystem::ApplyTimestep()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	const double FixedDeltaTime = TimestepOverride > 0.0f ? TimestepOverride
+		: bEnabled ? 1.0 / FMath::Max(CVarDeterministicFps.GetValueOnGameThread(), 1.0f)
+		: 0.0;
+
+	if (FixedDeltaTime > 0.0)
+	{
+		if (!bTimestepLocked)
+		{
+			bSavedUseFixedTimeStep = FApp::UseFixedTimeStep();
+			SavedFixedDeltaTime = FApp::GetFixedDeltaTime();
+			bTimestepLocked = true;
+		}
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(FixedDeltaTime);
+	}
+	else if (bTimestepLocked)
+	{
+		FApp::SetUseFixedTimeStep(bSavedUseFixedTimeStep);
+		FApp::SetFixedDeltaTime(SavedFixedDeltaTime);
+		bTimestepLocked = false;
+	}
+}
+
+namespace Determinism
+{
+	static FAutoConsoleCommandWithWorldAndArgs HashCommand(
+		TEXT("NF.Deterministic.Hash"),
+		TEXT("Logs the gameplay state hash, which matches between deterministic runs of the same replay at the same world time."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const UDeterminismSubsystem* Determinism = World ? World->GetSubsystem<UDeterminismSubsystem>() : nullptr;
+			if (!Determinism)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Deterministic.Hash needs a game world"));
+				return;
+			}
+
+			UE_LOG(LogNightFisherman, Display, TEXT("State hash %08x at %.4f s%s"), Determinism->ComputeStateHash(), World->GetTimeSeconds(),
+				UDeterminismSubsystem::IsEnabled() ? TEXT("") : TEXT(" (deterministic mode is off)"));
+		}));
+}
@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeterminismSubsystem.generated.h"
+
+/**
+ * Deterministic simulation mode for reproducible benchmark runs, switched on with NF.Deterministic or -Deterministic.
+ *
+ * While it is on, the engine steps at a fixed NF.Deterministic.Fps timestep, every random source in the module is
+ * seeded from the one NF.Deterministic.Seed (-DeterministicSeed=N), and time-sliced gameplay runs to completion in
+ * registration order instead of stopping at a wall-clock budget. Two runs of the same input replay then reach
+ * bit-identical state, which ComputeStateHash fingerprints. Seeds are drawn as a world starts, so switching the
+ * mode on takes full effect from the next world.
+ *
+ * The subsystem also owns the engine timestep for the module: UInputReplaySubsystem asks it for the recording's
+ * timestep instead of changing FApp itself, and the original settings come back once neither needs it.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UDeterminismSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static bool IsEnabled();
+
+	/**
+	 * Seed for the random source identified by Key, which must be stable from run to run (a name or a placement,
+	 * never an object's unique ID). In deterministic mode it is mixed with NF.Deterministic.Seed; otherwise Key is the seed.
+	 */
+	static int32 MakeSeed(uint32 Key);
+
+	/** Runs the engine at FixedDeltaTime regardless of the mode, e.g. for an input replay; 0 hands the timestep back */
+	void SetTimestepOverride(float FixedDeltaTime);
+
+	/** Fingerprint of the simulated gameplay state: world time, characters, fish, fishing lines, bites and projectiles */
+	uint32 ComputeStateHash() const;
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Locks FApp to the override or the deterministic timestep, or restores the saved settings if neither applies */
+	void ApplyTimestep();
+
+	float TimestepOverride = 0.0f;
+	bool bEnabled = false;
+	bool bInitialized = false;
+
+	/** Engine timestep settings to restore once nothing needs a fixed timestep */
+	bool bTimestepLocked = false;
+	bool bSavedUseFixedTimeStep = false;
+	double SavedFixedDeltaTime = 0.0;
+};
@@ -0,0 +1,24 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishLake.h"
+#include "FishPopulationSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+
+AFishLake::AFishLake()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+// Called when the game starts or when spawned
+void AFishLake::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UFishPopulationSubsystem* FishPopulation = GetWorld()->GetSubsystem<UFishPopulationSubsystem>())
+	{
+		FishPopulation->AddLake(GetActorLocation(), Radius, Depth, NumFish);
+	}
+}
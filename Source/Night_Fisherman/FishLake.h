@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "FishLake.generated.h"
+
+/** Place at the water surface of a lake to stock it with simulated fish when play begins */
+UCLASS()
+class NIGHT_FISHERMAN_API AFishLake : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AFishLake();
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/** Radius of the stocked area around the actor */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (ClampMin = "100.0"))
+	float Radius = 2000.0f;
+
+	/** Deepest point below the actor fish may swim to */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (ClampMin = "10.0"))
+	float Depth = 400.0f;
+
+	/** Number of fish simulated in this lake */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (ClampMin = "0"))
+	int32 NumFish = 2000;
+};
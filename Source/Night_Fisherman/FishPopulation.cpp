@@ -0,0 +1,262 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishPopulation.h"
+#include "Night_Fisherman.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fish Population Step"), STAT_FishPopulationStep, STATGROUP_NightFisherman);
+
+namespace FishPopulation
+{
+	struct FSpeciesInfo
+	{
+		/** Cruising speed in cm/s */
+		float Speed;
+		/** Hunger gained per second */
+		float HungerRate;
+		/** Preferred depth band below the surface in cm */
+		float MinDepth;
+		float MaxDepth;
+	};
+
+	// Indexed by EFishSpecies; catfish feed hardest at night
+	static const FSpeciesInfo SpeciesInfos[] =
+	{
+		{ 60.0f, 0.020f, 50.0f, 200.0f },	// Perch
+		{ 90.0f, 0.015f, 30.0f, 150.0f },	// Trout
+		{ 40.0f, 0.030f, 150.0f, 400.0f },	// Catfish
+		{ 120.0f, 0.010f, 50.0f, 250.0f },	// Pike
+	};
+	static_assert(UE_ARRAY_COUNT(SpeciesInfos) == static_cast<int32>(EFishSpecies::Count), "SpeciesInfos must cover every EFishSpecies");
+
+	/** Radians per second a wandering fish may turn */
+	static constexpr float WanderTurnRate = 2.0f;
+	/** How quickly a fish aligns its heading with a lure or the lake centre */
+	static constexpr float SteerRate = 3.0f;
+	/** How quickly bite readiness follows hunger times lure attraction */
+	static constexpr float ReadinessRate = 2.0f;
+
+	/** Cheap integer hash for per-fish noise that is independent of thread scheduling */
+	FORCEINLINE uint32 Hash(uint32 A, uint32 B)
+	{
+		uint32 H = A * 0x9E3779B9u ^ B * 0x85EBCA6Bu;
+		H ^= H >> 16;
+		H *= 0x7FEB352Du;
+		H ^= H >> 15;
+		H *= 0x846CA68Bu;
+		H ^= H >> 16;
+		return H;
+	}
+}
+
+int32 FFishPopulation::AddLake(const FVector3f& Center, float Radius, float Depth, int32 NumFish, int32 Seed)
+{
+	check(Lakes.Num() < MAX_uint16);
+	const int32 LakeIndex = Lakes.Add({ Center, Radius, Depth });
+
+	const int32 FirstFish = Positions.Num();
+	const int32 NewNum = FirstFish + NumFish;
+	Positions.SetNumUninitialized(NewNum);
+	Velocities.SetNumUninitialized(NewNum);
+	Species.SetNumUninitialized(NewNum);
+	LakeIndices.SetNumUninitialized(NewNum);
+	Hunger.SetNumUninitialized(NewNum);
+	BiteReadiness.SetNumUninitialized(NewNum);
+
+	// Later noise follows the lake seeds too, so one seed decides the whole population
+	NoiseSeed = FishPopulation::Hash(NoiseSeed, static_cast<uint32>(Seed));
+
+	FRandomStream Random(Seed);
+	for (int32 FishIndex = FirstFish; FishIndex < NewNum; ++FishIndex)
+	{
+		Species[FishIndex] = static_cast<uint8>(Random.RandHelper(static_cast<int32>(EFishSpecies::Count)));
+		LakeIndices[FishIndex] = static_cast<uint16>(LakeIndex);
+		Hunger[FishIndex] = Random.FRand();
+		BiteReadiness[FishIndex] = 0.0f;
+		PlaceInLake(FishIndex, Random);
+	}
+
+	return LakeIndex;
+}
+
+void FFishPopulation::Reset()
+{
+	Positions.Reset();
+	Velocities.Reset();
+	Species.Reset();
+	LakeIndices.Reset();
+	Hunger.Reset();
+	BiteReadiness.Reset();
+	Lakes.Reset();
+	StepCount = 0;
+	RespawnSeed = 0;
+	NoiseSeed = 0;
+}
+
+void FFishPopulation::Step(float DeltaTime, TConstArrayView<FFishLure> Lures, bool bParallel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FishPopulationStep);
+
+	const int32 NumFish = Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumFish, ChunkSize);
+	ParallelFor(NumChunks, [this, NumFish, DeltaTime, Lures](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * ChunkSize;
+		StepRange(Begin, FMath::Min(Begin + ChunkSize, NumFish), DeltaTime, Lures);
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	++StepCount;
+}
+
+void FFishPopulation::StepRange(int32 Begin, int32 End, float DeltaTime, TConstArrayView<FFishLure> Lures)
+{
+	using namespace FishPopulation;
+
+	FVector3f* RESTRICT PositionData = Positions.GetData();
+	FVector3f* RESTRICT VelocityData = Velocities.GetData();
+	float* RESTRICT HungerData = Hunger.GetData();
+	float* RESTRICT ReadinessData = BiteReadiness.GetData();
+
+	const float SteerAlpha = FMath::Min(SteerRate * DeltaTime, 1.0f);
+	const float ReadinessAlpha = FMath::Min(ReadinessRate * DeltaTime, 1.0f);
+
+	for (int32 FishIndex = Begin; FishIndex < End; ++FishIndex)
+	{
+		const FSpeciesInfo& Info = SpeciesInfos[Species[FishIndex]];
+		const FLake& Lake = Lakes[LakeIndices[FishIndex]];
+		FVector3f Position = PositionData[FishIndex];
+		FVector3f Velocity = VelocityData[FishIndex];
+
+		// Wander: turn the heading by a small random angle
+		const uint32 Noise = Hash(FishIndex ^ NoiseSeed, StepCount);
+		const float Turn = ((Noise & 0xFFFF) * (1.0f / 65535.0f) - 0.5f) * WanderTurnRate * DeltaTime;
+		float TurnSin, TurnCos;
+		FMath::SinCos(&TurnSin, &TurnCos, Turn);
+		Velocity = FVector3f(Velocity.X * TurnCos - Velocity.Y * TurnSin, Velocity.X * TurnSin + Velocity.Y * TurnCos, Velocity.Z);
+
+		// Attraction to the nearest lure in range, scaled by how hungry the fish is. Lures reach down
+		// the whole water column, so only horizontal distance counts.
+		float Attraction = 0.0f;
+		FVector3f ToLure = FVector3f::ZeroVector;
+		for (const FFishLure& Lure : Lures)
+		{
+			const FVector3f Delta(Lure.Location.X - Position.X, Lure.Location.Y - Position.Y, 0.0f);
+			const float DistanceSquared = Delta.SizeSquared();
+			if (DistanceSquared < FMath::Square(Lure.Radius))
+			{
+				const float LureAttraction = 1.0f - FMath::Sqrt(DistanceSquared) / Lure.Radius;
+				if (LureAttraction > Attraction)
+				{
+					Attraction = LureAttraction;
+					ToLure = Delta;
+				}
+			}
+		}
+
+		FVector3f DesiredDirection = FVector3f::ZeroVector;
+		if (Attraction > 0.0f)
+		{
+			DesiredDirection = ToLure.GetSafeNormal() * (Attraction * HungerData[FishIndex]);
+		}
+
+		// Stay inside the lake disc and the species depth band
+		const FVector2f FromCenter(Position.X - Lake.Center.X, Position.Y - Lake.Center.Y);
+		if (FromCenter.SizeSquared() > FMath::Square(Lake.Radius))
+		{
+			DesiredDirection -= FVector3f(FromCenter.GetSafeNormal(), 0.0f);
+		}
+
+		const float Depth = Lake.Center.Z - Position.Z;
+		const float MaxDepth = FMath::Min(Info.MaxDepth, Lake.Depth);
+		if (Depth < Info.MinDepth)
+		{
+			DesiredDirection.Z -= 1.0f;
+		}
+		else if (Depth > MaxDepth)
+		{
+			DesiredDirection.Z += 1.0f;
+		}
+
+		const FVector3f Heading = (Velocity + DesiredDirection * (Info.Speed * SteerAlpha)).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::ForwardVector);
+		Velocity = Heading * Info.Speed;
+		Position += Velocity * DeltaTime;
+
+		PositionData[FishIndex] = Position;
+		VelocityData[FishIndex] = Velocity;
+
+		const float NewHunger = FMath::Min(HungerData[FishIndex] + Info.HungerRate * DeltaTime, 1.0f);
+		HungerData[FishIndex] = NewHunger;
+		ReadinessData[FishIndex] += (NewHunger * Attraction - ReadinessData[FishIndex]) * ReadinessAlpha;
+	}
+}
+
+bool FFishPopulation::GetWaterHeight(float X, float Y, float& OutHeight) const
+{
+	for (const FLake& Lake : Lakes)
+	{
+		if (FMath::Square(X - Lake.Center.X) + FMath::Square(Y - Lake.Center.Y) <= FMath::Square(Lake.Radius))
+		{
+			OutHeight = Lake.Center.Z;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FFishPopulation::GatherNear(const FVector3f& Location, float Radius, TArray<FFishSighting>& OutFish) const
+{
+	const int32 FirstOut = OutFish.Num();
+	const float RadiusSquared = FMath::Square(Radius);
+	const FVector3f* RESTRICT PositionData = Positions.GetData();
+
+	for (int32 FishIndex = 0; FishIndex < Positions.Num(); ++FishIndex)
+	{
+		if (FVector3f::DistSquared2D(PositionData[FishIndex], Location) <= RadiusSquared)
+		{
+			FFishSighting& Sighting = OutFish.AddDefaulted_GetRef();
+			Sighting.FishIndex = FishIndex;
+			Sighting.Species = static_cast<EFishSpecies>(Species[FishIndex]);
+			Sighting.Location = FVector(PositionData[FishIndex]);
+			Sighting.Hunger = Hunger[FishIndex];
+			Sighting.BiteReadiness = BiteReadiness[FishIndex];
+		}
+	}
+
+	const FVector Origin(Location);
+	TArrayView<FFishSighting>(OutFish).RightChop(FirstOut).Sort([&Origin](const FFishSighting& A, const FFishSighting& B)
+	{
+		return FVector::DistSquared2D(A.Location, Origin) < FVector::DistSquared2D(B.Location, Origin);
+	});
+}
+
+void FFishPopulation::Respawn(int32 FishIndex)
+{
+	check(Positions.IsValidIndex(FishIndex));
+
+	FRandomStream Random(static_cast<int32>(FishPopulation::Hash(FishIndex, ++RespawnSeed ^ NoiseSeed)));
+	Hunger[FishIndex] = 0.0f;
+	BiteReadiness[FishIndex] = 0.0f;
+	PlaceInLake(FishIndex, Random);
+}
+
+SIZE_T FFishPopulation::GetAllocatedSize() const
+{
+	return Positions.GetAllocatedSize() + Velocities.GetAllocatedSize() + Species.GetAllocatedSize()
+		+ LakeIndices.GetAllocatedSize() + Hunger.GetAllocatedSize() + BiteReadiness.GetAllocatedSize()
+		+ Lakes.GetAllocatedSize();
+}
+
+void FFishPopulation::PlaceInLake(int32 FishIndex, FRandomStream& Random)
+{
+	const FLake& Lake = Lakes[LakeIndices[FishIndex]];
+	const FishPopulation::FSpeciesInfo& Info = FishPopulation::SpeciesInfos[Species[FishIndex]];
+
+	// Uniform over the disc
+	const float Distance = Lake.Radius * FMath::Sqrt(Random.FRand());
+	const float Angle = Random.FRand() * UE_TWO_PI;
+	const float Depth = Random.FRandRange(Info.MinDepth, FMath::Max(FMath::Min(Info.MaxDepth, Lake.Depth), Info.MinDepth));
+	Positions[FishIndex] = Lake.Center + FVector3f(Distance * FMath::Cos(Angle), Distance * FMath::Sin(Angle), -Depth);
+
+	const float Heading = Random.FRand() * UE_TWO_PI;
+	Velocities[FishIndex] = FVector3f(FMath::Cos(Heading), FMath::Sin(Heading), 0.0f) * Info.Speed;
+}
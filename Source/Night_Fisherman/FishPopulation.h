@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FishPopulation.generated.h"
+
+UENUM(BlueprintType)
+enum class EFishSpecies : uint8
+{
+	Perch,
+	Trout,
+	Catfish,
+	Pike,
+	Count UMETA(Hidden)
+};
+
+/** A fish surfaced to gameplay, copied out of the population so callers never touch the simulation buffers */
+USTRUCT(BlueprintType)
+struct NIGHT_FISHERMAN_API FFishSighting
+{
+	GENERATED_BODY()
+
+	/** Index into the population, valid until the fish is caught and respawned */
+	UPROPERTY(BlueprintReadOnly, Category = Fishing)
+	int32 FishIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = Fishing)
+	EFishSpecies Species = EFishSpecies::Perch;
+
+	UPROPERTY(BlueprintReadOnly, Category = Fishing)
+	FVector Location = FVector::ZeroVector;
+
+	/** 0 when just fed, 1 when starving */
+	UPROPERTY(BlueprintReadOnly, Category = Fishing)
+	float Hunger = 0.0f;
+
+	/** 0 when ignoring the lure, 1 when about to bite */
+	UPROPERTY(BlueprintReadOnly, Category = Fishing)
+	float BiteReadiness = 0.0f;
+};
+
+/** A baited line in the water that hungry fish within Radius (horizontally) steer towards */
+struct FFishLure
+{
+	FVector3f Location;
+	float Radius;
+};
+
+/**
+ * Fish state stored as structure-of-arrays so the step kernel streams through contiguous buffers.
+ * Fish are plain indices, not actors; stepping is split into fixed-size chunks run with ParallelFor.
+ * Per-fish randomness is hashed from the fish index, step count and lake seeds, so results do not
+ * depend on how chunks are scheduled across workers.
+ */
+class NIGHT_FISHERMAN_API FFishPopulation
+{
+public:
+	/** Fish per ParallelFor work item */
+	static constexpr int32 ChunkSize = 1024;
+
+	/** Fills a disc-shaped lake whose water surface is at Center.Z. Returns the lake index. */
+	int32 AddLake(const FVector3f& Center, float Radius, float Depth, int32 NumFish, int32 Seed);
+
+	/** Removes every fish and lake */
+	void Reset();
+
+	/** Advances every fish by DeltaTime, steering hungry fish towards Lures */
+	void Step(float DeltaTime, TConstArrayView<FFishLure> Lures, bool bParallel = true);
+
+	/** Appends the fish within Radius of Location horizontally to OutFish, nearest first */
+	void GatherNear(const FVector3f& Location, float Radius, TArray<FFishSighting>& OutFish) const;
+
+	/** Returns true and the water surface height if a lake covers X, Y */
+	bool GetWaterHeight(float X, float Y, float& OutHeight) const;
+
+	/** Feeds the fish and moves it to a random spot in its lake, e.g. after it was caught */
+	void Respawn(int32 FishIndex);
+
+	int32 Num() const { return Positions.Num(); }
+
+	SIZE_T GetAllocatedSize() const;
+
+	TConstArrayView<FVector3f> GetPositions() const { return Positions; }
+	TConstArrayView<uint8> GetSpecies() const { return Species; }
+	TConstArrayView<float> GetHunger() const { return Hunger; }
+	TConstArrayView<float> GetBiteReadiness() const { return BiteReadiness; }
+
+private:
+	struct FLake
+	{
+		FVector3f Center;
+		float Radius;
+		float Depth;
+	};
+
+	void StepRange(int32 Begin, int32 End, float DeltaTime, TConstArrayView<FFishLure> Lures);
+
+	/** Places a fish at a random position inside its lake */
+	void PlaceInLake(int32 FishIndex, FRandomStream& Random);
+
+	TArray<FVector3f> Positions;
+	TArray<FVector3f> Velocities;
+	TArray<uint8> Species;
+	TArray<uint16> LakeIndices;
+	TArray<float> Hunger;
+	TArray<float> BiteReadiness;
+
+	TArray<FLake> Lakes;
+	uint32 StepCount = 0;
+	int32 RespawnSeed = 0;
+
+	/** Mixed from every lake's seed; salts wander and respawn noise */
+	uint32 NoiseSeed = 0;
+};
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishPopulation.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	static void RunFishPopulationBenchmark(const TArray<FString>& Args)
+	{
+		static const int32 FishCounts[] = { 1000, 2500, 5000, 10000, 25000, 50000, 100000 };
+		const int32 NumSteps = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 60, 1);
+		constexpr int32 NumQueries = 100;
+		constexpr float DeltaTime = 1.0f / 60.0f;
+		constexpr float QueryRadius = 500.0f;
+
+		FCsvWriter Csv(TEXT("FishPopulation"), { TEXT("Fish"), TEXT("ParallelStepMs"), TEXT("SingleThreadStepMs"), TEXT("Speedup"), TEXT("QueryUs"), TEXT("BytesPerFish") });
+
+		for (const int32 NumFish : FishCounts)
+		{
+			// Keep density constant so lure and query hit counts stay comparable across sizes
+			const float Radius = FMath::Sqrt(NumFish * 2500.0f / UE_PI);
+
+			FFishPopulation Population;
+			Population.AddLake(FVector3f::ZeroVector, Radius, 400.0f, NumFish, NumFish);
+
+			TArray<FFishLure> Lures;
+			for (int32 LureIndex = 0; LureIndex < 8; ++LureIndex)
+			{
+				const float Angle = LureIndex * UE_TWO_PI / 8.0f;
+				Lures.Add({ FVector3f(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius * 0.5f, 600.0f });
+			}
+
+			// Warm caches and the worker pool before timing
+			for (int32 Step = 0; Step < 5; ++Step)
+			{
+				Population.Step(DeltaTime, Lures, true);
+			}
+
+			const double ParallelMs = TimeAverageMs(NumSteps, [&] { Population.Step(DeltaTime, Lures, true); });
+			const double SingleThreadMs = TimeAverageMs(NumSteps, [&] { Population.Step(DeltaTime, Lures, false); });
+
+			TArray<FFishSighting> Sightings;
+			const double QueryMs = TimeAverageMs(NumQueries, [&]
+			{
+				Sightings.Reset();
+				Population.GatherNear(Lures[0].Location, QueryRadius, Sightings);
+			});
+
+			Csv.AddRow(NumFish, ParallelMs, SingleThreadMs, SingleThreadMs / FMath::Max(ParallelMs, UE_DOUBLE_SMALL_NUMBER),
+				QueryMs * 1000.0, static_cast<double>(Population.GetAllocatedSize()) / NumFish);
+
+			UE_LOG(LogNightFisherman, Display, TEXT("FishPopulation %6d fish: %.3f ms parallel, %.3f ms single thread, %.1f us query (%d hits)"),
+				NumFish, ParallelMs, SingleThreadMs, QueryMs * 1000.0, Sightings.Num());
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommand FishPopulationBenchmarkCommand(
+		TEXT("NF.Benchmark.FishPopulation"),
+		TEXT("Times the fish population step from 1k to 100k fish, parallel and single threaded, and writes FishPopulation.csv. Usage: NF.Benchmark.FishPopulation [Steps=60]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunFishPopulationBenchmark));
+}
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishPopulationSubsystem.h"
+#include "DeterminismSubsystem.h"
+#include "Night_Fisherman.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarFishPopulationParallel(
+	TEXT("NF.Fish.Parallel"),
+	true,
+	TEXT("Step the fish population across task graph workers."));
+
+/** Longest step the simulation takes in one go, so hitches do not fling fish out of their lakes */
+static constexpr float MaxFishStepSeconds = 0.1f;
+
+int32 UFishPopulationSubsystem::AddLake(FVector Center, float Radius, float Depth, int32 NumFish)
+{
+	const int32 Seed = UDeterminismSubsystem::MakeSeed(GetTypeHash(Center) ^ static_cast<uint32>(Population.Num()));
+	const int32 LakeIndex = Population.AddLake(FVector3f(Center), Radius, Depth, FMath::Max(NumFish, 0), Seed);
+
+	UE_LOG(LogNightFisherman, Log, TEXT("Fish lake %d: %d fish, %d total (%.1f KB)"), LakeIndex, NumFish, Population.Num(), Population.GetAllocatedSize() / 1024.0);
+	return LakeIndex;
+}
+
+void UFishPopulationSubsystem::CastLine(const UObject* Caster, const FVector& Location, float Radius)
+{
+	int32 Index = LureCasters.IndexOfByKey(Caster);
+	if (Index == INDEX_NONE)
+	{
+		Index = Lures.AddUninitialized();
+		LureCasters.Add(Caster);
+	}
+	Lures[Index] = { FVector3f(Location), Radius };
+}
+
+void UFishPopulationSubsystem::ReelIn(const UObject* Caster)
+{
+	const int32 Index = LureCasters.IndexOfByKey(Caster);
+	if (Index != INDEX_NONE)
+	{
+		Lures.RemoveAtSwap(Index);
+		LureCasters.RemoveAtSwap(Index);
+	}
+}
+
+bool UFishPopulationSubsystem::HasLineCast(const UObject* Caster) const
+{
+	return LureCasters.Contains(Caster);
+}
+
+void UFishPopulationSubsystem::GetFishNear(const FVector& Location, float Radius, TArray<FFishSighting>& OutFish) const
+{
+	Population.GatherNear(FVector3f(Location), Radius, OutFish);
+}
+
+void UFishPopulationSubsystem::CatchFish(int32 FishIndex)
+{
+	if (FishIndex >= 0 && FishIndex < Population.Num())
+	{
+		Population.Respawn(FishIndex);
+	}
+}
+
+bool UFishPopulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UFishPopulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Lines whose caster went away stop attracting fish
+	for (int32 Index = LureCasters.Num() - 1; Index >= 0; --Index)
+	{
+		if (!LureCasters[Index].IsValid())
+		{
+			Lures.RemoveAtSwap(Index);
+			LureCasters.RemoveAtSwap(Index);
+		}
+	}
+
+	if (Population.Num() > 0)
+	{
+		Population.Step(FMath::Min(DeltaTime, MaxFishStepSeconds), Lures, CVarFishPopulationParallel.GetValueOnGameThread());
+	}
+}
+
+TStatId UFishPopulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFishPopulationSubsystem, STATGROUP_Tickables);
+}
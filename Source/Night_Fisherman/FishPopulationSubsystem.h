@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "FishPopulation.h"
+#include "FishPopulationSubsystem.generated.h"
+
+/**
+ * Owns the world's fish and steps them every frame on worker threads.
+ * Gameplay never sees the simulation buffers, only FFishSighting copies of the fish near a cast line.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UFishPopulationSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Fills a disc-shaped lake whose water surface is at Center.Z. Returns the lake index. */
+	UFUNCTION(BlueprintCallable, Category = Fishing)
+	int32 AddLake(FVector Center, float Radius, float Depth, int32 NumFish);
+
+	/** Puts Caster's lure in the water at Location; hungry fish within Radius steer towards it */
+	void CastLine(const UObject* Caster, const FVector& Location, float Radius);
+
+	/** Takes Caster's lure out of the water */
+	void ReelIn(const UObject* Caster);
+
+	bool HasLineCast(const UObject* Caster) const;
+
+	/** Copies out the fish within Radius of Location horizontally, nearest first */
+	void GetFishNear(const FVector& Location, float Radius, TArray<FFishSighting>& OutFish) const;
+
+	/** Removes a caught fish from play by respawning it elsewhere in its lake */
+	void CatchFish(int32 FishIndex);
+
+	const FFishPopulation& GetPopulation() const { return Population; }
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	FFishPopulation Population;
+
+	/** Lures and the objects that cast them, kept in parallel so Lures can be handed to the step kernel directly */
+	TArray<FFishLure> Lures;
+	TArray<TWeakObjectPtr<const UObject>> LureCasters;
+};
@@ -0,0 +1,119 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishingLineSolver.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	/** Casts NumLines lines from rods along the shore of a lake filling X > 0, water surface at Z = 0 */
+	static void CastBenchmarkLines(FFishingLineSolver& Solver, int32 NumLines)
+	{
+		Solver.Initialize(NumLines);
+		for (int32 Line = 0; Line < NumLines; ++Line)
+		{
+			const float Y = Line * 150.0f;
+			const FVector3f Tip(-100.0f, Y, 150.0f);
+			const FVector3f Lure(400.0f + (Line % 7) * 100.0f, Y, 50.0f);
+			Solver.AddLine(Tip, Lure, FVector3f::Dist(Tip, Lure) * 1.15f, -300.0f);
+		}
+	}
+
+	/** Sways every rod tip a little, each on its own phase, the way idle characters would */
+	static void SwayRodTips(FFishingLineSolver& Solver, int32 NumLines, double Seconds)
+	{
+		for (int32 Line = 0; Line < NumLines; ++Line)
+		{
+			const float Sway = 30.0f * FMath::Sin(static_cast<float>(Seconds * 1.5 + Line * 0.37));
+			Solver.SetRodTip(Line, FVector3f(-100.0f + Sway, Line * 150.0f, 150.0f + Sway * 0.5f));
+		}
+	}
+
+	static float BenchmarkWaterHeight(float X, float Y)
+	{
+		return X > 0.0f ? 0.0f : FFishingLineSolver::NoWater;
+	}
+
+	/**
+	 * Times the fishing line solver at 60 Hz frames with the scalar reference path, the SIMD path and the SIMD
+	 * path across workers, and checks that the scalar and SIMD paths keep the bobbers in the same place.
+	 */
+	static void RunFishingLineBenchmark(const TArray<FString>& Args)
+	{
+		const int32 NumLines = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 256, 1);
+		const int32 NumFrames = FMath::Max(Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 600, 1);
+		constexpr float FrameSeconds = 1.0f / 60.0f;
+
+		struct FMode
+		{
+			const TCHAR* Name;
+			bool bUseSimd;
+			bool bParallel;
+		};
+		static const FMode Modes[] =
+		{
+			{ TEXT("Scalar"), false, false },
+			{ TEXT("Simd"), true, false },
+			{ TEXT("SimdParallel"), true, true },
+		};
+
+		FCsvWriter Csv(TEXT("FishingLines"), { TEXT("Mode"), TEXT("Lines"), TEXT("FrameUs"), TEXT("LineSubstepNs"), TEXT("BobbersInWater") });
+
+		for (const FMode& Mode : Modes)
+		{
+			FFishingLineSolver Solver;
+			CastBenchmarkLines(Solver, NumLines);
+
+			int32 NumSubsteps = 0;
+			const double FrameMs = TimeAverageMs(NumFrames, [&, Frame = 0]() mutable
+			{
+				SwayRodTips(Solver, NumLines, ++Frame * FrameSeconds);
+				NumSubsteps += Solver.Step(FrameSeconds, &BenchmarkWaterHeight, Mode.bUseSimd, Mode.bParallel);
+			});
+
+			int32 NumInWater = 0;
+			for (int32 Line = 0; Line < NumLines; ++Line)
+			{
+				NumInWater += Solver.IsBobberInWater(Line) ? 1 : 0;
+			}
+
+			const double LineSubstepNs = FrameMs * 1.0e6 * NumFrames / FMath::Max(static_cast<double>(NumSubsteps) * NumLines, 1.0);
+			Csv.AddRow(Mode.Name, NumLines, FrameMs * 1000.0, LineSubstepNs, NumInWater);
+
+			UE_LOG(LogNightFisherman, Display, TEXT("FishingLines %-12s %d lines: %.2f us per frame, %.2f ns per line substep, %d bobbers in water (%.1f KB)"),
+				Mode.Name, NumLines, FrameMs * 1000.0, LineSubstepNs, NumInWater, Solver.GetAllocatedSize() / 1024.0);
+		}
+
+		// Both paths run the same arithmetic in the same order, so they only drift apart by fused multiply-adds and rounding
+		FFishingLineSolver Scalar;
+		FFishingLineSolver Simd;
+		CastBenchmarkLines(Scalar, NumLines);
+		CastBenchmarkLines(Simd, NumLines);
+		for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+		{
+			SwayRodTips(Scalar, NumLines, Frame * FrameSeconds);
+			SwayRodTips(Simd, NumLines, Frame * FrameSeconds);
+			Scalar.Step(FrameSeconds, &BenchmarkWaterHeight, false, false);
+			Simd.Step(FrameSeconds, &BenchmarkWaterHeight, true, true);
+		}
+
+		float MaxError = 0.0f;
+		for (int32 Line = 0; Line < NumLines; ++Line)
+		{
+			MaxError = FMath::Max(MaxError, FVector3f::Dist(Scalar.GetBobber(Line), Simd.GetBobber(Line)));
+		}
+		UE_LOG(LogNightFisherman, Display, TEXT("FishingLines SIMD and scalar bobbers differ by up to %.4f cm after %d frames"), MaxError, NumFrames);
+		if (MaxError > 1.0f)
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("FishingLines SIMD path diverged from the scalar reference path"));
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommand FishingLineBenchmarkCommand(
+		TEXT("NF.Benchmark.FishingLines"),
+		TEXT("Times the fishing line solver scalar, SIMD and SIMD across workers and writes FishingLines.csv. Usage: NF.Benchmark.FishingLines [Lines=256] [Frames=600]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunFishingLineBenchmark));
+}
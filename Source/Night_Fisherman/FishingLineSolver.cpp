@@ -0,0 +1,418 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishingLineSolver.h"
+#include "Night_Fisherman.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fishing Line Step"), STAT_FishingLineStep, STATGROUP_NightFisherman);
+
+namespace FishingLineSolver
+{
+	/** cm/s^2 */
+	static constexpr float Gravity = 980.0f;
+
+	/** Velocity kept per substep in air */
+	static constexpr float Damping = 0.995f;
+
+	/** Velocity lost per substep on top of Damping by a particle fully under water */
+	static constexpr float WaterDrag = 0.08f;
+
+	/** Upward acceleration on a fully submerged bobber; twice gravity floats it half under */
+	static constexpr float BobberBuoyancy = 2.0f * Gravity;
+
+	/** Upward acceleration on submerged line, neutral so it drifts instead of dragging the bobber down */
+	static constexpr float LineBuoyancy = Gravity;
+
+	/** Depth in cm below the surface at which a particle counts as fully submerged */
+	static constexpr float BobberDepth = 4.0f;
+
+	/** Floor on squared segment lengths, keeping parked lines with coincident particles finite */
+	static constexpr float MinDistanceSquared = 1.0e-6f;
+
+	static constexpr int32 Last = FFishingLineSolver::NumParticles - 1;
+}
+
+void FFishingLineSolver::Initialize(int32 InCapacity)
+{
+	Capacity = Align(FMath::Max(InCapacity, 0), 4);
+	NumLines = 0;
+	Accumulator = 0.0f;
+
+	const int32 NumSlots = Capacity * NumParticles;
+	X.SetNumZeroed(NumSlots);
+	Y.SetNumZeroed(NumSlots);
+	Z.SetNumZeroed(NumSlots);
+	PrevX.SetNumZeroed(NumSlots);
+	PrevY.SetNumZeroed(NumSlots);
+	PrevZ.SetNumZeroed(NumSlots);
+
+	TipX.SetNumZeroed(Capacity);
+	TipY.SetNumZeroed(Capacity);
+	TipZ.SetNumZeroed(Capacity);
+	SegmentLength.SetNumZeroed(Capacity);
+	FloorZ.Init(NoWater, Capacity);
+	WaterZ.Init(NoWater, Capacity);
+	Active.SetNumZeroed(Capacity);
+
+	// Hand out low indices first so a few lines stay in the first chunk
+	FreeLines.Reset(Capacity);
+	for (int32 Line = Capacity - 1; Line >= 0; --Line)
+	{
+		FreeLines.Add(Line);
+	}
+}
+
+int32 FFishingLineSolver::AddLine(const FVector3f& Tip, const FVector3f& Bobber, float Length, float InFloorZ)
+{
+	if (FreeLines.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Line = FreeLines.Pop(EAllowShrinking::No);
+	++NumLines;
+
+	TipX[Line] = Tip.X;
+	TipY[Line] = Tip.Y;
+	TipZ[Line] = Tip.Z;
+	SegmentLength[Line] = FMath::Max(Length, 0.0f) / Last;
+	FloorZ[Line] = InFloorZ;
+	WaterZ[Line] = NoWater;
+	Active[Line] = 1.0f;
+
+	for (int32 Particle = 0; Particle < NumParticles; ++Particle)
+	{
+		const FVector3f Location = FMath::Lerp(Tip, Bobber, static_cast<float>(Particle) / Last);
+		const int32 Index = Particle * Capacity + Line;
+		X[Index] = PrevX[Index] = Location.X;
+		Y[Index] = PrevY[Index] = Location.Y;
+		Z[Index] = PrevZ[Index] = Location.Z;
+	}
+	return Line;
+}
+
+void FFishingLineSolver::RemoveLine(int32 Line)
+{
+	if (!IsActive(Line))
+	{
+		return;
+	}
+
+	// Park the line on a single point: with no length, no gravity and no water it never moves again
+	TipX[Line] = TipY[Line] = TipZ[Line] = 0.0f;
+	SegmentLength[Line] = 0.0f;
+	FloorZ[Line] = NoWater;
+	WaterZ[Line] = NoWater;
+	Active[Line] = 0.0f;
+	for (int32 Particle = 0; Particle < NumParticles; ++Particle)
+	{
+		const int32 Index = Particle * Capacity + Line;
+		X[Index] = Y[Index] = Z[Index] = 0.0f;
+		PrevX[Index] = PrevY[Index] = PrevZ[Index] = 0.0f;
+	}
+
+	FreeLines.Add(Line);
+	--NumLines;
+}
+
+void FFishingLineSolver::SetRodTip(int32 Line, const FVector3f& Tip)
+{
+	if (IsActive(Line))
+	{
+		TipX[Line] = Tip.X;
+		TipY[Line] = Tip.Y;
+		TipZ[Line] = Tip.Z;
+	}
+}
+
+void FFishingLineSolver::SetLength(int32 Line, float Length)
+{
+	if (IsActive(Line))
+	{
+		SegmentLength[Line] = FMath::Max(Length, 0.0f) / FishingLineSolver::Last;
+	}
+}
+
+float FFishingLineSolver::GetLength(int32 Line) const
+{
+	return SegmentLength[Line] * FishingLineSolver::Last;
+}
+
+int32 FFishingLineSolver::Step(float DeltaTime, TFunctionRef<float(float X, float Y)> WaterHeight, bool bUseSimd, bool bParallel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FishingLineStep);
+
+	Accumulator += FMath::Max(DeltaTime, 0.0f);
+	int32 NumSubsteps = FMath::FloorToInt32(Accumulator / SubstepSeconds);
+	if (NumSubsteps > MaxSubsteps)
+	{
+		NumSubsteps = MaxSubsteps;
+		Accumulator = 0.0f;
+	}
+	else
+	{
+		Accumulator -= NumSubsteps * SubstepSeconds;
+	}
+
+	if (NumSubsteps == 0 || NumLines == 0)
+	{
+		return NumSubsteps;
+	}
+
+	// The query may touch game state, so it stays on this thread and is sampled once for the whole step
+	const int32 BobberRow = FishingLineSolver::Last * Capacity;
+	for (int32 Line = 0; Line < Capacity; ++Line)
+	{
+		if (Active[Line] != 0.0f)
+		{
+			WaterZ[Line] = WaterHeight(X[BobberRow + Line], Y[BobberRow + Line]);
+		}
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Capacity, ChunkSize);
+	ParallelFor(NumChunks, [this, NumSubsteps, bUseSimd](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, Capacity);
+		if (bUseSimd)
+		{
+			StepRangeSimd(Begin, End, NumSubsteps);
+		}
+		else
+		{
+			StepRangeScalar(Begin, End, NumSubsteps);
+		}
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	return NumSubsteps;
+}
+
+FVector3f FFishingLineSolver::GetParticle(int32 Line, int32 Particle) const
+{
+	const int32 Index = Particle * Capacity + Line;
+	return FVector3f(X[Index], Y[Index], Z[Index]);
+}
+
+bool FFishingLineSolver::IsBobberInWater(int32 Line) const
+{
+	return IsActive(Line) && Z[FishingLineSolver::Last * Capacity + Line] < WaterZ[Line];
+}
+
+SIZE_T FFishingLineSolver::GetAllocatedSize() const
+{
+	return X.GetAllocatedSize() + Y.GetAllocatedSize() + Z.GetAllocatedSize()
+		+ PrevX.GetAllocatedSize() + PrevY.GetAllocatedSize() + PrevZ.GetAllocatedSize()
+		+ TipX.GetAllocatedSize() + TipY.GetAllocatedSize() + TipZ.GetAllocatedSize()
+		+ SegmentLength.GetAllocatedSize() + FloorZ.GetAllocatedSize() + WaterZ.GetAllocatedSize() + Active.GetAllocatedSize()
+		+ FreeLines.GetAllocatedSize();
+}
+
+void FFishingLineSolver::StepRangeSimd(int32 Begin, int32 End, int32 NumSubsteps)
+{
+	using namespace FishingLineSolver;
+
+	float* RESTRICT XData = X.GetData();
+	float* RESTRICT YData = Y.GetData();
+	float* RESTRICT ZData = Z.GetData();
+	float* RESTRICT PrevXData = PrevX.GetData();
+	float* RESTRICT PrevYData = PrevY.GetData();
+	float* RESTRICT PrevZData = PrevZ.GetData();
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float MinDistSq = VectorSetFloat1(MinDistanceSquared);
+	const VectorRegister4Float DampingV = VectorSetFloat1(Damping);
+	const VectorRegister4Float WaterDragV = VectorSetFloat1(WaterDrag);
+	const VectorRegister4Float InvDepth = VectorSetFloat1(1.0f / BobberDepth);
+	const VectorRegister4Float GravityStep = VectorSetFloat1(Gravity * SubstepSeconds * SubstepSeconds);
+	const VectorRegister4Float BobberBuoyancyStep = VectorSetFloat1(BobberBuoyancy * SubstepSeconds * SubstepSeconds);
+	const VectorRegister4Float LineBuoyancyStep = VectorSetFloat1(LineBuoyancy * SubstepSeconds * SubstepSeconds);
+
+	for (int32 Line = Begin; Line < End; Line += 4)
+	{
+		const VectorRegister4Float LineActive = VectorLoad(&Active[Line]);
+		const VectorRegister4Float LineWater = VectorLoad(&WaterZ[Line]);
+		const VectorRegister4Float LineFloor = VectorLoad(&FloorZ[Line]);
+		const VectorRegister4Float LineLength = VectorLoad(&SegmentLength[Line]);
+		const VectorRegister4Float LineTipX = VectorLoad(&TipX[Line]);
+		const VectorRegister4Float LineTipY = VectorLoad(&TipY[Line]);
+		const VectorRegister4Float LineTipZ = VectorLoad(&TipZ[Line]);
+
+		for (int32 Substep = 0; Substep < NumSubsteps; ++Substep)
+		{
+			// Slide the pinned tip towards its target, arriving on the last substep
+			const VectorRegister4Float TipAlpha = VectorSetFloat1(1.0f / (NumSubsteps - Substep));
+			{
+				const VectorRegister4Float TipX0 = VectorLoad(&XData[Line]);
+				const VectorRegister4Float TipY0 = VectorLoad(&YData[Line]);
+				const VectorRegister4Float TipZ0 = VectorLoad(&ZData[Line]);
+				VectorStore(TipX0, &PrevXData[Line]);
+				VectorStore(TipY0, &PrevYData[Line]);
+				VectorStore(TipZ0, &PrevZData[Line]);
+				VectorStore(VectorMultiplyAdd(VectorSubtract(LineTipX, TipX0), TipAlpha, TipX0), &XData[Line]);
+				VectorStore(VectorMultiplyAdd(VectorSubtract(LineTipY, TipY0), TipAlpha, TipY0), &YData[Line]);
+				VectorStore(VectorMultiplyAdd(VectorSubtract(LineTipZ, TipZ0), TipAlpha, TipZ0), &ZData[Line]);
+			}
+
+			// Verlet integration with water drag and buoyancy
+			for (int32 Particle = 1; Particle < NumParticles; ++Particle)
+			{
+				const int32 Index = Particle * Capacity + Line;
+				const VectorRegister4Float PX = VectorLoad(&XData[Index]);
+				const VectorRegister4Float PY = VectorLoad(&YData[Index]);
+				const VectorRegister4Float PZ = VectorLoad(&ZData[Index]);
+
+				const VectorRegister4Float Submerged = VectorMin(VectorMax(VectorMultiply(VectorSubtract(LineWater, PZ), InvDepth), Zero), One);
+				const VectorRegister4Float Keep = VectorMultiply(VectorNegateMultiplyAdd(WaterDragV, Submerged, DampingV), LineActive);
+				const VectorRegister4Float Lift = VectorMultiply(Particle == Last ? BobberBuoyancyStep : LineBuoyancyStep, Submerged);
+				const VectorRegister4Float Fall = VectorMultiply(VectorSubtract(Lift, GravityStep), LineActive);
+
+				const VectorRegister4Float VelX = VectorMultiply(VectorSubtract(PX, VectorLoad(&PrevXData[Index])), Keep);
+				const VectorRegister4Float VelY = VectorMultiply(VectorSubtract(PY, VectorLoad(&PrevYData[Index])), Keep);
+				const VectorRegister4Float VelZ = VectorMultiplyAdd(VectorSubtract(PZ, VectorLoad(&PrevZData[Index])), Keep, Fall);
+
+				VectorStore(PX, &PrevXData[Index]);
+				VectorStore(PY, &PrevYData[Index]);
+				VectorStore(PZ, &PrevZData[Index]);
+				VectorStore(VectorAdd(PX, VelX), &XData[Index]);
+				VectorStore(VectorAdd(PY, VelY), &YData[Index]);
+				VectorStore(VectorAdd(PZ, VelZ), &ZData[Index]);
+			}
+
+			// Pull-only distance constraints from the tip down; the first segment only moves its lower end
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 Particle = 0; Particle < Last; ++Particle)
+				{
+					const int32 IndexA = Particle * Capacity + Line;
+					const int32 IndexB = IndexA + Capacity;
+					const VectorRegister4Float AX = VectorLoad(&XData[IndexA]);
+					const VectorRegister4Float AY = VectorLoad(&YData[IndexA]);
+					const VectorRegister4Float AZ = VectorLoad(&ZData[IndexA]);
+					const VectorRegister4Float BX = VectorLoad(&XData[IndexB]);
+					const VectorRegister4Float BY = VectorLoad(&YData[IndexB]);
+					const VectorRegister4Float BZ = VectorLoad(&ZData[IndexB]);
+
+					const VectorRegister4Float DX = VectorSubtract(BX, AX);
+					const VectorRegister4Float DY = VectorSubtract(BY, AY);
+					const VectorRegister4Float DZ = VectorSubtract(BZ, AZ);
+					const VectorRegister4Float DistanceSquared = VectorMax(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ))), MinDistSq);
+					const VectorRegister4Float InvDistance = VectorReciprocalSqrt(DistanceSquared);
+					const VectorRegister4Float Stretch = VectorMax(VectorSubtract(VectorMultiply(DistanceSquared, InvDistance), LineLength), Zero);
+					const VectorRegister4Float Scale = VectorMultiply(Stretch, InvDistance);
+
+					if (Particle == 0)
+					{
+						VectorStore(VectorNegateMultiplyAdd(DX, Scale, BX), &XData[IndexB]);
+						VectorStore(VectorNegateMultiplyAdd(DY, Scale, BY), &YData[IndexB]);
+						VectorStore(VectorNegateMultiplyAdd(DZ, Scale, BZ), &ZData[IndexB]);
+					}
+					else
+					{
+						const VectorRegister4Float HalfScale = VectorMultiply(Scale, Half);
+						VectorStore(VectorMultiplyAdd(DX, HalfScale, AX), &XData[IndexA]);
+						VectorStore(VectorMultiplyAdd(DY, HalfScale, AY), &YData[IndexA]);
+						VectorStore(VectorMultiplyAdd(DZ, HalfScale, AZ), &ZData[IndexA]);
+						VectorStore(VectorNegateMultiplyAdd(DX, HalfScale, BX), &XData[IndexB]);
+						VectorStore(VectorNegateMultiplyAdd(DY, HalfScale, BY), &YData[IndexB]);
+						VectorStore(VectorNegateMultiplyAdd(DZ, HalfScale, BZ), &ZData[IndexB]);
+					}
+				}
+			}
+
+			// Nothing sinks through the lake bed or the ground
+			for (int32 Particle = 1; Particle < NumParticles; ++Particle)
+			{
+				const int32 Index = Particle * Capacity + Line;
+				VectorStore(VectorMax(VectorLoad(&ZData[Index]), LineFloor), &ZData[Index]);
+			}
+		}
+	}
+}
+
+void FFishingLineSolver::StepRangeScalar(int32 Begin, int32 End, int32 NumSubsteps)
+{
+	using namespace FishingLineSolver;
+
+	float* RESTRICT XData = X.GetData();
+	float* RESTRICT YData = Y.GetData();
+	float* RESTRICT ZData = Z.GetData();
+	float* RESTRICT PrevXData = PrevX.GetData();
+	float* RESTRICT PrevYData = PrevY.GetData();
+	float* RESTRICT PrevZData = PrevZ.GetData();
+
+	constexpr float GravityStep = Gravity * SubstepSeconds * SubstepSeconds;
+	constexpr float BobberBuoyancyStep = BobberBuoyancy * SubstepSeconds * SubstepSeconds;
+	constexpr float LineBuoyancyStep = LineBuoyancy * SubstepSeconds * SubstepSeconds;
+
+	for (int32 Line = Begin; Line < End; ++Line)
+	{
+		const float LineActive = Active[Line];
+		const float LineWater = WaterZ[Line];
+		const float LineFloor = FloorZ[Line];
+		const float LineLength = SegmentLength[Line];
+
+		for (int32 Substep = 0; Substep < NumSubsteps; ++Substep)
+		{
+			const float TipAlpha = 1.0f / (NumSubsteps - Substep);
+			PrevXData[Line] = XData[Line];
+			PrevYData[Line] = YData[Line];
+			PrevZData[Line] = ZData[Line];
+			XData[Line] += (TipX[Line] - XData[Line]) * TipAlpha;
+			YData[Line] += (TipY[Line] - YData[Line]) * TipAlpha;
+			ZData[Line] += (TipZ[Line] - ZData[Line]) * TipAlpha;
+
+			for (int32 Particle = 1; Particle < NumParticles; ++Particle)
+			{
+				const int32 Index = Particle * Capacity + Line;
+				const float PX = XData[Index];
+				const float PY = YData[Index];
+				const float PZ = ZData[Index];
+
+				const float Submerged = FMath::Clamp((LineWater - PZ) * (1.0f / BobberDepth), 0.0f, 1.0f);
+				const float Keep = (Damping - WaterDrag * Submerged) * LineActive;
+				const float Lift = (Particle == Last ? BobberBuoyancyStep : LineBuoyancyStep) * Submerged;
+				const float Fall = (Lift - GravityStep) * LineActive;
+
+				XData[Index] = PX + (PX - PrevXData[Index]) * Keep;
+				YData[Index] = PY + (PY - PrevYData[Index]) * Keep;
+				ZData[Index] = PZ + ((PZ - PrevZData[Index]) * Keep + Fall);
+				PrevXData[Index] = PX;
+				PrevYData[Index] = PY;
+				PrevZData[Index] = PZ;
+			}
+
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 Particle = 0; Particle < Last; ++Particle)
+				{
+					const int32 IndexA = Particle * Capacity + Line;
+					const int32 IndexB = IndexA + Capacity;
+					const float DX = XData[IndexB] - XData[IndexA];
+					const float DY = YData[IndexB] - YData[IndexA];
+					const float DZ = ZData[IndexB] - ZData[IndexA];
+					const float DistanceSquared = FMath::Max(DX * DX + (DY * DY + DZ * DZ), MinDistanceSquared);
+					const float InvDistance = 1.0f / FMath::Sqrt(DistanceSquared);
+					const float Scale = FMath::Max(DistanceSquared * InvDistance - LineLength, 0.0f) * InvDistance;
+
+					const float ScaleB = Particle == 0 ? Scale : Scale * 0.5f;
+					const float ScaleA = Particle == 0 ? 0.0f : Scale * 0.5f;
+					XData[IndexA] += DX * ScaleA;
+					YData[IndexA] += DY * ScaleA;
+					ZData[IndexA] += DZ * ScaleA;
+					XData[IndexB] -= DX * ScaleB;
+					YData[IndexB] -= DY * ScaleB;
+					ZData[IndexB] -= DZ * ScaleB;
+				}
+			}
+
+			for (int32 Particle = 1; Particle < NumParticles; ++Particle)
+			{
+				const int32 Index = Particle * Capacity + Line;
+				ZData[Index] = FMath::Max(ZData[Index], LineFloor);
+			}
+		}
+	}
+}
@@ -0,0 +1,98 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Verlet rope solver for fishing lines: each line is a chain of NumParticles particles from the rod tip,
+ * which is pinned, to the bobber, which floats on whatever water the height query reports under it.
+ *
+ * Lines are stepped at a fixed substep whatever the frame rate, so they behave the same at 30 and 144 Hz.
+ * Particles are stored particle-major, line-minor (one array per coordinate, Particle * Capacity + Line),
+ * so the SIMD kernel moves four lines per instruction with plain loads, and lines are split into fixed-size
+ * chunks run with ParallelFor. Distance constraints only pull, letting a line go slack in the water.
+ */
+class NIGHT_FISHERMAN_API FFishingLineSolver
+{
+public:
+	/** Particles per line, rod tip and bobber included */
+	static constexpr int32 NumParticles = 16;
+
+	/** Fixed simulation step in seconds */
+	static constexpr float SubstepSeconds = 1.0f / 120.0f;
+
+	/** Most substeps one Step runs; time beyond that is dropped so hitches do not snowball */
+	static constexpr int32 MaxSubsteps = 8;
+
+	/** Constraint passes per substep */
+	static constexpr int32 NumIterations = 4;
+
+	/** Lines per ParallelFor work item, a multiple of the SIMD width */
+	static constexpr int32 ChunkSize = 64;
+
+	/** Returned by a water height query where there is no water */
+	static constexpr float NoWater = -UE_BIG_NUMBER;
+
+	/** Removes every line and sizes the solver for up to Capacity of them */
+	void Initialize(int32 Capacity);
+
+	/** Lays a line out straight from Tip to Bobber. Returns the line index, or INDEX_NONE when full. */
+	int32 AddLine(const FVector3f& Tip, const FVector3f& Bobber, float Length, float FloorZ);
+	void RemoveLine(int32 Line);
+
+	/** Moves the pinned end of a line; the tip slides there over the substeps of the next Step */
+	void SetRodTip(int32 Line, const FVector3f& Tip);
+
+	void SetLength(int32 Line, float Length);
+	float GetLength(int32 Line) const;
+
+	/**
+	 * Advances every line by DeltaTime in fixed substeps and returns how many were run. WaterHeight is asked
+	 * once per line per call, on the calling thread, for the surface under the bobber. bUseSimd = false runs
+	 * the scalar reference path.
+	 */
+	int32 Step(float DeltaTime, TFunctionRef<float(float X, float Y)> WaterHeight, bool bUseSimd = true, bool bParallel = true);
+
+	FVector3f GetParticle(int32 Line, int32 Particle) const;
+	FVector3f GetBobber(int32 Line) const { return GetParticle(Line, NumParticles - 1); }
+
+	/** True if the bobber was at least partly under water after the last Step */
+	bool IsBobberInWater(int32 Line) const;
+
+	bool IsActive(int32 Line) const { return Active.IsValidIndex(Line) && Active[Line] != 0.0f; }
+
+	int32 Num() const { return NumLines; }
+	int32 GetCapacity() const { return Capacity; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Runs NumSubsteps over lines [Begin, End), Begin and End multiples of four */
+	void StepRangeSimd(int32 Begin, int32 End, int32 NumSubsteps);
+	void StepRangeScalar(int32 Begin, int32 End, int32 NumSubsteps);
+
+	int32 Capacity = 0;
+	int32 NumLines = 0;
+	float Accumulator = 0.0f;
+
+	// Particles, Particle * Capacity + Line
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	TArray<float> PrevX;
+	TArray<float> PrevY;
+	TArray<float> PrevZ;
+
+	// Lines
+	TArray<float> TipX;
+	TArray<float> TipY;
+	TArray<float> TipZ;
+	TArray<float> SegmentLength;
+	TArray<float> FloorZ;
+	TArray<float> WaterZ;
+	/** 1 for lines in use, 0 for free ones, which are parked and never move */
+	TArray<float> Active;
+
+	TArray<int32> FreeLines;
+};
@@ -0,0 +1,190 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FishingLineSubsystem.h"
+#include "FishPopulationSubsystem.h"
+#include "Night_Fisherman.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Simulated Fishing Lines"), STAT_SimulatedFishingLines, STATGROUP_NightFisherman);
+
+static TAutoConsoleVariable<int32> CVarFishingLineCapacity(
+	TEXT("NF.Fish.LineCapacity"),
+	256,
+	TEXT("Fishing lines simulated per world; casting beyond this is refused. Read when the world starts."));
+
+static TAutoConsoleVariable<bool> CVarFishingLineSimd(
+	TEXT("NF.Fish.LineSimd"),
+	true,
+	TEXT("Step fishing lines four at a time with SIMD instead of the scalar reference path."));
+
+static TAutoConsoleVariable<bool> CVarFishingLineParallel(
+	TEXT("NF.Fish.LineParallel"),
+	true,
+	TEXT("Step fishing lines across task graph workers."));
+
+static TAutoConsoleVariable<bool> CVarFishingLineDraw(
+	TEXT("NF.Fish.DrawLines"),
+	false,
+	TEXT("Draw every simulated fishing line as debug lines."));
+
+namespace FishingLineSubsystem
+{
+	/** Line paid out beyond the straight distance to the lure, as a fraction of it */
+	static constexpr float CastSlack = 0.15f;
+
+	/** Line wound in per second while reeling, in cm */
+	static constexpr float ReelSpeed = 600.0f;
+
+	/** Length at which a reeled line is gone */
+	static constexpr float MinLength = 10.0f;
+
+	/** How far below the lure to look for the ground or lake bed */
+	static constexpr float FloorTraceDepth = 5000.0f;
+}
+
+bool UFishingLineSubsystem::CastLine(const AActor* Caster, const FVector& RodTipOffset, const FVector& Lure)
+{
+	using namespace FishingLineSubsystem;
+
+	if (!Caster)
+	{
+		return false;
+	}
+	RemoveLine(Caster);
+
+	const FVector Tip = Caster->GetActorTransform().TransformPosition(RodTipOffset);
+
+	FHitResult Hit;
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(FishingLineFloor), false, Caster);
+	const float FloorZ = GetWorld()->LineTraceSingleByChannel(Hit, Lure, Lure - FVector(0.0, 0.0, FloorTraceDepth), ECC_Visibility, Params)
+		? static_cast<float>(Hit.ImpactPoint.Z)
+		: static_cast<float>(Lure.Z - FloorTraceDepth);
+
+	const float Length = static_cast<float>(FVector::Dist(Tip, Lure)) * (1.0f + CastSlack);
+	const int32 Line = Solver.AddLine(FVector3f(Tip), FVector3f(Lure), Length, FloorZ);
+	if (Line == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Owners[Line] = { Caster, RodTipOffset, false };
+	CasterLines.Add(Caster, Line);
+	return true;
+}
+
+void UFishingLineSubsystem::ReelIn(const AActor* Caster)
+{
+	const int32 Line = FindLine(Caster);
+	if (Line != INDEX_NONE)
+	{
+		Owners[Line].bReeling = true;
+	}
+}
+
+void UFishingLineSubsystem::RemoveLine(const AActor* Caster)
+{
+	const int32 Line = FindLine(Caster);
+	if (Line != INDEX_NONE)
+	{
+		Solver.RemoveLine(Line);
+		CasterLines.Remove(Owners[Line].Caster);
+		Owners[Line] = FLineOwner();
+	}
+}
+
+bool UFishingLineSubsystem::HasLine(const AActor* Caster) const
+{
+	return FindLine(Caster) != INDEX_NONE;
+}
+
+void UFishingLineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FishPopulation = Collection.InitializeDependency<UFishPopulationSubsystem>();
+
+	Solver.Initialize(FMath::Max(CVarFishingLineCapacity.GetValueOnGameThread(), 0));
+	Owners.SetNum(Solver.GetCapacity());
+	CasterLines.Reset();
+}
+
+bool UFishingLineSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UFishingLineSubsystem::Tick(float DeltaTime)
+{
+	using namespace FishingLineSubsystem;
+
+	Super::Tick(DeltaTime);
+
+	// Follow the casters' rods and wind in the lines being reeled; lines whose caster went away are dropped
+	for (int32 Line = 0; Line < Owners.Num(); ++Line)
+	{
+		if (!Solver.IsActive(Line))
+		{
+			continue;
+		}
+
+		FLineOwner& Owner = Owners[Line];
+		const AActor* Caster = Owner.Caster.Get();
+		const float Length = Owner.bReeling ? Solver.GetLength(Line) - ReelSpeed * DeltaTime : Solver.GetLength(Line);
+		if (!Caster || Length <= MinLength)
+		{
+			Solver.RemoveLine(Line);
+			CasterLines.Remove(Owner.Caster);
+			Owner = FLineOwner();
+			continue;
+		}
+
+		Solver.SetRodTip(Line, FVector3f(Caster->GetActorTransform().TransformPosition(Owner.RodTipOffset)));
+		Solver.SetLength(Line, Length);
+	}
+
+	const FFishPopulation* Population = FishPopulation ? &FishPopulation->GetPopulation() : nullptr;
+	Solver.Step(DeltaTime, [Population](float X, float Y)
+	{
+		float Height;
+		return Population && Population->GetWaterHeight(X, Y, Height) ? Height : FFishingLineSolver::NoWater;
+	}, CVarFishingLineSimd.GetValueOnGameThread(), CVarFishingLineParallel.GetValueOnGameThread());
+
+	if (CVarFishingLineDraw.GetValueOnGameThread())
+	{
+		DrawLines();
+	}
+
+	SET_DWORD_STAT(STAT_SimulatedFishingLines, Solver.Num());
+}
+
+TStatId UFishingLineSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFishingLineSubsystem, STATGROUP_Tickables);
+}
+
+int32 UFishingLineSubsystem::FindLine(const AActor* Caster) const
+{
+	const int32* Line = Caster ? CasterLines.Find(Caster) : nullptr;
+	return Line ? *Line : INDEX_NONE;
+}
+
+void UFishingLineSubsystem::DrawLines() const
+{
+	UWorld* World = GetWorld();
+	for (int32 Line = 0; Line < Solver.GetCapacity(); ++Line)
+	{
+		if (!Solver.IsActive(Line))
+		{
+			continue;
+		}
+
+		for (int32 Particle = 1; Particle < FFishingLineSolver::NumParticles; ++Particle)
+		{
+			DrawDebugLine(World, FVector(Solver.GetParticle(Line, Particle - 1)), FVector(Solver.GetParticle(Line, Particle)), FColor::White);
+		}
+		DrawDebugPoint(World, FVector(Solver.GetBobber(Line)), 8.0f, Solver.IsBobberInWater(Line) ? FColor::Red : FColor::Orange);
+	}
+}
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "FishingLineSolver.h"
+#include "FishingLineSubsystem.generated.h"
+
+class UFishPopulationSubsystem;
+
+/**
+ * Simulates the world's cast fishing lines in one FFishingLineSolver. Each line hangs from a point fixed
+ * relative to the actor that cast it and its bobber floats on the lakes of UFishPopulationSubsystem.
+ * Reeling in shortens a line until it is gone.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UFishingLineSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Casts a line from RodTipOffset, in Caster's local space, to Lure, replacing any line Caster already has. Returns false when full. */
+	bool CastLine(const AActor* Caster, const FVector& RodTipOffset, const FVector& Lure);
+
+	/** Starts winding Caster's line in; it is removed once fully reeled */
+	void ReelIn(const AActor* Caster);
+
+	/** Removes Caster's line at once */
+	void RemoveLine(const AActor* Caster);
+
+	bool HasLine(const AActor* Caster) const;
+
+	const FFishingLineSolver& GetSolver() const { return Solver; }
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FLineOwner
+	{
+		TWeakObjectPtr<const AActor> Caster;
+		FVector RodTipOffset = FVector::ZeroVector;
+		bool bReeling = false;
+	};
+
+	int32 FindLine(const AActor* Caster) const;
+
+	void DrawLines() const;
+
+	FFishingLineSolver Solver;
+
+	/** Indexed like the solver's lines; only entries of active lines are meaningful */
+	TArray<FLineOwner> Owners;
+
+	/** Line of each caster with one active, so lookups by caster do not scan every line */
+	TMap<TWeakObjectPtr<const AActor>, int32> CasterLines;
+
+	UPROPERTY()
+	TObjectPtr<UFishPopulationSubsystem> FishPopulation;
+};
@@ -0,0 +1,207 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "GameplayEventTrace.h"
+
+#if NF_GAMEPLAY_EVENT_TRACE
+
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectArray.h"
+#include <atomic>
+
+namespace GameplayEventTrace
+{
+	/** One thread's ring of events. Only the owning thread writes Events and Head. */
+	struct FThreadBuffer
+	{
+		FEvent Events[ThreadCapacity];
+
+		/** Events ever recorded; the next one goes into slot Head % ThreadCapacity */
+		std::atomic<uint64> Head{ 0 };
+
+		/** Head NF.Events.Stream has logged up to, only touched by the game thread */
+		uint64 StreamedHead = 0;
+	};
+
+	/** Every thread's buffer. Buffers are never freed, so a thread's events can still be dumped after it exits. */
+	static TArray<FThreadBuffer*> Buffers;
+	static FCriticalSection BuffersLock;
+
+	static thread_local FThreadBuffer* ThreadBuffer = nullptr;
+
+	static FTSTicker::FDelegateHandle StreamHandle;
+
+	static FThreadBuffer& CreateThreadBuffer()
+	{
+		ThreadBuffer = new FThreadBuffer();
+
+		FScopeLock ScopeLock(&BuffersLock);
+		Buffers.Add(ThreadBuffer);
+		return *ThreadBuffer;
+	}
+
+	/**
+	 * Appends the events Buffer recorded from event From on, as far as the ring still holds them, and returns
+	 * where they end. Its thread keeps recording meanwhile, so events it overwrote during the copy are dropped.
+	 */
+	static uint64 ReadSince(const FThreadBuffer& Buffer, uint64 From, TArray<FEvent>& OutEvents)
+	{
+		const uint64 End = Buffer.Head.load(std::memory_order_acquire);
+		const uint64 Begin = FMath::Max(From, End > ThreadCapacity ? End - ThreadCapacity : 0);
+
+		const int32 FirstOut = OutEvents.Num();
+		for (uint64 Index = Begin; Index < End; ++Index)
+		{
+			OutEvents.Add(Buffer.Events[Index % ThreadCapacity]);
+		}
+
+		// Recording event N reuses the slot of event N - ThreadCapacity, possibly while it was being copied
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64 After = Buffer.Head.load(std::memory_order_relaxed);
+		const uint64 FirstIntact = After >= ThreadCapacity ? After - ThreadCapacity + 1 : 0;
+		if (Begin < FirstIntact)
+		{
+			OutEvents.RemoveAt(FirstOut, static_cast<int32>(FMath::Min(FirstIntact, End) - Begin), EAllowShrinking::No);
+		}
+		return End;
+	}
+
+	static void SortByTime(TArray<FEvent>& Events)
+	{
+		Events.StableSort([](const FEvent& A, const FEvent& B) { return A.Cycles < B.Cycles; });
+	}
+
+	void Record(EGameplayEventType Type, const UObject* Object, uint16 Arg)
+	{
+		FThreadBuffer& Buffer = ThreadBuffer ? *ThreadBuffer : CreateThreadBuffer();
+
+		const uint64 Head = Buffer.Head.load(std::memory_order_relaxed);
+		FEvent& Event = Buffer.Events[Head % ThreadCapacity];
+		Event.Cycles = FPlatformTime::Cycles64();
+		Event.ObjectId = Object ? Object->GetUniqueID() : 0;
+		Event.Arg = Arg;
+		Event.Type = Type;
+		Buffer.Head.store(Head + 1, std::memory_order_release);
+	}
+
+	void GetLatest(int32 MaxEvents, TArray<FEvent>& OutEvents)
+	{
+		TArray<FEvent> Events;
+		{
+			FScopeLock ScopeLock(&BuffersLock);
+			for (const FThreadBuffer* Buffer : Buffers)
+			{
+				ReadSince(*Buffer, 0, Events);
+			}
+		}
+
+		SortByTime(Events);
+		const int32 First = FMath::Max(Events.Num() - MaxEvents, 0);
+		OutEvents.Append(Events.GetData() + First, Events.Num() - First);
+	}
+
+	FString ToString(const FEvent& Event)
+	{
+		// Object slots are reused, so an object destroyed since the event may show under its successor's name
+		FString ObjectName = TEXT("None");
+		if (const FUObjectItem* Item = Event.ObjectId != 0 ? GUObjectArray.IndexToObject(static_cast<int32>(Event.ObjectId)) : nullptr)
+		{
+			if (const UObject* Object = static_cast<const UObject*>(Item->GetObject()))
+			{
+				ObjectName = Object->GetName();
+			}
+		}
+
+		FString Description;
+		switch (Event.Type)
+		{
+		case EGameplayEventType::InputAction:
+			Description = FString::Printf(TEXT("InputAction %s"), *StaticEnum<ETopDownInputAction>()->GetNameStringByValue(Event.Arg));
+			break;
+		default:
+			Description = FString::Printf(TEXT("Event %d (%d)"), static_cast<int32>(Event.Type), Event.Arg);
+			break;
+		}
+
+		return FString::Printf(TEXT("%.4f s  %s  %s"), FPlatformTime::ToSeconds64(Event.Cycles), *Description, *ObjectName);
+	}
+
+	/** Logs the events recorded since the previous call */
+	static bool StreamEvents(float DeltaTime)
+	{
+		TArray<FEvent> Events;
+		uint64 NumDropped = 0;
+		{
+			FScopeLock ScopeLock(&BuffersLock);
+			for (FThreadBuffer* Buffer : Buffers)
+			{
+				const int32 FirstOut = Events.Num();
+				const uint64 From = Buffer->StreamedHead;
+				Buffer->StreamedHead = ReadSince(*Buffer, From, Events);
+				NumDropped += Buffer->StreamedHead - From - (Events.Num() - FirstOut);
+			}
+		}
+
+		if (NumDropped > 0)
+		{
+			UE_LOG(LogNightFisherman, Display, TEXT("Gameplay events: %llu overwritten before they were streamed"), NumDropped);
+		}
+
+		SortByTime(Events);
+		for (const FEvent& Event : Events)
+		{
+			UE_LOG(LogNightFisherman, Display, TEXT("Gameplay event %s"), *ToString(Event));
+		}
+		return true;
+	}
+
+	static FAutoConsoleCommandWithArgs DumpCommand(
+		TEXT("NF.Events.Dump"),
+		TEXT("Logs the latest gameplay events of every thread, oldest first. Usage: NF.Events.Dump [Num=64]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const int32 MaxEvents = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 64;
+
+			TArray<FEvent> Events;
+			GetLatest(MaxEvents, Events);
+			UE_LOG(LogNightFisherman, Display, TEXT("Last %d gameplay events:"), Events.Num());
+			for (const FEvent& Event : Events)
+			{
+				UE_LOG(LogNightFisherman, Display, TEXT("  %s"), *ToString(Event));
+			}
+		}));
+
+	static FAutoConsoleCommandWithArgs StreamCommand(
+		TEXT("NF.Events.Stream"),
+		TEXT("Logs gameplay events as they are recorded, once per frame. Usage: NF.Events.Stream [1|0], toggles without an argument"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			const bool bStreaming = StreamHandle.IsValid();
+			const bool bStream = Args.IsValidIndex(0) ? FCString::ToBool(*Args[0]) : !bStreaming;
+			if (bStream == bStreaming)
+			{
+				return;
+			}
+
+			if (bStream)
+			{
+				// Only stream what happens from now on
+				FScopeLock ScopeLock(&BuffersLock);
+				for (FThreadBuffer* Buffer : Buffers)
+				{
+					Buffer->StreamedHead = Buffer->Head.load(std::memory_order_acquire);
+				}
+				StreamHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&StreamEvents));
+			}
+			else
+			{
+				FTSTicker::RemoveTicker(StreamHandle);
+				StreamHandle.Reset();
+			}
+		}));
+}
+
+#endif
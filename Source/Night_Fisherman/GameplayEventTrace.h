@@ -0,0 +1,60 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Gameplay event tracing is compiled out of Shipping builds; define to 0 or 1 to override */
+#ifndef NF_GAMEPLAY_EVENT_TRACE
+#define NF_GAMEPLAY_EVENT_TRACE !UE_BUILD_SHIPPING
+#endif
+
+/** What a traced gameplay event records */
+enum class EGameplayEventType : uint8
+{
+	/** A character handled an input action; Arg is the ETopDownInputAction */
+	InputAction,
+	Count
+};
+
+#if NF_GAMEPLAY_EVENT_TRACE
+
+/**
+ * Compact binary trace of gameplay events for debugging hot paths where logging would cost too much.
+ *
+ * Each thread records into its own fixed ring of 16-byte events, allocated on the thread's first event,
+ * so recording takes no lock and never allocates after that: a timestamp, a slot write and a release
+ * store of the thread's head. Old events are overwritten once a ring is full. NF.Events.Dump logs the
+ * latest events of every thread in time order; NF.Events.Stream logs new events as they arrive.
+ */
+namespace GameplayEventTrace
+{
+	struct FEvent
+	{
+		uint64 Cycles;
+		/** GetUniqueID of the object the event is about, 0 for none */
+		uint32 ObjectId;
+		uint16 Arg;
+		EGameplayEventType Type;
+	};
+	static_assert(sizeof(FEvent) == 16, "Gameplay events should stay compact");
+
+	/** Events each thread keeps */
+	static constexpr uint32 ThreadCapacity = 4096;
+
+	NIGHT_FISHERMAN_API void Record(EGameplayEventType Type, const UObject* Object, uint16 Arg);
+
+	/** Appends up to MaxEvents of the latest events of every thread to OutEvents, oldest first */
+	NIGHT_FISHERMAN_API void GetLatest(int32 MaxEvents, TArray<FEvent>& OutEvents);
+
+	/** Readable one-line description of Event */
+	NIGHT_FISHERMAN_API FString ToString(const FEvent& Event);
+}
+
+#define NF_GAMEPLAY_EVENT(Type, Object, Arg) GameplayEventTrace::Record(EGameplayEventType::Type, Object, static_cast<uint16>(Arg))
+
+#else
+
+#define NF_GAMEPLAY_EVENT(Type, Object, Arg)
+
+#endif
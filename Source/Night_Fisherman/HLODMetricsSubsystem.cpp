@@ -0,0 +1,247 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HLODMetricsSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "WorldPartition/HLOD/HLODActor.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HLOD Actors Shown"), STAT_HLODActorsShown, STATGROUP_NightFisherman);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HLOD Primitives Rendered"), STAT_HLODPrimitivesRendered, STATGROUP_NightFisherman);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HLOD Source Primitives Rendered"), STAT_HLODSourcePrimitivesRendered, STATGROUP_NightFisherman);
+
+/** Whether an HLOD actor is currently standing in for its cell, however the HLOD runtime chose to hide it */
+static bool IsHLODShown(const AActor& Actor)
+{
+	if (Actor.IsHidden())
+	{
+		return false;
+	}
+
+	bool bShown = false;
+	Actor.ForEachComponent<UPrimitiveComponent>(false, [&bShown](const UPrimitiveComponent* Primitive)
+	{
+		bShown |= Primitive->IsVisible();
+	});
+	return bShown;
+}
+
+void UHLODMetricsSubsystem::StartRecording()
+{
+	if (!IsRecording())
+	{
+		LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UHLODMetricsSubsystem::HandleLevelsChanged);
+		LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UHLODMetricsSubsystem::HandleLevelsChanged);
+	}
+
+	Frames = MakeUnique<NightFishermanBenchmark::FCsvWriter>(TEXT("HLODFrames"), TArray<FString>{ TEXT("Time"), TEXT("Frame"),
+		TEXT("HLODActors"), TEXT("HLODShown"), TEXT("HLODRendered"), TEXT("HLODPrimitivesRendered"),
+		TEXT("SourceActors"), TEXT("SourceRendered"), TEXT("SourcePrimitivesRendered"), TEXT("Swaps") });
+	Swaps = MakeUnique<NightFishermanBenchmark::FCsvWriter>(TEXT("HLODSwaps"),
+		TArray<FString>{ TEXT("Time"), TEXT("Frame"), TEXT("Actor"), TEXT("Shown"), TEXT("ViewDistance") });
+	StartTime = FPlatformTime::Seconds();
+	StartFrame = GFrameCounter;
+	NumSwaps = 0;
+	bActorsDirty = true;
+
+	UE_LOG(LogNightFisherman, Display, TEXT("HLOD metrics: recording"));
+}
+
+bool UHLODMetricsSubsystem::StopRecording(const FString& Name)
+{
+	if (!IsRecording())
+	{
+		return false;
+	}
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	Frames->SetName(Name + TEXT("_HLODFrames"));
+	Frames->Save();
+	Swaps->SetName(Name + TEXT("_HLODSwaps"));
+	Swaps->Save();
+
+	UE_LOG(LogNightFisherman, Display, TEXT("HLOD metrics %s: %d frames, %d swaps"), *Name, Frames->NumRows(), NumSwaps);
+	Frames.Reset();
+	Swaps.Reset();
+	HLODActors.Reset();
+	SourceActors.Reset();
+	return true;
+}
+
+void UHLODMetricsSubsystem::Deinitialize()
+{
+	if (IsRecording())
+	{
+		FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+		FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	}
+
+	Super::Deinitialize();
+}
+
+bool UHLODMetricsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UHLODMetricsSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	if (bActorsDirty)
+	{
+		RebuildActors();
+	}
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	const double Time = FPlatformTime::Seconds() - StartTime;
+	const uint64 Frame = GFrameCounter - StartFrame;
+
+	FVector ViewLocation = FVector::ZeroVector;
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	}
+
+	int32 NumShown = 0;
+	int32 NumHLODRendered = 0;
+	int32 NumHLODPrimitives = 0;
+	int32 NumFrameSwaps = 0;
+	for (FHLODEntry& Entry : HLODActors)
+	{
+		const AActor* Actor = Entry.Actor.Get();
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const bool bShown = IsHLODShown(*Actor);
+		if (bShown != Entry.bShown)
+		{
+			Entry.bShown = bShown;
+			++NumFrameSwaps;
+			Swaps->AddRow(Time, Frame, Actor->GetName(), bShown ? 1 : 0, FVector::Dist2D(ViewLocation, Actor->GetActorLocation()));
+		}
+
+		const int32 NumPrimitives = bShown ? CountRenderedPrimitives(*Actor, Now) : 0;
+		NumShown += bShown;
+		NumHLODRendered += NumPrimitives > 0;
+		NumHLODPrimitives += NumPrimitives;
+	}
+	NumSwaps += NumFrameSwaps;
+
+	int32 NumSourceRendered = 0;
+	int32 NumSourcePrimitives = 0;
+	for (const TWeakObjectPtr<AActor>& Source : SourceActors)
+	{
+		if (const AActor* Actor = Source.Get())
+		{
+			const int32 NumPrimitives = CountRenderedPrimitives(*Actor, Now);
+			NumSourceRendered += NumPrimitives > 0;
+			NumSourcePrimitives += NumPrimitives;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_HLODActorsShown, NumShown);
+	SET_DWORD_STAT(STAT_HLODPrimitivesRendered, NumHLODPrimitives);
+	SET_DWORD_STAT(STAT_HLODSourcePrimitivesRendered, NumSourcePrimitives);
+
+	Frames->AddRow(Time, Frame, HLODActors.Num(), NumShown, NumHLODRendered, NumHLODPrimitives,
+		SourceActors.Num(), NumSourceRendered, NumSourcePrimitives, NumFrameSwaps);
+}
+
+TStatId UHLODMetricsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHLODMetricsSubsystem, STATGROUP_Tickables);
+}
+
+void UHLODMetricsSubsystem::HandleLevelsChanged(ULevel* Level, UWorld* World)
+{
+	bActorsDirty |= World == GetWorld();
+}
+
+void UHLODMetricsSubsystem::RebuildActors()
+{
+	bActorsDirty = false;
+
+	TMap<TWeakObjectPtr<AActor>, bool> KnownShown;
+	for (const FHLODEntry& Entry : HLODActors)
+	{
+		KnownShown.Add(Entry.Actor, Entry.bShown);
+	}
+	HLODActors.Reset();
+	SourceActors.Reset();
+
+	const UWorld* World = GetWorld();
+	for (const ULevel* Level : World->GetLevels())
+	{
+		if (!Level || !Level->bIsVisible)
+		{
+			continue;
+		}
+
+		for (AActor* Actor : Level->Actors)
+		{
+			if (!Actor)
+			{
+				continue;
+			}
+
+			if (Actor->IsA<AWorldPartitionHLOD>())
+			{
+				// HLODs arriving with a level start in whatever state they arrive in, which is not a swap
+				const bool* bShown = KnownShown.Find(Actor);
+				HLODActors.Add({ Actor, bShown ? *bShown : IsHLODShown(*Actor) });
+			}
+			else if (Level != World->PersistentLevel && Actor->FindComponentByClass<UPrimitiveComponent>())
+			{
+				// Anything placed in a streamed cell is what an HLOD stands in for
+				SourceActors.Add(Actor);
+			}
+		}
+	}
+}
+
+int32 UHLODMetricsSubsystem::CountRenderedPrimitives(const AActor& Actor, double Now)
+{
+	int32 NumRendered = 0;
+	Actor.ForEachComponent<UPrimitiveComponent>(false, [&NumRendered, Now](const UPrimitiveComponent* Primitive)
+	{
+		NumRendered += Primitive->GetLastRenderTimeOnScreen() >= Now - RenderedTolerance;
+	});
+	return NumRendered;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs HLODMetricsCommand(
+	TEXT("NF.HLOD.Metrics"),
+	TEXT("Starts or stops recording HLOD and source actor visibility. Usage: NF.HLOD.Metrics Start | Stop [Name=HLOD]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UHLODMetricsSubsystem* Metrics = World ? World->GetSubsystem<UHLODMetricsSubsystem>() : nullptr;
+		if (!Metrics)
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("NF.HLOD.Metrics needs a game world"));
+			return;
+		}
+
+		if (Args.IsValidIndex(0) && Args[0].Equals(TEXT("Stop"), ESearchCase::IgnoreCase))
+		{
+			Metrics->StopRecording(Args.IsValidIndex(1) ? Args[1] : TEXT("HLOD"));
+		}
+		else
+		{
+			Metrics->StartRecording();
+		}
+	}));
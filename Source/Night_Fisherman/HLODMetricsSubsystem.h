@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NightFishermanBenchmark.h"
+#include "HLODMetricsSubsystem.generated.h"
+
+class ULevel;
+
+/**
+ * Counts, every frame, how many World Partition HLOD actors are shown and how many source actors are on
+ * screen, and records each HLOD swap (an HLOD actor being shown or hidden as its cell streams out or in)
+ * with its distance from the view.
+ *
+ * The actor lists are rebuilt only when a level is added to or removed from the world. An actor counts as
+ * rendered when one of its primitives was drawn within RenderedTolerance seconds.
+ *
+ * StopRecording writes <Name>_HLODFrames (one row per frame) and <Name>_HLODSwaps next to the benchmark output.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UHLODMetricsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Starts a new recording, discarding any unsaved one */
+	void StartRecording();
+
+	/** Stops recording and writes the trace files; returns false if nothing was recording */
+	bool StopRecording(const FString& Name);
+
+	bool IsRecording() const { return Frames.IsValid(); }
+
+	/** Seconds since a primitive was last drawn for it to count as rendered */
+	static constexpr float RenderedTolerance = 0.1f;
+
+	// USubsystem implementation
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FHLODEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		bool bShown = false;
+	};
+
+	void HandleLevelsChanged(ULevel* Level, UWorld* World);
+
+	/** Collects the HLOD and source actors of every visible level, keeping the shown state of known HLODs */
+	void RebuildActors();
+
+	/** Primitives of Actor drawn within RenderedTolerance, or 0 */
+	static int32 CountRenderedPrimitives(const AActor& Actor, double Now);
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+	TArray<FHLODEntry> HLODActors;
+	TArray<TWeakObjectPtr<AActor>> SourceActors;
+	bool bActorsDirty = true;
+
+	TUniquePtr<NightFishermanBenchmark::FCsvWriter> Frames;
+	TUniquePtr<NightFishermanBenchmark::FCsvWriter> Swaps;
+	double StartTime = 0.0;
+	uint64 StartFrame = 0;
+	int32 NumSwaps = 0;
+};
@@ -0,0 +1,224 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HLODReportCommandlet.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/WorldPartitionActorDescInstance.h"
+#include "WorldPartition/WorldPartitionHelpers.h"
+#include "WorldPartition/HLOD/HLODActor.h"
+#include "WorldPartition/HLOD/HLODLayer.h"
+#include "WorldPartition/HLOD/HLODSourceActorsFromCell.h"
+
+#if WITH_EDITOR
+namespace HLODReport
+{
+	/** Per-instance data the renderer keeps for an instanced mesh (transform, bounds, custom data), an estimate */
+	static constexpr int64 InstanceDataBytes = 64;
+
+	/** What one side, the sources or the HLOD actors, of a layer costs */
+	struct FCost
+	{
+		int32 Actors = 0;
+		int32 Primitives = 0;
+		int64 Instances = 0;
+		int64 Draws = 0;
+		int64 InstanceBytes = 0;
+		TSet<UStaticMesh*> Meshes;
+	};
+
+	struct FLayerCosts
+	{
+		FCost Source;
+		FCost HLOD;
+	};
+
+	static void AddActor(const AActor& Actor, FCost& Cost)
+	{
+		++Cost.Actors;
+		Actor.ForEachComponent<UPrimitiveComponent>(false, [&Cost](const UPrimitiveComponent* Primitive)
+		{
+			++Cost.Primitives;
+
+			const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(Primitive);
+			UStaticMesh* Mesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+			if (!Mesh)
+			{
+				// Landscape, sprites and the like, counted as one draw each
+				++Cost.Instances;
+				++Cost.Draws;
+				return;
+			}
+
+			// An instanced component draws every instance of a section at once
+			const UInstancedStaticMeshComponent* Instanced = Cast<UInstancedStaticMeshComponent>(MeshComponent);
+			const int32 NumInstances = Instanced ? Instanced->GetInstanceCount() : 1;
+			Cost.Instances += NumInstances;
+			Cost.InstanceBytes += Instanced ? NumInstances * InstanceDataBytes : 0;
+			Cost.Draws += NumInstances > 0 ? FMath::Max(Mesh->GetNumSections(0), 1) : 0;
+			Cost.Meshes.Add(Mesh);
+		});
+	}
+
+	/** Resource size of Meshes, leaving out those in Exclude */
+	static int64 GetMeshBytes(const TSet<UStaticMesh*>& Meshes, const TSet<UStaticMesh*>& Exclude)
+	{
+		int64 Bytes = 0;
+		for (UStaticMesh* Mesh : Meshes)
+		{
+			if (!Exclude.Contains(Mesh))
+			{
+				Bytes += Mesh->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+		}
+		return Bytes;
+	}
+
+	static double ToMB(int64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+}
+#endif
+
+UHLODReportCommandlet::UHLODReportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	HelpDescription = TEXT("Reports the instances, draw calls and memory of each HLOD layer of a World Partition map against its source actors.");
+}
+
+int32 UHLODReportCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	using namespace HLODReport;
+
+	FString MapName = TEXT("/Game/Untitled");
+	float MinDrawSavings = 0.5f;
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	FParse::Value(*Params, TEXT("MinDrawSavings="), MinDrawSavings);
+
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	if (!World)
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("HLODReport: %s is not a map"), *MapName);
+		return 1;
+	}
+
+	World->AddToRoot();
+	World->WorldType = EWorldType::Editor;
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.RequiresHitProxies(false)
+			.CreatePhysicsScene(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(false)
+			.SetTransactional(false)
+			.CreateFXSystem(false));
+	}
+
+	ON_SCOPE_EXIT
+	{
+		World->RemoveFromRoot();
+		World->DestroyWorld(false);
+	};
+
+	UWorldPartition* WorldPartition = World->GetWorldPartition();
+	if (!WorldPartition)
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("HLODReport: %s does not use World Partition"), *MapName);
+		return 1;
+	}
+	if (!WorldPartition->IsInitialized())
+	{
+		WorldPartition->Initialize(World, FTransform::Identity);
+	}
+
+	// First level HLOD actors, and which layer each of their source actors belongs to
+	TMap<const UHLODLayer*, FLayerCosts> Layers;
+	TMap<FGuid, const UHLODLayer*> SourceLayers;
+	FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, AWorldPartitionHLOD::StaticClass(), [&Layers, &SourceLayers](const FWorldPartitionActorDescInstance* ActorDescInstance)
+	{
+		const AWorldPartitionHLOD* HLODActor = Cast<AWorldPartitionHLOD>(ActorDescInstance->GetActor());
+		const UWorldPartitionHLODSourceActorsFromCell* SourceActors = HLODActor ? Cast<UWorldPartitionHLODSourceActorsFromCell>(HLODActor->GetSourceActors()) : nullptr;
+		if (SourceActors)
+		{
+			const UHLODLayer* Layer = SourceActors->GetHLODLayer();
+			AddActor(*HLODActor, Layers.FindOrAdd(Layer).HLOD);
+			for (const FWorldPartitionRuntimeCellObjectMapping& Mapping : SourceActors->GetActors())
+			{
+				SourceLayers.Add(Mapping.ActorInstanceGuid, Layer);
+			}
+		}
+		return true;
+	});
+
+	if (Layers.IsEmpty())
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("HLODReport: %s has no built HLOD actors, build them with the WorldPartitionHLODsBuilder first"), *MapName);
+		return 1;
+	}
+
+	FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, AActor::StaticClass(), [&Layers, &SourceLayers](const FWorldPartitionActorDescInstance* ActorDescInstance)
+	{
+		const UHLODLayer* const* Layer = SourceLayers.Find(ActorDescInstance->GetGuid());
+		const AActor* Actor = Layer ? ActorDescInstance->GetActor() : nullptr;
+		if (Actor)
+		{
+			AddActor(*Actor, Layers.FindChecked(*Layer).Source);
+		}
+		return true;
+	});
+
+	NightFishermanBenchmark::FCsvWriter Csv(TEXT("HLODReport"), { TEXT("Layer"),
+		TEXT("SourceActors"), TEXT("SourcePrimitives"), TEXT("SourceInstances"), TEXT("SourceDraws"), TEXT("SourceMeshMB"),
+		TEXT("HLODActors"), TEXT("HLODPrimitives"), TEXT("HLODInstances"), TEXT("HLODDraws"), TEXT("HLODMeshMB"), TEXT("HLODInstanceMB"),
+		TEXT("HLODAddedMB"), TEXT("DrawSavings") });
+
+	int32 NumFailed = 0;
+	for (const TPair<const UHLODLayer*, FLayerCosts>& Layer : Layers)
+	{
+		const FString LayerName = Layer.Key ? Layer.Key->GetName() : TEXT("None");
+		const FCost& Source = Layer.Value.Source;
+		const FCost& HLOD = Layer.Value.HLOD;
+
+		// Instancing layers reuse the source meshes, so only new meshes and instance data add memory
+		const int64 SourceMeshBytes = GetMeshBytes(Source.Meshes, {});
+		const int64 HLODMeshBytes = GetMeshBytes(HLOD.Meshes, {});
+		const int64 HLODAddedBytes = GetMeshBytes(HLOD.Meshes, Source.Meshes) + HLOD.InstanceBytes;
+		const double DrawSavings = Source.Draws > 0 ? 1.0 - static_cast<double>(HLOD.Draws) / Source.Draws : 0.0;
+
+		Csv.AddRow(LayerName, Source.Actors, Source.Primitives, Source.Instances, Source.Draws, ToMB(SourceMeshBytes),
+			HLOD.Actors, HLOD.Primitives, HLOD.Instances, HLOD.Draws, ToMB(HLODMeshBytes), ToMB(HLOD.InstanceBytes),
+			ToMB(HLODAddedBytes), DrawSavings);
+
+		UE_LOG(LogNightFisherman, Display, TEXT("HLODReport %s: %d HLOD actors, %lld draws for %d source actors' %lld (%.1f%% saved), %lld instances, %.2f MB added"),
+			*LayerName, HLOD.Actors, HLOD.Draws, Source.Actors, Source.Draws, 100.0 * DrawSavings, HLOD.Instances, ToMB(HLODAddedBytes));
+
+		if (DrawSavings < MinDrawSavings)
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("HLODReport %s: saves %.1f%% of its sources' draw calls, below the required %.1f%%"),
+				*LayerName, 100.0 * DrawSavings, 100.0 * MinDrawSavings);
+			++NumFailed;
+		}
+	}
+
+	Csv.Save();
+	return NumFailed > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
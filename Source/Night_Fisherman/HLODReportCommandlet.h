@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HLODReportCommandlet.generated.h"
+
+/**
+ * Reports, for each HLOD layer of a World Partition map, what its built HLOD actors cost against the source
+ * actors they stand in for: actors, primitives, mesh instances, estimated draw calls and mesh memory.
+ *
+ *   UnrealEditor-Cmd Night_Fisherman.uproject -run=HLODReport [-Map=/Game/Untitled] [-MinDrawSavings=0.5]
+ *
+ * Draw calls are estimated as one per mesh section per component, instanced components drawing all of their
+ * instances at once. Fails when a layer has no built HLOD actors or saves less than MinDrawSavings (0-1) of its
+ * sources' draw calls. Writes HLODReport next to the benchmark output.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UHLODReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHLODReportCommandlet();
+
+	// UCommandlet implementation
+	virtual int32 Main(const FString& Params) override;
+};
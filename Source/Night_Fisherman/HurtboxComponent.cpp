@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "HurtboxComponent.h"
+#include "CombatHitSubsystem.h"
+#include "Engine/World.h"
+
+UHurtboxComponent::UHurtboxComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UHurtboxComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UCombatHitSubsystem* CombatHits = GetWorld() ? GetWorld()->GetSubsystem<UCombatHitSubsystem>() : nullptr)
+	{
+		CombatHits->RegisterHurtbox(this);
+	}
+}
+
+void UHurtboxComponent::OnUnregister()
+{
+	if (UCombatHitSubsystem* CombatHits = GetWorld() ? GetWorld()->GetSubsystem<UCombatHitSubsystem>() : nullptr)
+	{
+		CombatHits->UnregisterHurtbox(this);
+	}
+
+	Super::OnUnregister();
+}
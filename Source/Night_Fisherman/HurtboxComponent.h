@@ -0,0 +1,50 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "HurtboxComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FHurtSignature, AActor*, Attacker, float, Damage);
+
+/** Vertical capsule, centred on the component, that melee swings resolved by UCombatHitSubsystem can hit */
+UCLASS(ClassGroup = (Combat), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UHurtboxComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHurtboxComponent();
+
+	/** Capsule radius */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (ClampMin = "0.0"))
+	float Radius = 40.0f;
+
+	/** Distance from the centre to either end of the capsule's segment */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat, meta = (ClampMin = "0.0"))
+	float HalfHeight = 50.0f;
+
+	/** Swings from the same non-zero team do not hit this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat)
+	uint8 Team = 0;
+
+	/** Swings pass through while set, e.g. during a dodge */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Combat)
+	bool bInvulnerable = false;
+
+	/** Broadcast once per swing that hits this */
+	UPROPERTY(BlueprintAssignable, Category = Combat)
+	FHurtSignature OnHurt;
+
+protected:
+	// UActorComponent implementation
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+private:
+	friend class UCombatHitSubsystem;
+
+	/** Index in UCombatHitSubsystem's hurtbox list, INDEX_NONE while unregistered */
+	int32 HurtboxIndex = INDEX_NONE;
+};
@@ -0,0 +1,182 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputRecording.h"
+#include "Night_Fisherman.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace InputRecording
+{
+	// Event tag: action in the low four bits, value type in the next two, a boolean value in the bit above
+	static constexpr uint8 ActionMask = 0x0F;
+	static constexpr uint8 TypeShift = 4;
+	static constexpr uint8 TypeMask = 0x03;
+	static constexpr uint8 BoolBit = 0x40;
+
+	static_assert(static_cast<uint8>(ETopDownInputAction::Count) <= ActionMask + 1, "ETopDownInputAction no longer fits the event tag");
+
+	static int32 GetNumAxes(EInputActionValueType Type)
+	{
+		switch (Type)
+		{
+		case EInputActionValueType::Axis1D:
+			return 1;
+		case EInputActionValueType::Axis2D:
+			return 2;
+		case EInputActionValueType::Axis3D:
+			return 3;
+		default:
+			return 0;
+		}
+	}
+}
+
+FString FInputRecording::GetPath(const FString& Name)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Replays") / Name + TEXT(".nfinput");
+}
+
+void FInputRecording::Reset(float InFixedDeltaTime, const FVector& InStartLocation, const FRotator& InStartRotation, const FRotator& InStartControlRotation)
+{
+	FixedDeltaTime = InFixedDeltaTime;
+	StartLocation = InStartLocation;
+	StartRotation = InStartRotation;
+	StartControlRotation = InStartControlRotation;
+	Inputs.Reset();
+	FrameStarts.Reset();
+}
+
+void FInputRecording::BeginFrame()
+{
+	FrameStarts.Add(Inputs.Num());
+}
+
+void FInputRecording::Add(ETopDownInputAction Action, const FInputActionValue& Value)
+{
+	if (FrameStarts.IsEmpty())
+	{
+		BeginFrame();
+	}
+	Inputs.Add({ Action, Value });
+}
+
+TConstArrayView<FRecordedInput> FInputRecording::GetFrame(int32 Frame) const
+{
+	const int32 Begin = FrameStarts[Frame];
+	const int32 End = FrameStarts.IsValidIndex(Frame + 1) ? FrameStarts[Frame + 1] : Inputs.Num();
+	return TConstArrayView<FRecordedInput>(Inputs.GetData() + Begin, End - Begin);
+}
+
+void FInputRecording::Serialize(FArchive& Ar)
+{
+	using namespace InputRecording;
+
+	uint32 FileMagic = Magic;
+	uint16 FileVersion = Version;
+	Ar << FileMagic << FileVersion;
+	if (Ar.IsLoading() && (FileMagic != Magic || FileVersion != Version))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << FixedDeltaTime << StartLocation << StartRotation << StartControlRotation;
+
+	uint32 FrameCount = NumFrames();
+	Ar.SerializeIntPacked(FrameCount);
+	if (Ar.IsLoading())
+	{
+		// Every frame takes at least a byte, which bounds what a corrupt count can make us allocate
+		if (FrameCount > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Inputs.Reset();
+		FrameStarts.Reset(FrameCount);
+	}
+
+	for (uint32 Frame = 0; Frame < FrameCount && !Ar.IsError(); ++Frame)
+	{
+		uint32 InputCount = 0;
+		if (Ar.IsSaving())
+		{
+			InputCount = GetFrame(Frame).Num();
+		}
+		Ar.SerializeIntPacked(InputCount);
+
+		const int32 FrameStart = Ar.IsLoading() ? Inputs.Num() : FrameStarts[Frame];
+		if (Ar.IsLoading())
+		{
+			FrameStarts.Add(FrameStart);
+		}
+
+		for (uint32 Input = 0; Input < InputCount && !Ar.IsError(); ++Input)
+		{
+			uint8 Tag = 0;
+			FVector3f Axes = FVector3f::ZeroVector;
+			if (Ar.IsSaving())
+			{
+				const FRecordedInput& Recorded = Inputs[FrameStart + Input];
+				const EInputActionValueType Type = Recorded.Value.GetValueType();
+				Tag = static_cast<uint8>(Recorded.Action) | static_cast<uint8>(Type) << TypeShift;
+				if (Type == EInputActionValueType::Boolean && Recorded.Value.Get<bool>())
+				{
+					Tag |= BoolBit;
+				}
+				Axes = FVector3f(Recorded.Value.Get<FVector>());
+			}
+
+			Ar << Tag;
+			const EInputActionValueType Type = static_cast<EInputActionValueType>((Tag >> TypeShift) & TypeMask);
+			for (int32 Axis = 0; Axis < GetNumAxes(Type); ++Axis)
+			{
+				Ar << Axes[Axis];
+			}
+
+			if (Ar.IsLoading())
+			{
+				const uint8 Action = Tag & ActionMask;
+				if (Action >= static_cast<uint8>(ETopDownInputAction::Count))
+				{
+					Ar.SetError();
+					break;
+				}
+
+				const FInputActionValue Value = Type == EInputActionValueType::Boolean
+					? FInputActionValue((Tag & BoolBit) != 0)
+					: FInputActionValue(Type, FVector(Axes));
+				Inputs.Add({ static_cast<ETopDownInputAction>(Action), Value });
+			}
+		}
+	}
+}
+
+bool FInputRecording::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	const_cast<FInputRecording*>(this)->Serialize(Writer);
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FInputRecording::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Serialize(Reader);
+	if (Reader.IsError())
+	{
+		UE_LOG(LogNightFisherman, Warning, TEXT("Input recording %s is not a version %d recording or is corrupt"), *Path, Version);
+		Reset(1.0f / 60.0f, FVector::ZeroVector, FRotator::ZeroRotator, FRotator::ZeroRotator);
+		return false;
+	}
+	return true;
+}
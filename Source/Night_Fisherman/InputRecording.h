@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputActionValue.h"
+#include "TopDownCharacter.h"
+
+/** One input action handled by ATopDownCharacter */
+struct FRecordedInput
+{
+	ETopDownInputAction Action;
+	FInputActionValue Value;
+};
+
+/**
+ * Frame-by-frame input of one ATopDownCharacter, with the pose it started from and the fixed timestep it was
+ * recorded and is replayed at. No per-frame delta time is stored: the engine runs at FixedDeltaTime for the whole
+ * recording, so every frame lasted exactly that long. Saved compactly: a frame without input is one byte, an event
+ * is a tag byte plus a float per axis.
+ */
+class NIGHT_FISHERMAN_API FInputRecording
+{
+public:
+	/** "NFIR" */
+	static constexpr uint32 Magic = 0x5249464E;
+	static constexpr uint16 Version = 1;
+
+	/** Saved/Replays/<Name>.nfinput */
+	static FString GetPath(const FString& Name);
+
+	/** Clears the recording and starts a new one from the given pose */
+	void Reset(float InFixedDeltaTime, const FVector& InStartLocation, const FRotator& InStartRotation, const FRotator& InStartControlRotation);
+
+	/** Starts the next frame; inputs are added to the latest one */
+	void BeginFrame();
+	void Add(ETopDownInputAction Action, const FInputActionValue& Value);
+
+	int32 NumFrames() const { return FrameStarts.Num(); }
+	int32 NumInputs() const { return Inputs.Num(); }
+	TConstArrayView<FRecordedInput> GetFrame(int32 Frame) const;
+
+	float GetFixedDeltaTime() const { return FixedDeltaTime; }
+	const FVector& GetStartLocation() const { return StartLocation; }
+	const FRotator& GetStartRotation() const { return StartRotation; }
+	const FRotator& GetStartControlRotation() const { return StartControlRotation; }
+
+	/** Reads or writes the compact format; sets an error on the archive if a loaded recording is malformed */
+	void Serialize(FArchive& Ar);
+
+	bool SaveToFile(const FString& Path) const;
+	bool LoadFromFile(const FString& Path);
+
+private:
+	float FixedDeltaTime = 1.0f / 60.0f;
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+	FRotator StartControlRotation = FRotator::ZeroRotator;
+
+	TArray<FRecordedInput> Inputs;
+	/** Index into Inputs of each frame's first input */
+	TArray<int32> FrameStarts;
+};
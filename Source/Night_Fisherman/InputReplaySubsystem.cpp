@@ -0,0 +1,226 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InputReplaySubsystem.h"
+#include "DeterminismSubsystem.h"
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarReplayFps(
+	TEXT("NF.Replay.Fps"),
+	60.0f,
+	TEXT("Fixed frame rate new input recordings are made and replayed at."));
+
+void UInputReplaySubsystem::StartRecording(ATopDownCharacter* Character)
+{
+	if (!Character)
+	{
+		return;
+	}
+
+	const AController* Controller = Character->GetController();
+	Recording.Reset(1.0f / FMath::Max(CVarReplayFps.GetValueOnGameThread(), 1.0f), Character->GetActorLocation(), Character->GetActorRotation(),
+		Controller ? Controller->GetControlRotation() : Character->GetActorRotation());
+	RecordedCharacter = Character;
+	UpdateTimestep();
+
+	UE_LOG(LogNightFisherman, Display, TEXT("Input recording of %s started at %.1f fps"), *Character->GetName(), 1.0f / Recording.GetFixedDeltaTime());
+}
+
+bool UInputReplaySubsystem::StopRecording(const FString& Name)
+{
+	if (!IsRecording())
+	{
+		return false;
+	}
+	RecordedCharacter.Reset();
+	UpdateTimestep();
+
+	const FString Path = FInputRecording::GetPath(Name);
+	if (Recording.NumFrames() == 0 || !Recording.SaveToFile(Path))
+	{
+		UE_LOG(LogNightFisherman, Warning, TEXT("Input recording %s was not saved"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogNightFisherman, Display, TEXT("Input recording saved to %s: %d frames, %d inputs, %lld bytes"),
+		*Path, Recording.NumFrames(), Recording.NumInputs(), IFileManager::Get().FileSize(*Path));
+	return true;
+}
+
+void UInputReplaySubsystem::RecordInput(const ATopDownCharacter* Character, ETopDownInputAction Action, const FInputActionValue& Value)
+{
+	if (Character && RecordedCharacter.Get() == Character)
+	{
+		Recording.Add(Action, Value);
+	}
+}
+
+bool UInputReplaySubsystem::StartReplay(ATopDownCharacter* Character, FInputRecording&& InRecording)
+{
+	if (!Character || InRecording.NumFrames() == 0)
+	{
+		return false;
+	}
+	StopReplay();
+
+	Replay = MoveTemp(InRecording);
+	ReplayedCharacter = Character;
+	ReplayFrame = 0;
+
+	// Put the character back where the recording started, at rest
+	Character->SetActorLocationAndRotation(Replay.GetStartLocation(), Replay.GetStartRotation(), false, nullptr, ETeleportType::ResetPhysics);
+	Character->GetCharacterMovement()->StopMovementImmediately();
+	if (AController* Controller = Character->GetController())
+	{
+		Controller->SetControlRotation(Replay.GetStartControlRotation());
+	}
+
+	UpdateTimestep();
+
+	UE_LOG(LogNightFisherman, Display, TEXT("Input replay of %d frames on %s at %.1f fps"), Replay.NumFrames(), *Character->GetName(), 1.0f / Replay.GetFixedDeltaTime());
+	return true;
+}
+
+void UInputReplaySubsystem::StopReplay()
+{
+	if (!ReplayedCharacter.IsExplicitlyNull())
+	{
+		ReplayedCharacter.Reset();
+		UpdateTimestep();
+	}
+}
+
+void UInputReplaySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Determinism = Collection.InitializeDependency<UDeterminismSubsystem>();
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UInputReplaySubsystem::HandlePreActorTick);
+}
+
+void UInputReplaySubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	StopReplay();
+	RecordedCharacter.Reset();
+	UpdateTimestep();
+
+	Super::Deinitialize();
+}
+
+bool UInputReplaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UInputReplaySubsystem::HandlePreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime)
+{
+	if (InWorld != GetWorld())
+	{
+		return;
+	}
+
+	if (IsRecording())
+	{
+		Recording.BeginFrame();
+	}
+	else if (!RecordedCharacter.IsExplicitlyNull())
+	{
+		// The recorded character went away, so the recording ended and the timestep is released
+		RecordedCharacter.Reset();
+		UpdateTimestep();
+	}
+
+	if (ReplayedCharacter.IsExplicitlyNull())
+	{
+		return;
+	}
+
+	ATopDownCharacter* Character = ReplayedCharacter.Get();
+	if (!Character || ReplayFrame >= Replay.NumFrames())
+	{
+		UE_LOG(LogNightFisherman, Display, TEXT("Input replay %s after %d of %d frames"), Character ? TEXT("finished") : TEXT("lost its character"), ReplayFrame, Replay.NumFrames());
+		StopReplay();
+		return;
+	}
+
+	for (const FRecordedInput& Input : Replay.GetFrame(ReplayFrame))
+	{
+		Character->InjectInput(Input.Action, Input.Value);
+	}
+	++ReplayFrame;
+}
+
+void UInputReplaySubsystem::UpdateTimestep()
+{
+	// A replay's own timestep wins over a recording made while it plays
+	Determinism->SetTimestepOverride(IsReplaying() ? Replay.GetFixedDeltaTime() : IsRecording() ? Recording.GetFixedDeltaTime() : 0.0f);
+}
+
+namespace InputReplay
+{
+	static ATopDownCharacter* GetPlayerCharacter(UWorld* World)
+	{
+		const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		return PlayerController ? Cast<ATopDownCharacter>(PlayerController->GetPawn()) : nullptr;
+	}
+
+	static FString GetName(const TArray<FString>& Args)
+	{
+		return Args.IsValidIndex(0) ? Args[0] : FString(TEXT("Session"));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs RecordCommand(
+		TEXT("NF.Replay.Record"),
+		TEXT("Starts recording the player character's input. Save it with NF.Replay.Save."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UInputReplaySubsystem* Replays = World ? World->GetSubsystem<UInputReplaySubsystem>() : nullptr;
+			if (ATopDownCharacter* Character = GetPlayerCharacter(World); Replays && Character)
+			{
+				Replays->StartRecording(Character);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs SaveCommand(
+		TEXT("NF.Replay.Save"),
+		TEXT("Stops recording input and saves it to Saved/Replays. Usage: NF.Replay.Save [Name=Session]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UInputReplaySubsystem* Replays = World ? World->GetSubsystem<UInputReplaySubsystem>() : nullptr)
+			{
+				Replays->StopRecording(GetName(Args));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs PlayCommand(
+		TEXT("NF.Replay.Play"),
+		TEXT("Replays a saved input recording on the player character at its fixed timestep. Usage: NF.Replay.Play [Name=Session]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UInputReplaySubsystem* Replays = World ? World->GetSubsystem<UInputReplaySubsystem>() : nullptr;
+			ATopDownCharacter* Character = GetPlayerCharacter(World);
+			FInputRecording Recording;
+			if (Replays && Character && Recording.LoadFromFile(FInputRecording::GetPath(GetName(Args))))
+			{
+				Replays->StartReplay(Character, MoveTemp(Recording));
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs StopCommand(
+		TEXT("NF.Replay.Stop"),
+		TEXT("Stops the input replay in progress."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UInputReplaySubsystem* Replays = World ? World->GetSubsystem<UInputReplaySubsystem>() : nullptr)
+			{
+				Replays->StopReplay();
+			}
+		}));
+}
@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InputRecording.h"
+#include "InputReplaySubsystem.generated.h"
+
+class ATopDownCharacter;
+class UDeterminismSubsystem;
+
+/**
+ * Records the input actions an ATopDownCharacter handles, frame by frame, and replays them through the
+ * same handlers so a real play session can be rerun exactly, e.g. by NF.Benchmark.Replay in headless CI.
+ *
+ * Frames are delimited at the start of each world tick. Recording has UDeterminismSubsystem run the engine at
+ * the recording's fixed timestep, NF.Replay.Fps, so each recorded frame covers the same game time a replayed one
+ * will. A replay moves the character back to where the recording started, feeds it one recorded frame per world
+ * tick before any actor ticks, ignores its live input and runs the engine at that same timestep, so every run of
+ * a replay simulates the same; with deterministic mode on the state matches bit for bit.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UInputReplaySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Starts recording Character's input, replacing any recording in progress */
+	void StartRecording(ATopDownCharacter* Character);
+
+	/** Stops recording and saves it as Saved/Replays/<Name>.nfinput. Returns false if nothing was recorded or the save failed. */
+	bool StopRecording(const FString& Name);
+
+	bool IsRecording() const { return RecordedCharacter.IsValid(); }
+
+	/** Called by the character for every input action it handles */
+	void RecordInput(const ATopDownCharacter* Character, ETopDownInputAction Action, const FInputActionValue& Value);
+
+	/** Replays a recording on Character from the next frame. Returns false if the recording is empty. */
+	bool StartReplay(ATopDownCharacter* Character, FInputRecording&& InRecording);
+	void StopReplay();
+
+	bool IsReplaying() const { return ReplayedCharacter.IsValid(); }
+	bool IsReplaying(const ATopDownCharacter* Character) const { return Character && ReplayedCharacter.Get() == Character; }
+
+	/** Recorded frame the replay feeds next */
+	int32 GetReplayFrame() const { return ReplayFrame; }
+
+	const FInputRecording& GetReplay() const { return Replay; }
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void HandlePreActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime);
+
+	/** Locks the engine to the timestep of the replay or recording in progress, or releases it when there is none */
+	void UpdateTimestep();
+
+	FInputRecording Recording;
+	TWeakObjectPtr<ATopDownCharacter> RecordedCharacter;
+
+	FInputRecording Replay;
+	TWeakObjectPtr<ATopDownCharacter> ReplayedCharacter;
+	int32 ReplayFrame = 0;
+
+	/** Runs the engine at the recording's timestep while recording or replaying */
+	UPROPERTY()
+	TObjectPtr<UDeterminismSubsystem> Determinism;
+
+	FDelegateHandle PreActorTickHandle;
+};
@@ -0,0 +1,48 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InteractableComponent.h"
+#include "InteractionSubsystem.h"
+#include "Engine/World.h"
+
+UInteractableComponent::UInteractableComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UInteractableComponent::Interact(AActor* Interactor)
+{
+	OnInteracted.Broadcast(Interactor);
+}
+
+void UInteractableComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UInteractionSubsystem* Interaction = GetWorld() ? GetWorld()->GetSubsystem<UInteractionSubsystem>() : nullptr)
+	{
+		Interaction->Register(this);
+	}
+}
+
+void UInteractableComponent::OnUnregister()
+{
+	if (UInteractionSubsystem* Interaction = GetWorld() ? GetWorld()->GetSubsystem<UInteractionSubsystem>() : nullptr)
+	{
+		Interaction->Unregister(this);
+	}
+
+	Super::OnUnregister();
+}
+
+void UInteractableComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+
+	if (SpatialHashId != INDEX_NONE)
+	{
+		if (UInteractionSubsystem* Interaction = GetWorld()->GetSubsystem<UInteractionSubsystem>())
+		{
+			Interaction->UpdateLocation(this);
+		}
+	}
+}
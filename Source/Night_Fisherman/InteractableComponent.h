@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "InteractableComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInteractedSignature, AActor*, Interactor);
+
+/**
+ * Marks a spot characters can interact with (dock, boat, bait shop, fish spot).
+ * Registers itself in the world's UInteractionSubsystem spatial hash and keeps its cell up to date as it moves.
+ */
+UCLASS(ClassGroup = (Gameplay), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UInteractableComponent : public USceneComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInteractableComponent();
+
+	/** Broadcast when a character interacts with this */
+	UPROPERTY(BlueprintAssignable, Category = Interaction)
+	FInteractedSignature OnInteracted;
+
+	/** Whether interaction queries may return this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Interaction)
+	bool bInteractionEnabled = true;
+
+	/** Notifies listeners that Interactor interacted with this */
+	void Interact(AActor* Interactor);
+
+protected:
+	// UActorComponent implementation
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+
+	// USceneComponent implementation
+	virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport) override;
+
+private:
+	friend class UInteractionSubsystem;
+
+	/** Slot in the spatial hash, INDEX_NONE while unregistered */
+	int32 SpatialHashId = INDEX_NONE;
+};
@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InteractableComponent.h"
+#include "InteractionSubsystem.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	/**
+	 * Compares the interaction spatial hash with the physics traces Interact would otherwise use.
+	 * Spawns temporary blocking interactables in the current world, so both paths see the same scene.
+	 */
+	static void RunInteractionBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		UInteractionSubsystem* Interaction = World ? World->GetSubsystem<UInteractionSubsystem>() : nullptr;
+		if (!Interaction)
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.Interaction needs a game world"));
+			return;
+		}
+
+		const int32 NumInteractables = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 1000, 1);
+		const int32 NumQueries = FMath::Max(Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 10000, 1);
+		constexpr float FieldExtent = 10000.0f;
+		constexpr float QueryDistance = 250.0f;
+		constexpr float QueryHalfAngle = 60.0f;
+		constexpr float SweepRadius = 50.0f;
+		const FVector FieldOrigin(0.0f, 0.0f, 100000.0f);
+
+		FRandomStream Random(42);
+		TArray<AActor*> Actors;
+		TArray<UInteractableComponent*> Interactables;
+		Actors.Reserve(NumInteractables);
+		Interactables.Reserve(NumInteractables);
+		for (int32 Index = 0; Index < NumInteractables; ++Index)
+		{
+			AActor* Actor = World->SpawnActor<AActor>();
+			UBoxComponent* Box = NewObject<UBoxComponent>(Actor);
+			Box->SetBoxExtent(FVector(50.0f));
+			Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+			Actor->SetRootComponent(Box);
+			Box->RegisterComponent();
+
+			UInteractableComponent* Interactable = NewObject<UInteractableComponent>(Actor);
+			Interactable->SetupAttachment(Box);
+			Interactable->RegisterComponent();
+
+			Actor->SetActorLocation(FieldOrigin + FVector(Random.FRandRange(-FieldExtent, FieldExtent), Random.FRandRange(-FieldExtent, FieldExtent), 0.0f));
+			Actors.Add(Actor);
+			Interactables.Add(Interactable);
+		}
+
+		TArray<FVector> Origins;
+		TArray<FVector> Directions;
+		Origins.Reserve(NumQueries);
+		Directions.Reserve(NumQueries);
+		for (int32 Index = 0; Index < NumQueries; ++Index)
+		{
+			Origins.Add(FieldOrigin + FVector(Random.FRandRange(-FieldExtent, FieldExtent), Random.FRandRange(-FieldExtent, FieldExtent), 0.0f));
+			const float Angle = Random.FRand() * UE_TWO_PI;
+			Directions.Add(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f));
+		}
+
+		FCsvWriter Csv(TEXT("InteractionQuery"), { TEXT("Method"), TEXT("Interactables"), TEXT("Calls"), TEXT("TotalMs"), TEXT("AverageUs"), TEXT("Hits") });
+		auto Record = [&Csv, NumInteractables](const TCHAR* Method, int32 Count, double AverageMs, int32 Hits)
+		{
+			Csv.AddRow(FString(Method), NumInteractables, Count, AverageMs * Count, AverageMs * 1000.0, Hits);
+			UE_LOG(LogNightFisherman, Display, TEXT("Interaction %-12s %8.3f us/call, %d hits"), Method, AverageMs * 1000.0, Hits);
+		};
+
+		int32 QueryIndex = 0;
+		int32 Hits = 0;
+		const double SpatialHashMs = TimeAverageMs(NumQueries, [&]
+		{
+			Hits += Interaction->FindInCone(Origins[QueryIndex], Directions[QueryIndex], QueryDistance, QueryHalfAngle) != nullptr;
+			++QueryIndex;
+		});
+		Record(TEXT("SpatialHash"), NumQueries, SpatialHashMs, Hits);
+
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(InteractionBenchmark), false);
+		QueryIndex = 0;
+		Hits = 0;
+		const double LineTraceMs = TimeAverageMs(NumQueries, [&]
+		{
+			FHitResult Hit;
+			Hits += World->LineTraceSingleByChannel(Hit, Origins[QueryIndex], Origins[QueryIndex] + Directions[QueryIndex] * QueryDistance, ECC_Visibility, QueryParams);
+			++QueryIndex;
+		});
+		Record(TEXT("LineTrace"), NumQueries, LineTraceMs, Hits);
+
+		QueryIndex = 0;
+		Hits = 0;
+		const double SweepMs = TimeAverageMs(NumQueries, [&]
+		{
+			FHitResult Hit;
+			Hits += World->SweepSingleByChannel(Hit, Origins[QueryIndex], Origins[QueryIndex] + Directions[QueryIndex] * QueryDistance, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(SweepRadius), QueryParams);
+			++QueryIndex;
+		});
+		Record(TEXT("SphereSweep"), NumQueries, SweepMs, Hits);
+
+		// Incremental update cost paid by each moving interactable, excluding the transform update itself
+		int32 InteractableIndex = 0;
+		const double UpdateMs = TimeAverageMs(NumInteractables, [&]
+		{
+			Interaction->UpdateLocation(Interactables[InteractableIndex++]);
+		});
+		Record(TEXT("HashUpdate"), NumInteractables, UpdateMs, 0);
+
+		for (AActor* Actor : Actors)
+		{
+			Actor->Destroy();
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs InteractionBenchmarkCommand(
+		TEXT("NF.Benchmark.Interaction"),
+		TEXT("Compares interaction spatial hash queries with physics line traces and sweeps, writing InteractionQuery.csv. Usage: NF.Benchmark.Interaction [Interactables=1000] [Queries=10000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunInteractionBenchmark));
+}
@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InteractionSubsystem.h"
+#include "InteractableComponent.h"
+#include "Night_Fisherman.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interaction FindInCone"), STAT_InteractionFindInCone, STATGROUP_NightFisherman);
+
+void UInteractionSubsystem::Register(UInteractableComponent* Interactable)
+{
+	check(Interactable);
+	if (Interactable->SpatialHashId != INDEX_NONE)
+	{
+		return;
+	}
+
+	const FVector Location = Interactable->GetComponentLocation();
+	const FIntPoint Cell = GetCell(Location);
+	const int32 Id = Entries.Add({ Interactable, Location, Cell });
+	Interactable->SpatialHashId = Id;
+	AddToCell(Cell, Id);
+}
+
+void UInteractionSubsystem::Unregister(UInteractableComponent* Interactable)
+{
+	check(Interactable);
+	const int32 Id = Interactable->SpatialHashId;
+	if (Id == INDEX_NONE)
+	{
+		return;
+	}
+
+	RemoveFromCell(Entries[Id].Cell, Id);
+	Entries.RemoveAt(Id);
+	Interactable->SpatialHashId = INDEX_NONE;
+}
+
+void UInteractionSubsystem::UpdateLocation(UInteractableComponent* Interactable)
+{
+	check(Interactable);
+	const int32 Id = Interactable->SpatialHashId;
+	if (Id == INDEX_NONE)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[Id];
+	Entry.Location = Interactable->GetComponentLocation();
+
+	const FIntPoint NewCell = GetCell(Entry.Location);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(Entry.Cell, Id);
+		AddToCell(NewCell, Id);
+		Entry.Cell = NewCell;
+	}
+}
+
+UInteractableComponent* UInteractionSubsystem::FindInCone(const FVector& Origin, const FVector& Direction, float MaxDistance, float HalfAngleDegrees, const AActor* IgnoreActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractionFindInCone);
+
+	const FVector2D Forward = FVector2D(Direction).GetSafeNormal();
+	const double MinCosAngle = FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees));
+	const double MaxDistanceSquared = FMath::Square(MaxDistance);
+
+	const FIntPoint MinCell = GetCell(Origin - FVector(MaxDistance, MaxDistance, 0.0));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(MaxDistance, MaxDistance, 0.0));
+
+	UInteractableComponent* Best = nullptr;
+	double BestDistanceSquared = MaxDistanceSquared;
+
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			const TArray<int32, TInlineAllocator<4>>* CellIds = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellIds)
+			{
+				continue;
+			}
+
+			for (const int32 Id : *CellIds)
+			{
+				const FEntry& Entry = Entries[Id];
+				const FVector2D ToEntry(Entry.Location - Origin);
+				const double DistanceSquared = ToEntry.SizeSquared();
+				if (DistanceSquared > BestDistanceSquared)
+				{
+					continue;
+				}
+
+				// Anything the character is standing on counts as in front of it
+				if (DistanceSquared > UE_KINDA_SMALL_NUMBER && FVector2D::DotProduct(ToEntry, Forward) < MinCosAngle * FMath::Sqrt(DistanceSquared))
+				{
+					continue;
+				}
+
+				if (!Entry.Component->bInteractionEnabled || (IgnoreActor && Entry.Component->GetOwner() == IgnoreActor))
+				{
+					continue;
+				}
+
+				Best = Entry.Component;
+				BestDistanceSquared = DistanceSquared;
+			}
+		}
+	}
+
+	return Best;
+}
+
+bool UInteractionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntPoint UInteractionSubsystem::GetCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UInteractionSubsystem::AddToCell(const FIntPoint& Cell, int32 Id)
+{
+	Cells.FindOrAdd(Cell).Add(Id);
+}
+
+void UInteractionSubsystem::RemoveFromCell(const FIntPoint& Cell, int32 Id)
+{
+	if (TArray<int32, TInlineAllocator<4>>* CellIds = Cells.Find(Cell))
+	{
+		CellIds->RemoveSingleSwap(Id, EAllowShrinking::No);
+		if (CellIds->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
@@ -0,0 +1,58 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/SparseArray.h"
+#include "InteractionSubsystem.generated.h"
+
+class UInteractableComponent;
+
+/**
+ * Uniform 2D grid of registered interactables, answering "nearest interactable in front of me" by
+ * visiting only the few cells within reach instead of tracing against the physics scene.
+ * Interactables are rehashed only when a move takes them into a different cell.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UInteractionSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Side length of a grid cell in cm; queries shorter than this visit at most four cells */
+	static constexpr float CellSize = 500.0f;
+
+	void Register(UInteractableComponent* Interactable);
+	void Unregister(UInteractableComponent* Interactable);
+
+	/** Re-reads the interactable's location, moving it between cells if needed */
+	void UpdateLocation(UInteractableComponent* Interactable);
+
+	/**
+	 * Returns the nearest enabled interactable within MaxDistance of Origin whose horizontal direction
+	 * is within HalfAngleDegrees of Direction, or nullptr. Interactables owned by IgnoreActor are skipped.
+	 */
+	UInteractableComponent* FindInCone(const FVector& Origin, const FVector& Direction, float MaxDistance, float HalfAngleDegrees, const AActor* IgnoreActor = nullptr) const;
+
+	int32 Num() const { return Entries.Num(); }
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEntry
+	{
+		UInteractableComponent* Component;
+		FVector Location;
+		FIntPoint Cell;
+	};
+
+	static FIntPoint GetCell(const FVector& Location);
+
+	void AddToCell(const FIntPoint& Cell, int32 Id);
+	void RemoveFromCell(const FIntPoint& Cell, int32 Id);
+
+	TSparseArray<FEntry> Entries;
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Cells;
+};
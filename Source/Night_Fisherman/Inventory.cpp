@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Inventory.h"
+
+int32 FInventory::Add(const FItemTable& Items, FItemId Item, int32 Count)
+{
+	if (!Items.IsValid(Item) || Count <= 0)
+	{
+		return 0;
+	}
+
+	const int32 MaxStack = Items.Get(Item).MaxStack;
+	int32 Remaining = Count;
+
+	for (FInventorySlot& Slot : Slots)
+	{
+		if (Slot.Item == Item && Slot.Count < MaxStack)
+		{
+			const int32 Added = FMath::Min(Remaining, MaxStack - Slot.Count);
+			Slot.Count += static_cast<uint16>(Added);
+			Remaining -= Added;
+			if (Remaining == 0)
+			{
+				return Count;
+			}
+		}
+	}
+
+	for (FInventorySlot& Slot : Slots)
+	{
+		if (Slot.Item == NoItem)
+		{
+			const int32 Added = FMath::Min(Remaining, MaxStack);
+			Slot.Item = Item;
+			Slot.Count = static_cast<uint16>(Added);
+			Remaining -= Added;
+			if (Remaining == 0)
+			{
+				return Count;
+			}
+		}
+	}
+
+	return Count - Remaining;
+}
+
+int32 FInventory::Remove(FItemId Item, int32 Count)
+{
+	if (Item == NoItem || Count <= 0)
+	{
+		return 0;
+	}
+
+	int32 Remaining = Count;
+	for (int32 SlotIndex = NumSlots - 1; SlotIndex >= 0 && Remaining > 0; --SlotIndex)
+	{
+		FInventorySlot& Slot = Slots[SlotIndex];
+		if (Slot.Item == Item)
+		{
+			const int32 Removed = FMath::Min(Remaining, static_cast<int32>(Slot.Count));
+			Slot.Count -= static_cast<uint16>(Removed);
+			Remaining -= Removed;
+			if (Slot.Count == 0)
+			{
+				Slot.Item = NoItem;
+			}
+		}
+	}
+
+	return Count - Remaining;
+}
+
+int32 FInventory::CountOf(FItemId Item) const
+{
+	if (Item == NoItem)
+	{
+		return 0;
+	}
+
+	int32 Total = 0;
+	for (const FInventorySlot& Slot : Slots)
+	{
+		if (Slot.Item == Item)
+		{
+			Total += Slot.Count;
+		}
+	}
+	return Total;
+}
+
+FItemId FInventory::Use(const FItemTable& Items, int32 SlotIndex)
+{
+	if (SlotIndex < 0 || SlotIndex >= NumSlots)
+	{
+		return NoItem;
+	}
+
+	FInventorySlot& Slot = Slots[SlotIndex];
+	if (!Items.IsValid(Slot.Item))
+	{
+		return NoItem;
+	}
+
+	const EItemKind Kind = Items.Get(Slot.Item).Kind;
+	if (Kind != EItemKind::Consumable && Kind != EItemKind::Bait)
+	{
+		return NoItem;
+	}
+
+	const FItemId Used = Slot.Item;
+	if (--Slot.Count == 0)
+	{
+		Slot.Item = NoItem;
+	}
+	return Used;
+}
+
+void FInventory::Reset()
+{
+	for (FInventorySlot& Slot : Slots)
+	{
+		Slot = FInventorySlot();
+	}
+}
@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "ItemTable.h"
+
+/** A stack of one item; an empty slot holds NoItem */
+struct FInventorySlot
+{
+	FItemId Item = NoItem;
+	uint16 Count = 0;
+};
+
+/**
+ * Fixed-capacity item slots stored inline: sixteen four-byte slots fill a single cache line, so no operation
+ * allocates or follows a pointer other than the shared FItemTable lookup for stack limits.
+ */
+class NIGHT_FISHERMAN_API FInventory
+{
+public:
+	static constexpr int32 NumSlots = 16;
+
+	/** Adds up to Count of Item, topping up existing stacks before filling empty slots. Returns how many were added. */
+	int32 Add(const FItemTable& Items, FItemId Item, int32 Count = 1);
+
+	/** Removes up to Count of Item, from the last slot backwards. Returns how many were removed. */
+	int32 Remove(FItemId Item, int32 Count = 1);
+
+	/** Total of Item across every slot */
+	int32 CountOf(FItemId Item) const;
+
+	/** Consumes one item from SlotIndex if it is consumable or bait, returning the item used or NoItem */
+	FItemId Use(const FItemTable& Items, int32 SlotIndex);
+
+	/** Empties every slot */
+	void Reset();
+
+	const FInventorySlot& GetSlot(int32 SlotIndex) const { return Slots[SlotIndex]; }
+
+private:
+	TStaticArray<FInventorySlot, NumSlots> Slots;
+};
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Inventory.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	static void RunInventoryBenchmark(const TArray<FString>& Args)
+	{
+		static const int32 CharacterCounts[] = { 16, 64, 256, 1024, 4096 };
+		const int32 OpsPerFrame = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10000, 1);
+		const int32 NumFrames = FMath::Max(Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 60, 1);
+		constexpr int32 NumItems = 64;
+
+		FItemTable Items;
+		for (int32 Index = 0; Index < NumItems; ++Index)
+		{
+			const EItemKind Kind = Index % 3 == 0 ? EItemKind::Consumable : Index % 3 == 1 ? EItemKind::Bait : EItemKind::Misc;
+			Items.Add(FName(TEXT("BenchmarkItem"), Index), Kind, 1 + Index % 20);
+		}
+
+		enum class EOp : uint8
+		{
+			Add,
+			Remove,
+			Count,
+			Use,
+		};
+
+		struct FOp
+		{
+			EOp Op;
+			uint8 Amount;
+			FItemId Item;
+			int32 Inventory;
+		};
+
+		FCsvWriter Csv(TEXT("Inventory"), { TEXT("Characters"), TEXT("OpsPerFrame"), TEXT("MsPerFrame"), TEXT("NsPerOp"), TEXT("Allocations"), TEXT("BytesPerInventory") });
+
+		for (const int32 NumCharacters : CharacterCounts)
+		{
+			TArray<FInventory> Inventories;
+			Inventories.SetNum(NumCharacters);
+
+			// Pickups and catches dominate, then removal, lookups and use; generated up front so only the inventory is timed
+			FRandomStream Random(NumCharacters);
+			TArray<FOp> Ops;
+			Ops.Reserve(OpsPerFrame);
+			for (int32 Index = 0; Index < OpsPerFrame; ++Index)
+			{
+				const int32 Roll = Random.RandRange(0, 99);
+				const EOp Op = Roll < 40 ? EOp::Add : Roll < 65 ? EOp::Remove : Roll < 85 ? EOp::Count : EOp::Use;
+				Ops.Add({ Op, static_cast<uint8>(Random.RandRange(1, 5)), static_cast<FItemId>(Random.RandRange(1, Items.Num())), Random.RandRange(0, NumCharacters - 1) });
+			}
+
+			int64 Checksum = 0;
+			auto RunFrame = [&]
+			{
+				for (const FOp& Op : Ops)
+				{
+					FInventory& Inventory = Inventories[Op.Inventory];
+					switch (Op.Op)
+					{
+					case EOp::Add:
+						Checksum += Inventory.Add(Items, Op.Item, Op.Amount);
+						break;
+					case EOp::Remove:
+						Checksum += Inventory.Remove(Op.Item, Op.Amount);
+						break;
+					case EOp::Count:
+						Checksum += Inventory.CountOf(Op.Item);
+						break;
+					case EOp::Use:
+						Checksum += Inventory.Use(Items, Op.Item % FInventory::NumSlots);
+						break;
+					}
+				}
+			};
+
+			RunFrame();
+
+			FScopedAllocationCounter Allocations;
+			const double FrameMs = TimeAverageMs(NumFrames, RunFrame);
+			const uint64 NumAllocations = Allocations.GetAllocations();
+
+			Csv.AddRow(NumCharacters, OpsPerFrame, FrameMs, FrameMs * 1.0e6 / OpsPerFrame, NumAllocations, static_cast<int32>(sizeof(FInventory)));
+
+			UE_LOG(LogNightFisherman, Display, TEXT("Inventory %4d characters: %.3f ms for %d ops (%.1f ns/op), %llu allocations, checksum %lld"),
+				NumCharacters, FrameMs, OpsPerFrame, FrameMs * 1.0e6 / OpsPerFrame, NumAllocations, Checksum);
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommand InventoryBenchmarkCommand(
+		TEXT("NF.Benchmark.Inventory"),
+		TEXT("Times a mix of item adds, removes, counts and uses spread over 16 to 4096 inventories and writes Inventory.csv. Usage: NF.Benchmark.Inventory [OpsPerFrame=10000] [Frames=60]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunInventoryBenchmark));
+}
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InventoryComponent.h"
+#include "ItemTableSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+UInventoryComponent::UInventoryComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	if (const UItemTableSubsystem* ItemTable = GameInstance ? GameInstance->GetSubsystem<UItemTableSubsystem>() : nullptr)
+	{
+		Items = &ItemTable->GetItems();
+	}
+}
+
+int32 UInventoryComponent::AddItem(FItemId Item, int32 Count)
+{
+	return Items ? Inventory.Add(*Items, Item, Count) : 0;
+}
+
+int32 UInventoryComponent::RemoveItem(FItemId Item, int32 Count)
+{
+	return Inventory.Remove(Item, Count);
+}
+
+int32 UInventoryComponent::GetItemCount(FItemId Item) const
+{
+	return Inventory.CountOf(Item);
+}
+
+FItemId UInventoryComponent::UseSelectedItem()
+{
+	return Items ? Inventory.Use(*Items, SelectedSlot) : NoItem;
+}
+
+int32 UInventoryComponent::AddItemByName(FName ItemName, int32 Count)
+{
+	return Items ? AddItem(Items->FindByName(ItemName), Count) : 0;
+}
+
+int32 UInventoryComponent::GetItemCountByName(FName ItemName) const
+{
+	return Items ? GetItemCount(Items->FindByName(ItemName)) : 0;
+}
+
+void UInventoryComponent::SelectSlot(int32 SlotIndex)
+{
+	SelectedSlot = FMath::Clamp(SlotIndex, 0, FInventory::NumSlots - 1);
+}
@@ -0,0 +1,62 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Inventory.h"
+#include "InventoryComponent.generated.h"
+
+/**
+ * An actor's items, held in an FInventory and sized up front. Native callers address items by FItemId;
+ * the by-name functions are for Blueprint and resolve the name with a table search first.
+ */
+UCLASS(ClassGroup = (Inventory), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryComponent();
+
+	/** Returns how many of Count were added */
+	int32 AddItem(FItemId Item, int32 Count = 1);
+
+	/** Returns how many of Count were removed */
+	int32 RemoveItem(FItemId Item, int32 Count = 1);
+
+	int32 GetItemCount(FItemId Item) const;
+
+	/** Consumes one item from the selected slot if it can be used, returning the item used or NoItem */
+	FItemId UseSelectedItem();
+
+	/** Returns how many of Count were added */
+	UFUNCTION(BlueprintCallable, Category = Inventory)
+	int32 AddItemByName(FName ItemName, int32 Count = 1);
+
+	UFUNCTION(BlueprintPure, Category = Inventory)
+	int32 GetItemCountByName(FName ItemName) const;
+
+	/** Chooses the slot UseSelectedItem consumes from */
+	UFUNCTION(BlueprintCallable, Category = Inventory)
+	void SelectSlot(int32 SlotIndex);
+
+	UFUNCTION(BlueprintPure, Category = Inventory)
+	int32 GetSelectedSlot() const { return SelectedSlot; }
+
+	const FInventory& GetInventory() const { return Inventory; }
+
+	/** Shared item definitions, null until play begins */
+	const FItemTable* GetItemTable() const { return Items; }
+
+protected:
+	// UActorComponent implementation
+	virtual void BeginPlay() override;
+
+private:
+	FInventory Inventory;
+
+	const FItemTable* Items = nullptr;
+
+	int32 SelectedSlot = 0;
+};
@@ -0,0 +1,54 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ItemPickup.h"
+#include "InteractableComponent.h"
+#include "InventoryComponent.h"
+#include "ItemTableSubsystem.h"
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+AItemPickup::AItemPickup()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	Interactable = CreateDefaultSubobject<UInteractableComponent>(TEXT("Interactable"));
+	RootComponent = Interactable;
+}
+
+// Called when the game starts or when spawned
+void AItemPickup::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	if (const UItemTableSubsystem* ItemTable = GameInstance ? GameInstance->GetSubsystem<UItemTableSubsystem>() : nullptr)
+	{
+		Item = ItemTable->GetItems().FindByName(ItemName);
+	}
+
+	if (Item == NoItem)
+	{
+		UE_LOG(LogNightFisherman, Warning, TEXT("%s: %s is not in the item table"), *GetName(), *ItemName.ToString());
+		return;
+	}
+
+	Interactable->OnInteracted.AddDynamic(this, &AItemPickup::HandleInteracted);
+}
+
+void AItemPickup::HandleInteracted(AActor* Interactor)
+{
+	const ATopDownCharacter* Character = Cast<ATopDownCharacter>(Interactor);
+	UInventoryComponent* Inventory = Character ? Character->GetInventory() : nullptr;
+	if (!Inventory)
+	{
+		return;
+	}
+
+	Count -= Inventory->AddItem(Item, Count);
+	if (Count <= 0)
+	{
+		Destroy();
+	}
+}
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ItemTable.h"
+#include "ItemPickup.generated.h"
+
+class UInteractableComponent;
+
+/** Items lying in the world that go into the interacting character's inventory; destroyed once all are taken */
+UCLASS()
+class NIGHT_FISHERMAN_API AItemPickup : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AItemPickup();
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	UFUNCTION()
+	void HandleInteracted(AActor* Interactor);
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Interaction)
+	UInteractableComponent* Interactable;
+
+	/** Row name of the item in the item table */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory)
+	FName ItemName;
+
+	/** How many of the item are left */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory, meta = (ClampMin = "1"))
+	int32 Count = 1;
+
+private:
+	/** ItemName resolved against the item table at BeginPlay */
+	FItemId Item = NoItem;
+};
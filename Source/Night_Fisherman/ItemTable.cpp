@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ItemTable.h"
+#include "Night_Fisherman.h"
+
+FItemTable::FItemTable()
+{
+	Build(nullptr);
+}
+
+void FItemTable::Build(const UDataTable* Table)
+{
+	Entries.Reset();
+	Entries.Add({ NAME_None, 0, EItemKind::Misc });
+	for (FItemId& FishItem : FishItems)
+	{
+		FishItem = NoItem;
+	}
+
+	if (Table)
+	{
+		Table->ForeachRow<FItemDefinition>(TEXT("FItemTable::Build"), [this](const FName& Key, const FItemDefinition& Row)
+		{
+			const FItemId Item = Add(Key, Row.Kind, Row.MaxStack);
+			if (Item != NoItem && Row.Kind == EItemKind::Fish && FishItems[static_cast<int32>(Row.Species)] == NoItem)
+			{
+				FishItems[static_cast<int32>(Row.Species)] = Item;
+			}
+		});
+	}
+
+	// Every species must be catchable, even before the table lists it
+	for (int32 Species = 0; Species < static_cast<int32>(EFishSpecies::Count); ++Species)
+	{
+		if (FishItems[Species] == NoItem)
+		{
+			const FName Name(StaticEnum<EFishSpecies>()->GetNameStringByValue(Species));
+			FishItems[Species] = Add(Name, EItemKind::Fish, 99);
+		}
+	}
+}
+
+FItemId FItemTable::Add(FName Name, EItemKind Kind, int32 MaxStack)
+{
+	if (Entries.Num() > MAX_uint16)
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("Item table is full, dropping %s"), *Name.ToString());
+		return NoItem;
+	}
+
+	return static_cast<FItemId>(Entries.Add({ Name, static_cast<uint16>(FMath::Clamp(MaxStack, 1, MAX_uint16)), Kind }));
+}
+
+FItemId FItemTable::FindByName(FName Name) const
+{
+	for (int32 Index = 1; Index < Entries.Num(); ++Index)
+	{
+		if (Entries[Index].Name == Name)
+		{
+			return static_cast<FItemId>(Index);
+		}
+	}
+	return NoItem;
+}
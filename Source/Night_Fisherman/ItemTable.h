@@ -0,0 +1,89 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Engine/DataTable.h"
+#include "FishPopulation.h"
+#include "ItemTable.generated.h"
+
+/** Index of an item in FItemTable; 0 is no item */
+using FItemId = uint16;
+
+static constexpr FItemId NoItem = 0;
+
+UENUM(BlueprintType)
+enum class EItemKind : uint8
+{
+	Misc,
+	/** Used up by UseItem */
+	Consumable,
+	/** Used up by UseItem */
+	Bait,
+	/** Added to the inventory when a fish is caught */
+	Fish,
+};
+
+/** Row of the item data table the game loads at startup */
+USTRUCT(BlueprintType)
+struct NIGHT_FISHERMAN_API FItemDefinition : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory)
+	FText DisplayName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory)
+	EItemKind Kind = EItemKind::Misc;
+
+	/** Most of this item one inventory slot holds */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory, meta = (ClampMin = "1", ClampMax = "65535"))
+	int32 MaxStack = 1;
+
+	/** Species that adds this item when caught */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Inventory, meta = (EditCondition = "Kind == EItemKind::Fish"))
+	EFishSpecies Species = EFishSpecies::Perch;
+};
+
+/**
+ * Read-only item definitions flattened out of the item data table once at startup and shared by every inventory.
+ * Items are addressed by FItemId, a dense index, so lookups are an array access with no hashing or UObjects.
+ */
+class NIGHT_FISHERMAN_API FItemTable
+{
+public:
+	struct FEntry
+	{
+		FName Name;
+		uint16 MaxStack;
+		EItemKind Kind;
+	};
+
+	FItemTable();
+
+	/** Replaces every item with the rows of Table, in row order, then adds a fish item for any species without one */
+	void Build(const UDataTable* Table);
+
+	/** Adds an item, returning its id, or NoItem if the table is full */
+	FItemId Add(FName Name, EItemKind Kind, int32 MaxStack);
+
+	/** Linear search by row name, for resolving authored references once rather than on the hot path */
+	FItemId FindByName(FName Name) const;
+
+	/** Item added to the inventory when a fish of Species is caught */
+	FItemId GetFishItem(EFishSpecies Species) const { return FishItems[static_cast<int32>(Species)]; }
+
+	bool IsValid(FItemId Item) const { return Item != NoItem && Item < Entries.Num(); }
+
+	const FEntry& Get(FItemId Item) const { return Entries[Item]; }
+
+	/** Number of items, not counting NoItem */
+	int32 Num() const { return Entries.Num() - 1; }
+
+private:
+	/** Entries[0] is NoItem */
+	TArray<FEntry> Entries;
+
+	TStaticArray<FItemId, static_cast<int32>(EFishSpecies::Count)> FishItems;
+};
@@ -0,0 +1,19 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ItemTableSubsystem.h"
+#include "Night_Fisherman.h"
+
+void UItemTableSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const UDataTable* Table = ItemDataTable.IsNull() ? nullptr : ItemDataTable.LoadSynchronous();
+	if (Table && Table->GetRowStruct() != FItemDefinition::StaticStruct())
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("Item table %s does not use FItemDefinition rows"), *Table->GetPathName());
+		Table = nullptr;
+	}
+
+	Items.Build(Table);
+	UE_LOG(LogNightFisherman, Log, TEXT("Item table: %d items"), Items.Num());
+}
@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ItemTable.h"
+#include "ItemTableSubsystem.generated.h"
+
+/**
+ * Loads the item data table once per game instance and owns the FItemTable every inventory reads from.
+ * Set the table in DefaultGame.ini:
+ *   [/Script/Night_Fisherman.ItemTableSubsystem]
+ *   ItemDataTable=/Game/Game/Items/DT_Items.DT_Items
+ */
+UCLASS(Config = Game)
+class NIGHT_FISHERMAN_API UItemTableSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	const FItemTable& GetItems() const { return Items; }
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+private:
+	/** Data table of FItemDefinition rows; without one only the fish items exist */
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> ItemDataTable;
+
+	FItemTable Items;
+};
@@ -0,0 +1,42 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MovementBasisComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+
+UMovementBasisComponent::UMovementBasisComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UMovementBasisComponent::GetBasis(double Yaw, FVector& OutForward, FVector& OutRight)
+{
+	if (Yaw != CachedYaw)
+	{
+		// Same axes as FRotationMatrix(FRotator(0, Yaw, 0)) X and Y
+		double Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(Yaw));
+		CachedForward = FVector(Cos, Sin, 0.0);
+		CachedRight = FVector(-Sin, Cos, 0.0);
+		CachedYaw = Yaw;
+	}
+
+	OutForward = CachedForward;
+	OutRight = CachedRight;
+}
+
+void UMovementBasisComponent::AddMovementInput(const FVector2D& MovementVector)
+{
+	APawn* Pawn = GetOwner<APawn>();
+	AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+	if (!Controller)
+	{
+		return;
+	}
+
+	FVector ForwardDirection, RightDirection;
+	GetBasis(Controller->GetControlRotation().Yaw, ForwardDirection, RightDirection);
+
+	Pawn->AddMovementInput(ForwardDirection, MovementVector.Y);
+	Pawn->AddMovementInput(RightDirection, MovementVector.X);
+}
@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MovementBasisComponent.generated.h"
+
+/**
+ * Caches the yaw-only forward and right axes used to turn 2D move input into world directions.
+ * The axes are rebuilt only when the yaw changes, so player input and AI steering that share
+ * this path pay for a sin/cos pair per yaw change instead of two rotation matrices per event.
+ */
+UCLASS(ClassGroup = (Movement), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UMovementBasisComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMovementBasisComponent();
+
+	/** Returns the forward and right axes for Yaw (degrees), recomputing them only if Yaw changed */
+	void GetBasis(double Yaw, FVector& OutForward, FVector& OutRight);
+
+	/** Adds movement input to the owning pawn along its control yaw. X is right, Y is forward. */
+	void AddMovementInput(const FVector2D& MovementVector);
+
+private:
+	double CachedYaw = 0.0;
+	FVector CachedForward = FVector::ForwardVector;
+	FVector CachedRight = FVector::RightVector;
+};
@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MusicStreamer.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Sound/SoundWave.h"
+
+namespace NightFishermanBenchmark
+{
+	/**
+	 * Streams the music stems through FMusicStreamer as fast as it decodes, without an audio device, so it
+	 * runs headless (-nullrhi -nosound) and measures only the work the game pays for. The stems cycle through
+	 * calm, bite and fight every few seconds so the crossfades are exercised.
+	 */
+	static void RunMusicBenchmark(const TArray<FString>& Args)
+	{
+		static const TCHAR* StemKeys[] = { TEXT("CalmStem"), TEXT("BiteStem"), TEXT("FightStem") };
+		static_assert(UE_ARRAY_COUNT(StemKeys) == static_cast<int32>(EMusicStem::Count), "StemKeys must cover every EMusicStem");
+
+		const float AudioSeconds = FMath::Max(Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 60.0f, 1.0f);
+
+		// Stem paths come from the command line after the duration, or from the music subsystem's config
+		const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+		TArray<USoundWave*> Stems;
+		double LoadMs = 0.0;
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(StemKeys); ++Index)
+		{
+			FString Path;
+			if (Args.IsValidIndex(Index + 1))
+			{
+				Path = Args[Index + 1];
+			}
+			else
+			{
+				GConfig->GetString(TEXT("/Script/Night_Fisherman.MusicSubsystem"), StemKeys[Index], Path, GGameIni);
+			}
+
+			USoundWave* Stem = nullptr;
+			if (!Path.IsEmpty())
+			{
+				LoadMs += TimeAverageMs(1, [&] { Stem = LoadObject<USoundWave>(nullptr, *Path); });
+			}
+			Stems.Add(Stem);
+		}
+
+		FMusicStreamer Streamer;
+		if (!Streamer.Open(Stems))
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("Music benchmark: no stem could be streamed. Usage: NF.Benchmark.Music [Seconds=60] [CalmStem] [BiteStem] [FightStem]"));
+			return;
+		}
+
+		constexpr float LayerSeconds = 5.0f;
+		const int32 NumBlocks = FMath::CeilToInt32(AudioSeconds * Streamer.GetSampleRate() / FMusicStreamer::BlockFrames);
+		const int32 BlocksPerLayer = FMath::Max(FMath::RoundToInt32(LayerSeconds * Streamer.GetSampleRate() / FMusicStreamer::BlockFrames), 1);
+
+		TArray<int16> Pcm;
+		double PeakBlockMs = 0.0;
+		const double TotalMs = TimeAverageMs(1, [&]
+		{
+			for (int32 Block = 0; Block < NumBlocks; ++Block)
+			{
+				const int32 Layer = (Block / BlocksPerLayer) % 3;
+				Streamer.SetStemTarget(EMusicStem::Calm, 1.0f);
+				Streamer.SetStemTarget(EMusicStem::Bite, Layer >= 1 ? 1.0f : 0.0f);
+				Streamer.SetStemTarget(EMusicStem::Fight, Layer >= 2 ? 1.0f : 0.0f);
+
+				PeakBlockMs = FMath::Max(PeakBlockMs, TimeAverageMs(1, [&] { Streamer.MixBlock(Pcm); }));
+			}
+		});
+		const int64 ProcessDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(UsedPhysicalBefore);
+
+		int64 StemBytes = 0;
+		int32 NumStreamed = 0;
+		for (USoundWave* Stem : Stems)
+		{
+			if (Stem)
+			{
+				StemBytes += Stem->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+				NumStreamed += Stem->IsStreaming(nullptr) ? 1 : 0;
+			}
+		}
+
+		// What the game keeps resident: stems' non-streamed data, scratch, and the default quarter second queued for playback
+		const int64 QueueBytes = static_cast<int64>(0.25f * Streamer.GetSampleRate()) * Streamer.GetNumChannels() * sizeof(int16);
+		const double ResidentKB = (StemBytes + Streamer.GetAllocatedSize() + QueueBytes) / 1024.0;
+		const double DecodedSeconds = Streamer.GetDecodedAudioSeconds();
+		const double DecodeMsPerSecond = Streamer.GetDecodeSeconds() * 1000.0 / FMath::Max(DecodedSeconds, 1.0e-6);
+		const double MixMsPerSecond = TotalMs / FMath::Max(DecodedSeconds, 1.0e-6);
+
+		FCsvWriter Csv(TEXT("Music"), { TEXT("Stems"), TEXT("Streamed"), TEXT("LoadMs"), TEXT("AudioSeconds"), TEXT("DecodeMsPerAudioSecond"), TEXT("MixMsPerAudioSecond"), TEXT("PeakBlockMs"), TEXT("ResidentKB"), TEXT("ProcessDeltaKB") });
+		Csv.AddRow(Stems.FilterByPredicate([](const USoundWave* Stem) { return Stem != nullptr; }).Num(), NumStreamed, LoadMs, DecodedSeconds,
+			DecodeMsPerSecond, MixMsPerSecond, PeakBlockMs, ResidentKB, ProcessDeltaBytes / 1024.0);
+		Csv.Save();
+
+		UE_LOG(LogNightFisherman, Display, TEXT("Music: %d of the stems streamed, loaded in %.2f ms; %.1f s of audio decoded at %.2f ms per second (%.2f%% of a core), %.2f ms mixed, peak block %.3f ms; %.1f KB resident, process grew %.1f KB"),
+			NumStreamed, LoadMs, DecodedSeconds, DecodeMsPerSecond, DecodeMsPerSecond / 10.0, MixMsPerSecond, PeakBlockMs, ResidentKB, ProcessDeltaBytes / 1024.0);
+	}
+
+	static FAutoConsoleCommand MusicBenchmarkCommand(
+		TEXT("NF.Benchmark.Music"),
+		TEXT("Decodes and mixes the music stems without an audio device, reporting decode CPU and resident audio memory to Music.csv. Usage: NF.Benchmark.Music [Seconds=60] [CalmStem] [BiteStem] [FightStem]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunMusicBenchmark));
+}
@@ -0,0 +1,221 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MusicStreamer.h"
+#include "Night_Fisherman.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Sound/SoundWave.h"
+#include "Sound/SoundWaveProcedural.h"
+
+DECLARE_CYCLE_STAT(TEXT("Music Decode"), STAT_MusicDecode, STATGROUP_NightFisherman);
+
+namespace MusicStreamer
+{
+	/** How long the worker waits before checking the output queue again once it is full */
+	static constexpr float IdleSleepSeconds = 0.005f;
+}
+
+FMusicStreamer::FMusicStreamer() = default;
+
+FMusicStreamer::~FMusicStreamer()
+{
+	Shutdown();
+}
+
+bool FMusicStreamer::Open(TConstArrayView<USoundWave*> InStems)
+{
+	check(!Thread);
+
+	SampleRate = 0;
+	NumChannels = 0;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Stems); ++Index)
+	{
+		FStem& Stem = Stems[Index];
+		Stem.Reader.Reset();
+		Stem.Gain = 0.0f;
+
+		USoundWave* Wave = InStems.IsValidIndex(Index) ? InStems[Index] : nullptr;
+		if (!Wave)
+		{
+			continue;
+		}
+
+		if (!Wave->IsStreaming(nullptr))
+		{
+			UE_LOG(LogNightFisherman, Warning, TEXT("Music stem %s is not streamed and is loaded whole; set its Loading Behavior to Load on Demand"), *Wave->GetPathName());
+		}
+
+		FSoundWaveProxyPtr Proxy = Wave->CreateSoundWaveProxy();
+		Audio::FSoundWaveProxyReader::FSettings Settings;
+		Settings.MaxDecodeSizeInFrames = BlockFrames;
+		Settings.bIsLooping = true;
+		TUniquePtr<Audio::FSoundWaveProxyReader> Reader = Proxy.IsValid() ? Audio::FSoundWaveProxyReader::Create(Proxy.ToSharedRef(), Settings) : nullptr;
+		if (!Reader)
+		{
+			UE_LOG(LogNightFisherman, Warning, TEXT("Music stem %s cannot be decoded as a stream"), *Wave->GetPathName());
+			continue;
+		}
+
+		const int32 StemSampleRate = FMath::RoundToInt32(Reader->GetSampleRate());
+		if (NumChannels == 0)
+		{
+			SampleRate = StemSampleRate;
+			NumChannels = Reader->GetNumChannels();
+		}
+		else if (StemSampleRate != SampleRate || Reader->GetNumChannels() != NumChannels)
+		{
+			UE_LOG(LogNightFisherman, Warning, TEXT("Music stem %s is %d Hz, %d channels, the other stems %d Hz, %d channels"),
+				*Wave->GetPathName(), StemSampleRate, Reader->GetNumChannels(), SampleRate, NumChannels);
+			continue;
+		}
+
+		Stem.Reader = MoveTemp(Reader);
+		Stem.Decoded.SetNumUninitialized(BlockFrames * NumChannels);
+		Stem.Gain = Stem.TargetGain.load(std::memory_order_relaxed);
+	}
+
+	Mix.SetNumUninitialized(BlockFrames * NumChannels);
+	Pcm.SetNumUninitialized(BlockFrames * NumChannels);
+	return IsOpen();
+}
+
+void FMusicStreamer::Start(USoundWaveProcedural* InOutput, float BufferSeconds)
+{
+	check(!Thread);
+	if (!IsOpen() || !InOutput)
+	{
+		return;
+	}
+
+	Output = InOutput;
+	TargetQueuedBytes = FMath::Max(FMath::CeilToInt32(BufferSeconds * SampleRate), BlockFrames) * NumChannels * sizeof(int16);
+	bStopping = false;
+	Thread = FRunnableThread::Create(this, TEXT("NightFishermanMusic"), 0, TPri_AboveNormal);
+}
+
+void FMusicStreamer::Shutdown()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	Output = nullptr;
+
+	for (FStem& Stem : Stems)
+	{
+		Stem.Reader.Reset();
+	}
+	SampleRate = 0;
+	NumChannels = 0;
+}
+
+void FMusicStreamer::SetStemTarget(EMusicStem Stem, float Gain)
+{
+	Stems[static_cast<int32>(Stem)].TargetGain.store(FMath::Clamp(Gain, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+void FMusicStreamer::SetCrossfadeSeconds(float Seconds)
+{
+	CrossfadeSeconds.store(FMath::Max(Seconds, 0.0f), std::memory_order_relaxed);
+}
+
+void FMusicStreamer::MixBlock(TArray<int16>& OutPcm)
+{
+	const int32 NumSamples = BlockFrames * NumChannels;
+	FMemory::Memzero(Mix.GetData(), NumSamples * sizeof(float));
+
+	// Gains ramp linearly across the block so a crossfade never steps
+	const float Fade = CrossfadeSeconds.load(std::memory_order_relaxed);
+	const float MaxGainChange = Fade > 0.0f ? BlockFrames / (Fade * SampleRate) : 1.0f;
+
+	for (FStem& Stem : Stems)
+	{
+		if (!Stem.Reader)
+		{
+			continue;
+		}
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		int32 NumDecoded;
+		{
+			SCOPE_CYCLE_COUNTER(STAT_MusicDecode);
+			NumDecoded = Stem.Reader->PopAudio(Stem.Decoded);
+		}
+		DecodeCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+
+		const float StartGain = Stem.Gain;
+		const float EndGain = StartGain + FMath::Clamp(Stem.TargetGain.load(std::memory_order_relaxed) - StartGain, -MaxGainChange, MaxGainChange);
+		Stem.Gain = EndGain;
+		if (StartGain == 0.0f && EndGain == 0.0f)
+		{
+			continue;
+		}
+
+		const float GainStep = (EndGain - StartGain) / BlockFrames;
+		const float* RESTRICT Decoded = Stem.Decoded.GetData();
+		float* RESTRICT MixData = Mix.GetData();
+		const int32 NumValid = FMath::Min(NumDecoded, NumSamples);
+		for (int32 Sample = 0; Sample < NumValid; ++Sample)
+		{
+			MixData[Sample] += Decoded[Sample] * (StartGain + GainStep * (Sample / NumChannels));
+		}
+	}
+	DecodedFrames.fetch_add(BlockFrames, std::memory_order_relaxed);
+
+	OutPcm.SetNumUninitialized(NumSamples);
+	for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+	{
+		OutPcm[Sample] = static_cast<int16>(FMath::Clamp(Mix[Sample], -1.0f, 1.0f) * MAX_int16);
+	}
+}
+
+double FMusicStreamer::GetDecodeSeconds() const
+{
+	return FPlatformTime::ToSeconds64(DecodeCycles.load(std::memory_order_relaxed));
+}
+
+double FMusicStreamer::GetDecodedAudioSeconds() const
+{
+	return SampleRate > 0 ? static_cast<double>(DecodedFrames.load(std::memory_order_relaxed)) / SampleRate : 0.0;
+}
+
+SIZE_T FMusicStreamer::GetAllocatedSize() const
+{
+	SIZE_T Size = Mix.GetAllocatedSize() + Pcm.GetAllocatedSize();
+	for (const FStem& Stem : Stems)
+	{
+		Size += Stem.Decoded.GetAllocatedSize();
+	}
+	return Size;
+}
+
+uint32 FMusicStreamer::Run()
+{
+	bool bPrimed = false;
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		const int32 QueuedBytes = Output->GetAvailableAudioByteCount();
+		if (QueuedBytes >= TargetQueuedBytes)
+		{
+			bPrimed = true;
+			FPlatformProcess::SleepNoStats(MusicStreamer::IdleSleepSeconds);
+			continue;
+		}
+
+		if (bPrimed && QueuedBytes == 0)
+		{
+			NumUnderruns.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		MixBlock(Pcm);
+		Output->QueueAudio(reinterpret_cast<const uint8*>(Pcm.GetData()), Pcm.Num() * sizeof(int16));
+	}
+	return 0;
+}
+
+void FMusicStreamer::Stop()
+{
+	bStopping = true;
+}
@@ -0,0 +1,107 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Sound/SoundWaveProxyReader.h"
+#include <atomic>
+
+class FRunnableThread;
+class USoundWave;
+class USoundWaveProcedural;
+
+/** Layers of the score, each a looping stem of the same length and format */
+enum class EMusicStem : uint8
+{
+	Calm,
+	Bite,
+	Fight,
+	Count,
+};
+
+/**
+ * Plays layered music stems as one mix without ever holding a whole track in memory. Each stem is a streamed
+ * USoundWave decoded chunk by chunk with FSoundWaveProxyReader, so only the stream cache's chunks and a few
+ * blocks of PCM are resident.
+ *
+ * Once started, a worker thread decodes every stem in lockstep, mixes them with per-stem gains that ramp
+ * towards their targets and queues the result on a procedural sound wave, staying BufferSeconds ahead of
+ * playback. Nothing is decoded on the game thread. Silent stems are still decoded so they stay in sync.
+ */
+class NIGHT_FISHERMAN_API FMusicStreamer : public FRunnable
+{
+public:
+	/** Frames decoded and mixed per block */
+	static constexpr int32 BlockFrames = 1024;
+
+	FMusicStreamer();
+	virtual ~FMusicStreamer() override;
+
+	/**
+	 * Opens a decoder for each stem, indexed by EMusicStem; null stems stay silent. Stems that cannot be
+	 * streamed or do not match the first stem's format are skipped with a warning. Returns false if none opened.
+	 */
+	bool Open(TConstArrayView<USoundWave*> Stems);
+
+	/** Starts the worker thread feeding Output, which must outlive Shutdown */
+	void Start(USoundWaveProcedural* InOutput, float BufferSeconds);
+
+	/** Stops the worker thread and closes every decoder */
+	void Shutdown();
+
+	/** Volume a stem ramps towards, from any thread */
+	void SetStemTarget(EMusicStem Stem, float Gain);
+
+	/** Seconds a stem takes to ramp from silent to full volume */
+	void SetCrossfadeSeconds(float Seconds);
+
+	/** Decodes and mixes the next block into 16-bit interleaved PCM. Only call from one thread, and not once started. */
+	void MixBlock(TArray<int16>& OutPcm);
+
+	bool IsOpen() const { return NumChannels > 0; }
+	int32 GetSampleRate() const { return SampleRate; }
+	int32 GetNumChannels() const { return NumChannels; }
+
+	/** Seconds of CPU spent decoding, and seconds of audio decoded */
+	double GetDecodeSeconds() const;
+	double GetDecodedAudioSeconds() const;
+
+	/** Times the output ran dry while playing */
+	int32 GetNumUnderruns() const { return NumUnderruns.load(std::memory_order_relaxed); }
+
+	/** Decode and mix scratch held by the streamer, excluding the stream cache and the output's queue */
+	SIZE_T GetAllocatedSize() const;
+
+	// FRunnable implementation
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FStem
+	{
+		TUniquePtr<Audio::FSoundWaveProxyReader> Reader;
+		Audio::FAlignedFloatBuffer Decoded;
+		std::atomic<float> TargetGain{ 0.0f };
+		/** Only touched by whichever thread mixes */
+		float Gain = 0.0f;
+	};
+
+	FStem Stems[static_cast<int32>(EMusicStem::Count)];
+
+	int32 SampleRate = 0;
+	int32 NumChannels = 0;
+	std::atomic<float> CrossfadeSeconds{ 1.0f };
+
+	Audio::FAlignedFloatBuffer Mix;
+	TArray<int16> Pcm;
+
+	USoundWaveProcedural* Output = nullptr;
+	int32 TargetQueuedBytes = 0;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{ false };
+
+	std::atomic<uint64> DecodeCycles{ 0 };
+	std::atomic<uint64> DecodedFrames{ 0 };
+	std::atomic<int32> NumUnderruns{ 0 };
+};
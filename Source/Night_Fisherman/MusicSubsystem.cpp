@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MusicSubsystem.h"
+#include "BiteSubsystem.h"
+#include "FishingLineSubsystem.h"
+#include "FishPopulationSubsystem.h"
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "Components/AudioComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundWave.h"
+#include "Sound/SoundWaveProcedural.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Music Resident KB"), STAT_MusicResidentKB, STATGROUP_NightFisherman);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Music Underruns"), STAT_MusicUnderruns, STATGROUP_NightFisherman);
+
+static TAutoConsoleVariable<float> CVarMusicCrossfade(
+	TEXT("NF.Music.Crossfade"),
+	1.5f,
+	TEXT("Seconds a music stem takes to fade fully in or out."));
+
+static TAutoConsoleVariable<float> CVarMusicBufferSeconds(
+	TEXT("NF.Music.BufferSeconds"),
+	0.25f,
+	TEXT("Seconds of mixed music decoded ahead of playback. Read when the music starts."));
+
+int64 UMusicSubsystem::GetResidentBytes() const
+{
+	int64 Bytes = Streamer.GetAllocatedSize();
+	for (USoundWave* Stem : Stems)
+	{
+		if (Stem)
+		{
+			Bytes += Stem->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+	}
+	if (Output)
+	{
+		Bytes += Output->GetAvailableAudioByteCount();
+	}
+	return Bytes;
+}
+
+void UMusicSubsystem::Deinitialize()
+{
+	if (StemsHandle.IsValid())
+	{
+		StemsHandle->CancelHandle();
+		StemsHandle.Reset();
+	}
+
+	// The worker feeds Output, so it stops before anything it touches goes away
+	Streamer.Shutdown();
+	if (AudioComponent)
+	{
+		AudioComponent->Stop();
+		AudioComponent = nullptr;
+	}
+	Output = nullptr;
+	Stems.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UMusicSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UMusicSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TArray<FSoftObjectPath> Paths;
+	for (const TSoftObjectPtr<USoundWave>* Stem : { &CalmStem, &BiteStem, &FightStem })
+	{
+		if (!Stem->IsNull())
+		{
+			Paths.Add(Stem->ToSoftObjectPath());
+		}
+	}
+	if (!Paths.IsEmpty())
+	{
+		StemsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths, FStreamableDelegate::CreateUObject(this, &UMusicSubsystem::HandleStemsLoaded));
+	}
+}
+
+void UMusicSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!Streamer.IsOpen())
+	{
+		return;
+	}
+
+	// Layers follow the local player's fishing: a line in the water, then a fish on it; every query is a lookup
+	const UWorld* World = GetWorld();
+	const ATopDownCharacter* Player = Cast<ATopDownCharacter>(UGameplayStatics::GetPlayerPawn(World, 0));
+	const UFishingLineSubsystem* Lines = World->GetSubsystem<UFishingLineSubsystem>();
+	const UFishPopulationSubsystem* FishPopulation = World->GetSubsystem<UFishPopulationSubsystem>();
+	const UBiteSubsystem* Bites = World->GetSubsystem<UBiteSubsystem>();
+	const bool bLineCast = Player && ((Lines && Lines->HasLine(Player)) || (FishPopulation && FishPopulation->HasLineCast(Player)));
+	const bool bHooked = Player && Bites && Bites->IsHooked(Player->GetBiteLine());
+
+	Streamer.SetCrossfadeSeconds(CVarMusicCrossfade.GetValueOnGameThread());
+	Streamer.SetStemTarget(EMusicStem::Calm, 1.0f);
+	Streamer.SetStemTarget(EMusicStem::Bite, bLineCast ? 1.0f : 0.0f);
+	Streamer.SetStemTarget(EMusicStem::Fight, bHooked ? 1.0f : 0.0f);
+
+	SET_DWORD_STAT(STAT_MusicResidentKB, static_cast<uint32>(GetResidentBytes() / 1024));
+	SET_DWORD_STAT(STAT_MusicUnderruns, Streamer.GetNumUnderruns());
+}
+
+TStatId UMusicSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMusicSubsystem, STATGROUP_Tickables);
+}
+
+void UMusicSubsystem::OnPaused()
+{
+	if (AudioComponent)
+	{
+		AudioComponent->SetPaused(true);
+	}
+}
+
+void UMusicSubsystem::OnResumed()
+{
+	if (AudioComponent)
+	{
+		AudioComponent->SetPaused(false);
+	}
+}
+
+void UMusicSubsystem::HandleStemsLoaded()
+{
+	StemsHandle.Reset();
+
+	Stems = { CalmStem.Get(), BiteStem.Get(), FightStem.Get() };
+	if (!Streamer.Open(ObjectPtrDecay(Stems)))
+	{
+		UE_LOG(LogNightFisherman, Warning, TEXT("Music: no stem could be streamed, the level plays without music"));
+		return;
+	}
+
+	Output = NewObject<USoundWaveProcedural>(this);
+	Output->SetSampleRate(Streamer.GetSampleRate());
+	Output->NumChannels = Streamer.GetNumChannels();
+	Output->Duration = INDEFINITELY_LOOPING_DURATION;
+	Output->SoundGroup = SOUNDGROUP_Music;
+	Output->bLooping = false;
+
+	AudioComponent = UGameplayStatics::CreateSound2D(GetWorld(), Output, 1.0f, 1.0f, 0.0f, nullptr, false, false);
+	if (!AudioComponent)
+	{
+		Streamer.Shutdown();
+		return;
+	}
+
+	Streamer.SetCrossfadeSeconds(CVarMusicCrossfade.GetValueOnGameThread());
+	Streamer.SetStemTarget(EMusicStem::Calm, 1.0f);
+	Streamer.Start(Output, CVarMusicBufferSeconds.GetValueOnGameThread());
+	AudioComponent->Play();
+	if (IsSuspended())
+	{
+		AudioComponent->SetPaused(true);
+	}
+
+	UE_LOG(LogNightFisherman, Log, TEXT("Music: %d Hz, %d channels, %.1f KB resident"), Streamer.GetSampleRate(), Streamer.GetNumChannels(), GetResidentBytes() / 1024.0);
+}
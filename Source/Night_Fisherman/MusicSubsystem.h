@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "MusicStreamer.h"
+#include "MusicSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundWave;
+class USoundWaveProcedural;
+struct FStreamableHandle;
+
+/**
+ * Plays the score as three layered stems mixed by an FMusicStreamer. The calm stem always plays; the bite
+ * stem fades in while the player has a line in the water and the fight stem while a fish is on it.
+ *
+ * Stems load asynchronously once the world begins play, so starting a level never waits on them, and are
+ * decoded on the streamer's worker thread. Set them in DefaultGame.ini, imported with Loading Behavior
+ * set to Load on Demand:
+ *   [/Script/Night_Fisherman.MusicSubsystem]
+ *   CalmStem=/Game/Audio/Music/NightFishy_Calm.NightFishy_Calm
+ *   BiteStem=/Game/Audio/Music/NightFishy_Bite.NightFishy_Bite
+ *   FightStem=/Game/Audio/Music/NightFishy_Fight.NightFishy_Fight
+ */
+UCLASS(Config = Game)
+class NIGHT_FISHERMAN_API UMusicSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Bytes of audio held for the music: stem headers and resident chunks, decode scratch and queued PCM */
+	int64 GetResidentBytes() const;
+
+	const FMusicStreamer& GetStreamer() const { return Streamer; }
+
+	// USubsystem implementation
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	// UPausableWorldSubsystem implementation
+	virtual void OnPaused() override;
+	virtual void OnResumed() override;
+
+private:
+	void HandleStemsLoaded();
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<USoundWave> CalmStem;
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<USoundWave> BiteStem;
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<USoundWave> FightStem;
+
+	/** Loaded stems, indexed by EMusicStem */
+	UPROPERTY()
+	TArray<TObjectPtr<USoundWave>> Stems;
+
+	UPROPERTY()
+	TObjectPtr<USoundWaveProcedural> Output;
+
+	UPROPERTY()
+	TObjectPtr<UAudioComponent> AudioComponent;
+
+	TSharedPtr<FStreamableHandle> StemsHandle;
+
+	FMusicStreamer Streamer;
+};
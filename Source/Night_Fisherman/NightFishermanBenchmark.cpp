@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NightFishermanBenchmark.h"
+#include "Night_Fisherman.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+namespace NightFishermanBenchmark
+{
+	std::atomic<bool> FFrameCounters::bRecording(false);
+	std::atomic<uint64> FFrameCounters::CharacterTickCycles(0);
+	std::atomic<uint32> FFrameCounters::CharacterTicks(0);
+	std::atomic<uint32> FFrameCounters::CameraTransformUpdates(0);
+
+	void FFrameCounters::Reset()
+	{
+		CharacterTickCycles.store(0, std::memory_order_relaxed);
+		CharacterTicks.store(0, std::memory_order_relaxed);
+		CameraTransformUpdates.store(0, std::memory_order_relaxed);
+	}
+
+	FCsvWriter::FCsvWriter(const FString& InName, const TArray<FString>& InColumns)
+		: Name(InName)
+		, Columns(InColumns)
+	{
+	}
+
+	void FCsvWriter::AddRowValues(const TArray<FString>& Values)
+	{
+		ensureMsgf(Values.Num() == Columns.Num(), TEXT("Benchmark %s: row has %d values, expected %d"), *Name, Values.Num(), Columns.Num());
+		Rows.Add(FString::Join(Values, TEXT(",")));
+	}
+
+	FString FCsvWriter::Save() const
+	{
+		FString OutputPath;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("BenchmarkDir="), OutputPath))
+		{
+			OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks");
+		}
+		OutputPath = FPaths::ConvertRelativePathToFull(OutputPath / Name + TEXT(".csv"));
+
+		TArray<FString> Lines;
+		Lines.Reserve(Rows.Num() + 1);
+		Lines.Add(FString::Join(Columns, TEXT(",")));
+		Lines.Append(Rows);
+
+		if (!FFileHelper::SaveStringArrayToFile(Lines, *OutputPath))
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("Benchmark %s: failed to write %s"), *Name, *OutputPath);
+			return FString();
+		}
+
+		UE_LOG(LogNightFisherman, Display, TEXT("Benchmark %s: wrote %d rows to %s"), *Name, Rows.Num(), *OutputPath);
+		return OutputPath;
+	}
+
+	namespace Private
+	{
+		std::atomic<uint64> AllocationCount(0);
+		std::atomic<uint64> AllocatedBytes(0);
+
+		/** Forwards to the real allocator, counting calls on the way through */
+		class FCountingMalloc final : public FMalloc
+		{
+		public:
+			explicit FCountingMalloc(FMalloc* InInner)
+				: Inner(InInner)
+			{
+			}
+
+			FMalloc* GetInner() const { return Inner; }
+
+			virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+			{
+				Count(Size);
+				return Inner->Malloc(Size, Alignment);
+			}
+
+			virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+			{
+				Count(Size);
+				return Inner->TryMalloc(Size, Alignment);
+			}
+
+			virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+			{
+				Count(Size);
+				return Inner->Realloc(Original, Size, Alignment);
+			}
+
+			virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+			{
+				Count(Size);
+				return Inner->TryRealloc(Original, Size, Alignment);
+			}
+
+			virtual void Free(void* Original) override
+			{
+				Inner->Free(Original);
+			}
+
+			virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override
+			{
+				return Inner->QuantizeSize(Size, Alignment);
+			}
+
+			virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+			{
+				return Inner->GetAllocationSize(Original, SizeOut);
+			}
+
+			virtual void Trim(bool bTrimThreadCaches) override
+			{
+				Inner->Trim(bTrimThreadCaches);
+			}
+
+			virtual void SetupTLSCachesOnCurrentThread() override
+			{
+				Inner->SetupTLSCachesOnCurrentThread();
+			}
+
+			virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+			{
+				Inner->ClearAndDisableTLSCachesOnCurrentThread();
+			}
+
+			virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override
+			{
+				Inner->GetAllocatorStats(OutStats);
+			}
+
+			virtual void DumpAllocatorStats(FOutputDevice& Ar) override
+			{
+				Inner->DumpAllocatorStats(Ar);
+			}
+
+			virtual bool IsInternallyThreadSafe() const override
+			{
+				return Inner->IsInternallyThreadSafe();
+			}
+
+			virtual bool ValidateHeap() override
+			{
+				return Inner->ValidateHeap();
+			}
+
+			virtual const TCHAR* GetDescriptiveName() override
+			{
+				return Inner->GetDescriptiveName();
+			}
+
+		private:
+			static void Count(SIZE_T Size)
+			{
+				AllocationCount.fetch_add(1, std::memory_order_relaxed);
+				AllocatedBytes.fetch_add(Size, std::memory_order_relaxed);
+			}
+
+			FMalloc* Inner;
+		};
+
+		// The proxy is never freed: another thread may still hold the pointer after it is uninstalled
+		FCountingMalloc* CountingMalloc = nullptr;
+		int32 ScopeDepth = 0;
+	}
+
+	FScopedAllocationCounter::FScopedAllocationCounter()
+	{
+		check(IsInGameThread());
+		if (Private::ScopeDepth++ == 0)
+		{
+			if (!Private::CountingMalloc)
+			{
+				Private::CountingMalloc = new Private::FCountingMalloc(GMalloc);
+			}
+			GMalloc = Private::CountingMalloc;
+		}
+
+		StartAllocations = Private::AllocationCount.load(std::memory_order_relaxed);
+		StartBytes = Private::AllocatedBytes.load(std::memory_order_relaxed);
+	}
+
+	FScopedAllocationCounter::~FScopedAllocationCounter()
+	{
+		check(IsInGameThread());
+		if (--Private::ScopeDepth == 0)
+		{
+			GMalloc = Private::CountingMalloc->GetInner();
+		}
+	}
+
+	uint64 FScopedAllocationCounter::GetAllocations() const
+	{
+		return Private::AllocationCount.load(std::memory_order_relaxed) - StartAllocations;
+	}
+
+	uint64 FScopedAllocationCounter::GetAllocatedBytes() const
+	{
+		return Private::AllocatedBytes.load(std::memory_order_relaxed) - StartBytes;
+	}
+}
@@ -0,0 +1,138 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+class UWorld;
+
+namespace NightFishermanBenchmark
+{
+	/** Collects benchmark rows and writes them as CSV under Saved/Benchmarks */
+	class NIGHT_FISHERMAN_API FCsvWriter
+	{
+	public:
+		FCsvWriter(const FString& InName, const TArray<FString>& InColumns);
+
+		/** Appends one row; values are converted with LexToString */
+		template <typename... ArgTypes>
+		void AddRow(const ArgTypes&... Args)
+		{
+			AddRowValues({ LexToString(Args)... });
+		}
+
+		/** Appends one row of already formatted values */
+		void AddRowValues(const TArray<FString>& Values);
+
+		/** Writes the file, returning the full path or an empty string on failure */
+		FString Save() const;
+
+		int32 NumRows() const { return Rows.Num(); }
+
+		/** Renames the file Save writes, e.g. once the rows of a recording have a name */
+		void SetName(const FString& InName) { Name = InName; }
+
+	private:
+		FString Name;
+		TArray<FString> Columns;
+		TArray<FString> Rows;
+	};
+
+	/**
+	 * Counts every allocation routed through GMalloc while in scope by wrapping it in a forwarding proxy.
+	 * Scopes may nest; the proxy is only installed by the outermost one.
+	 */
+	class NIGHT_FISHERMAN_API FScopedAllocationCounter
+	{
+	public:
+		FScopedAllocationCounter();
+		~FScopedAllocationCounter();
+
+		/** Allocations (Malloc and Realloc calls) seen since this scope started */
+		uint64 GetAllocations() const;
+
+		/** Bytes requested since this scope started */
+		uint64 GetAllocatedBytes() const;
+
+	private:
+		uint64 StartAllocations;
+		uint64 StartBytes;
+	};
+
+	/** Counters bumped by gameplay code while a benchmark is recording */
+	struct NIGHT_FISHERMAN_API FFrameCounters
+	{
+		static std::atomic<bool> bRecording;
+		static std::atomic<uint64> CharacterTickCycles;
+		static std::atomic<uint32> CharacterTicks;
+		static std::atomic<uint32> CameraTransformUpdates;
+
+		static void Reset();
+	};
+
+	/** Adds the cycles spent in its scope to the character tick counters */
+	struct FScopedCharacterTick
+	{
+		FScopedCharacterTick()
+			: StartCycles(FFrameCounters::bRecording.load(std::memory_order_relaxed) ? FPlatformTime::Cycles64() : 0)
+		{
+		}
+
+		~FScopedCharacterTick()
+		{
+			if (StartCycles != 0)
+			{
+				FFrameCounters::CharacterTickCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+				FFrameCounters::CharacterTicks.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		uint64 StartCycles;
+	};
+
+	/** Average milliseconds per call of Body over NumIterations */
+	template <typename BodyType>
+	double TimeAverageMs(int32 NumIterations, BodyType&& Body)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			Body();
+		}
+		return FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) / FMath::Max(NumIterations, 1);
+	}
+
+	/** A scripted workload that UBenchmarkSubsystem drives frame by frame */
+	class NIGHT_FISHERMAN_API FScenario
+	{
+	public:
+		virtual ~FScenario() = default;
+
+		/** Name used for the CSV file and log output */
+		virtual FString GetName() const = 0;
+
+		/** Spawns or configures whatever the scenario measures */
+		virtual void Setup(UWorld& World) {}
+
+		/** Feeds synthetic work for the upcoming frame */
+		virtual void PreFrame(UWorld& World, int32 FrameIndex, float DeltaTime) {}
+
+		/** Extra columns appended to every frame row */
+		virtual void GetExtraColumns(TArray<FString>& OutColumns) const {}
+
+		/** Values for the extra columns, sampled at the end of each frame */
+		virtual void GetExtraValues(TArray<FString>& OutValues) const {}
+
+		/** Releases anything Setup created */
+		virtual void Teardown(UWorld& World) {}
+	};
+}
+
+#if UE_BUILD_SHIPPING
+#define NF_BENCHMARK_CHARACTER_TICK_SCOPE()
+#else
+#define NF_BENCHMARK_CHARACTER_TICK_SCOPE() NightFishermanBenchmark::FScopedCharacterTick ANONYMOUS_VARIABLE(CharacterTickScope)
+#endif
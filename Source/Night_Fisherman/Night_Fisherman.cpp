@@ -3,4 +3,6 @@
 #include "Night_Fisherman.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogNightFisherman);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Night_Fisherman, "Night_Fisherman" );
@@ -4,3 +4,6 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogNightFisherman, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("NightFisherman"), STATGROUP_NightFisherman, STATCAT_Advanced);
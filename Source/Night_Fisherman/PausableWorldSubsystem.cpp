@@ -0,0 +1,45 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PausableWorldSubsystem.h"
+#include "PauseSubsystem.h"
+
+void UPausableWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PauseSubsystem = Collection.InitializeDependency<UPauseSubsystem>();
+	if (PauseSubsystem)
+	{
+		PauseChangedHandle = PauseSubsystem->OnPauseChanged.AddUObject(this, &UPausableWorldSubsystem::HandlePauseChanged);
+		bSuspended = PauseSubsystem->IsPaused();
+	}
+}
+
+void UPausableWorldSubsystem::Deinitialize()
+{
+	if (PauseSubsystem)
+	{
+		PauseSubsystem->OnPauseChanged.Remove(PauseChangedHandle);
+		PauseSubsystem = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+void UPausableWorldSubsystem::HandlePauseChanged(bool bPaused)
+{
+	if (bPaused == bSuspended)
+	{
+		return;
+	}
+
+	bSuspended = bPaused;
+	if (bPaused)
+	{
+		OnPaused();
+	}
+	else
+	{
+		OnResumed();
+	}
+}
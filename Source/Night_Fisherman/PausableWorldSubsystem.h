@@ -0,0 +1,46 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PausableWorldSubsystem.generated.h"
+
+class UPauseSubsystem;
+
+/**
+ * Tickable world subsystem that follows UPauseSubsystem: while the game is paused it is not ticked at all,
+ * and subclasses can release transient work in OnPaused. State is kept, so resuming carries on where it stopped.
+ */
+UCLASS(Abstract)
+class NIGHT_FISHERMAN_API UPausableWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	bool IsSuspended() const { return bSuspended; }
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject implementation
+	virtual bool IsTickable() const override { return !bSuspended; }
+
+protected:
+	/** Called when the game pauses, before the first skipped tick */
+	virtual void OnPaused() {}
+
+	/** Called when the game resumes, before the next tick */
+	virtual void OnResumed() {}
+
+private:
+	void HandlePauseChanged(bool bPaused);
+
+	UPROPERTY()
+	TObjectPtr<UPauseSubsystem> PauseSubsystem;
+
+	FDelegateHandle PauseChangedHandle;
+
+	bool bSuspended = false;
+};
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PauseSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+
+static TAutoConsoleVariable<float> CVarPauseMaxFPS(
+	TEXT("NF.Pause.MaxFPS"),
+	30.0f,
+	TEXT("Frame rate cap while the game is paused, so the pause menu idles cheaply. 0 leaves the cap unchanged."));
+
+bool UPauseSubsystem::SetPaused(bool bPaused)
+{
+	if (bPaused == bIsPaused)
+	{
+		return true;
+	}
+
+	UWorld* World = GetWorld();
+	if (!UGameplayStatics::SetGamePaused(World, bPaused))
+	{
+		return false;
+	}
+
+	bIsPaused = bPaused;
+
+	// Nothing new needs to come in while the player cannot move
+	World->bIsLevelStreamingFrozen = bPaused;
+
+	const float PausedMaxFPS = CVarPauseMaxFPS.GetValueOnGameThread();
+	if (bPaused && GEngine && PausedMaxFPS > 0.0f)
+	{
+		UnpausedMaxFPS = GEngine->GetMaxFPS();
+		GEngine->SetMaxFPS(UnpausedMaxFPS > 0.0f ? FMath::Min(UnpausedMaxFPS, PausedMaxFPS) : PausedMaxFPS);
+		bCappedMaxFPS = true;
+	}
+	else if (!bPaused && bCappedMaxFPS)
+	{
+		GEngine->SetMaxFPS(UnpausedMaxFPS);
+		bCappedMaxFPS = false;
+	}
+
+	UE_LOG(LogNightFisherman, Log, TEXT("Game %s"), bPaused ? TEXT("paused") : TEXT("resumed"));
+	OnPauseChanged.Broadcast(bPaused);
+	return true;
+}
+
+void UPauseSubsystem::Deinitialize()
+{
+	// Leave the engine frame rate cap as it was found
+	if (bCappedMaxFPS && GEngine)
+	{
+		GEngine->SetMaxFPS(UnpausedMaxFPS);
+	}
+	bCappedMaxFPS = false;
+	bIsPaused = false;
+
+	Super::Deinitialize();
+}
+
+bool UPauseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
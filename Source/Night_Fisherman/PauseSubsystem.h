@@ -0,0 +1,44 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PauseSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FPauseChangedSignature, bool /*bPaused*/);
+
+/**
+ * Single owner of the world's pause state. Pausing pauses the game through the game mode, freezes level
+ * streaming, caps the frame rate at NF.Pause.MaxFPS and tells every subscriber (see UPausableWorldSubsystem)
+ * to stop its own work. Resuming undoes each step; subscribers keep their state, so nothing is rebuilt.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UPauseSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Pauses or resumes everything; returns false if the game mode refused */
+	UFUNCTION(BlueprintCallable, Category = Pause)
+	bool SetPaused(bool bPaused);
+
+	UFUNCTION(BlueprintPure, Category = Pause)
+	bool IsPaused() const { return bIsPaused; }
+
+	/** Broadcast after the world has been paused or resumed */
+	FPauseChangedSignature OnPauseChanged;
+
+	// USubsystem implementation
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	bool bIsPaused = false;
+
+	/** Whether pausing lowered the frame rate cap, and the cap to restore on resume */
+	bool bCappedMaxFPS = false;
+	float UnpausedMaxFPS = 0.0f;
+};
@@ -0,0 +1,129 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PredictiveStreamingSourceComponent.h"
+#include "DashComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarStreamingPredictive(
+	TEXT("NF.Streaming.Predictive"),
+	true,
+	TEXT("Stream World Partition cells ahead of the player character instead of around the player's view."));
+
+/** APlayerController only exposes bEnableStreamingSource to Blueprint */
+static void SetControllerStreamingSourceEnabled(APlayerController& PlayerController, bool bEnabled)
+{
+	static const FBoolProperty* EnableProperty = FindFProperty<FBoolProperty>(APlayerController::StaticClass(), TEXT("bEnableStreamingSource"));
+	if (ensure(EnableProperty))
+	{
+		EnableProperty->SetPropertyValue_InContainer(&PlayerController, bEnabled);
+	}
+}
+
+UPredictiveStreamingSourceComponent::UPredictiveStreamingSourceComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UPredictiveStreamingSourceComponent::SetDash(UDashComponent* InDash)
+{
+	Dash = InDash;
+}
+
+void UPredictiveStreamingSourceComponent::SetPlayerController(APlayerController* InPlayerController)
+{
+	if (PlayerController.Get() == InPlayerController)
+	{
+		return;
+	}
+
+	UWorldPartitionSubsystem* WorldPartition = GetWorld() ? GetWorld()->GetSubsystem<UWorldPartitionSubsystem>() : nullptr;
+
+	if (PlayerController.IsValid())
+	{
+		SetControllerStreamingSourceEnabled(*PlayerController, bControllerSourceWasEnabled);
+	}
+	if (WorldPartition)
+	{
+		WorldPartition->UnregisterStreamingSourceProvider(this);
+	}
+
+	PlayerController = InPlayerController;
+
+	// Only worlds with World Partition have the subsystem; anything else keeps streaming as before
+	if (InPlayerController && WorldPartition)
+	{
+		bControllerSourceWasEnabled = InPlayerController->IsStreamingSourceEnabled();
+		SetControllerStreamingSourceEnabled(*InPlayerController, false);
+		WorldPartition->RegisterStreamingSourceProvider(this);
+	}
+}
+
+bool UPredictiveStreamingSourceComponent::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+	const AActor* Owner = GetOwner();
+	const APlayerController* Controller = PlayerController.Get();
+	if (!Owner || !Controller || !bControllerSourceWasEnabled)
+	{
+		return false;
+	}
+
+	FWorldPartitionStreamingSource& Source = OutStreamingSources.AddDefaulted_GetRef();
+	Source.Name = Owner->GetFName();
+	Source.TargetState = EStreamingSourceTargetState::Activated;
+	Source.Priority = EStreamingSourcePriority::Default;
+
+	if (!CVarStreamingPredictive.GetValueOnGameThread())
+	{
+		// What the controller would have streamed: the grids' loading range around the view
+		Controller->GetPlayerViewPoint(Source.Location, Source.Rotation);
+		return true;
+	}
+
+	FVector Ahead;
+	if (Dash && Dash->IsDashing())
+	{
+		Ahead = Dash->GetDashDirection() * (Dash->DashDistance / Dash->DashDuration * LookAheadSeconds);
+	}
+	else
+	{
+		const FVector Velocity = Owner->GetVelocity() * FVector(1.0, 1.0, 0.0);
+		const FVector Direction = FMath::Lerp(Velocity.GetSafeNormal(), Owner->GetActorForwardVector().GetSafeNormal2D(), FacingWeight).GetSafeNormal();
+		Ahead = Direction * (Velocity.Size() * LookAheadSeconds);
+	}
+
+	const double AheadDistance = FMath::Min(Ahead.Size(), static_cast<double>(MaxLookAheadDistance));
+	Source.Location = Owner->GetActorLocation();
+	Source.Rotation = Owner->GetActorRotation();
+	if (AheadDistance < UE_KINDA_SMALL_NUMBER)
+	{
+		return true;
+	}
+
+	const float Alpha = static_cast<float>(AheadDistance / MaxLookAheadDistance);
+	Source.Rotation = Ahead.Rotation();
+	Source.Location += Source.Rotation.Vector() * AheadDistance;
+
+	// Shapes are placed relative to the projected location, facing the direction of travel
+	FStreamingSourceShape& AheadShape = Source.Shapes.AddDefaulted_GetRef();
+	AheadShape.bUseGridLoadingRange = true;
+	AheadShape.LoadingRangeScale = FMath::Lerp(1.0f, AheadScale, Alpha);
+	AheadShape.bIsSector = AheadSectorAngle < 360.0f;
+	AheadShape.SectorAngle = AheadSectorAngle;
+
+	FStreamingSourceShape& BehindShape = Source.Shapes.AddDefaulted_GetRef();
+	BehindShape.bUseGridLoadingRange = true;
+	BehindShape.LoadingRangeScale = FMath::Lerp(1.0f, BehindScale, Alpha);
+	BehindShape.Location = FVector(-AheadDistance, 0.0, 0.0);
+
+	return true;
+}
+
+void UPredictiveStreamingSourceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetPlayerController(nullptr);
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "PredictiveStreamingSourceComponent.generated.h"
+
+class APlayerController;
+class UDashComponent;
+
+/**
+ * World Partition streaming source that leads its owner instead of following the player's view.
+ *
+ * The source sits where the owner will be LookAheadSeconds from now, moving along its velocity turned
+ * towards its facing, or along the dash while one is in progress. A half disc ahead of that point loads
+ * further than the grids' loading range and a circle around the owner loads less, both scaled by how far
+ * ahead the prediction reaches. A still owner gets the plain grid loading range.
+ *
+ * While it stands in for a player controller, that controller's own streaming source is switched off.
+ * NF.Streaming.Predictive 0 keeps the replacement but streams exactly like the controller would, for A/B runs.
+ */
+UCLASS(ClassGroup = (WorldPartition), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API UPredictiveStreamingSourceComponent : public UActorComponent, public IWorldPartitionStreamingSourceProvider
+{
+	GENERATED_BODY()
+
+public:
+	UPredictiveStreamingSourceComponent();
+
+	/** Seconds of movement the source projects ahead of the owner */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Streaming, meta = (ClampMin = "0.0"))
+	float LookAheadSeconds = 1.5f;
+
+	/** Furthest the source projects ahead; a projection this long gets the full AheadScale and BehindScale */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Streaming, meta = (ClampMin = "1.0"))
+	float MaxLookAheadDistance = 1500.0f;
+
+	/** How much the facing bends the projection away from the velocity (0-1) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Streaming, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float FacingWeight = 0.25f;
+
+	/** Loading range multiplier in the direction of travel at full projection */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Streaming, meta = (ClampMin = "1.0"))
+	float AheadScale = 1.5f;
+
+	/** Loading range multiplier around and behind the owner at full projection */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Streaming, meta = (ClampMin = "0.1", ClampMax = "1.0"))
+	float BehindScale = 0.75f;
+
+	/** Angle of the widened sector in the direction of travel */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Streaming, meta = (ClampMin = "1.0", ClampMax = "360.0"))
+	float AheadSectorAngle = 180.0f;
+
+	/** Sets the dash whose direction is followed while it is in progress */
+	void SetDash(UDashComponent* InDash);
+
+	/** Replaces the streaming source of PlayerController, or gives the previous one back when null */
+	void SetPlayerController(APlayerController* InPlayerController);
+
+	// IWorldPartitionStreamingSourceProvider implementation
+	virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+	virtual const UObject* GetStreamingSourceOwner() const override { return this; }
+
+protected:
+	// UActorComponent implementation
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY()
+	TObjectPtr<UDashComponent> Dash;
+
+	/** Controller whose streaming source is replaced */
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	/** Whether the controller's streaming source was enabled before it was replaced */
+	bool bControllerSourceWasEnabled = false;
+};
@@ -0,0 +1,162 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectilePool.h"
+#include "Night_Fisherman.h"
+#include "NightFishermanBenchmark.h"
+#include "PaperSpriteComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace NightFishermanBenchmark
+{
+	/** Peak resident memory and UObject count seen across calls to Sample */
+	struct FPeakTracker
+	{
+		FPeakTracker()
+			: BaseUsedPhysical(FPlatformMemory::GetStats().UsedPhysical)
+			, BaseObjects(GUObjectArray.GetObjectArrayNumMinusAvailable())
+		{
+		}
+
+		void Sample()
+		{
+			PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+			PeakObjects = FMath::Max(PeakObjects, GUObjectArray.GetObjectArrayNumMinusAvailable());
+		}
+
+		double GetPeakMB() const { return PeakUsedPhysical > BaseUsedPhysical ? (PeakUsedPhysical - BaseUsedPhysical) / (1024.0 * 1024.0) : 0.0; }
+		int32 GetPeakObjects() const { return FMath::Max(PeakObjects - BaseObjects, 0); }
+
+		uint64 BaseUsedPhysical;
+		uint64 PeakUsedPhysical = 0;
+		int32 BaseObjects;
+		int32 PeakObjects = 0;
+	};
+
+	/**
+	 * Fires the same stream of shots twice: once as spawned projectile actors destroyed when they expire,
+	 * as a SpawnActor based projectile would, and once through FProjectilePool. Each run is followed by a
+	 * full garbage collection so the cost of the churn it left behind is included.
+	 */
+	static void RunProjectileBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.Projectiles needs a game world"));
+			return;
+		}
+
+		const int32 NumFrames = FMath::Max(Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 600, 1);
+		const int32 ShotsPerFrame = FMath::Max(Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 16, 1);
+		constexpr int32 LifetimeFrames = 90;
+		constexpr float DeltaTime = 1.0f / 60.0f;
+		constexpr float Speed = 1200.0f;
+		const FVector FieldOrigin(0.0f, 0.0f, 100000.0f);
+
+		FCsvWriter Csv(TEXT("Projectiles"), { TEXT("Method"), TEXT("Frames"), TEXT("ShotsPerFrame"), TEXT("MsPerFrame"), TEXT("Allocations"), TEXT("AllocatedMB"), TEXT("PeakMB"), TEXT("PeakObjects"), TEXT("GCMs") });
+		auto Record = [&](const TCHAR* Method, double TotalMs, const FScopedAllocationCounter& Allocations, const FPeakTracker& Peak, double GcMs)
+		{
+			const double AllocatedMB = Allocations.GetAllocatedBytes() / (1024.0 * 1024.0);
+			Csv.AddRow(FString(Method), NumFrames, ShotsPerFrame, TotalMs / NumFrames, Allocations.GetAllocations(), AllocatedMB, Peak.GetPeakMB(), Peak.GetPeakObjects(), GcMs);
+			UE_LOG(LogNightFisherman, Display, TEXT("Projectiles %-10s %.3f ms/frame, %llu allocations (%.1f MB), peak +%.1f MB and +%d objects, GC %.2f ms"),
+				Method, TotalMs / NumFrames, Allocations.GetAllocations(), AllocatedMB, Peak.GetPeakMB(), Peak.GetPeakObjects(), GcMs);
+		};
+		auto CollectGarbageMs = []
+		{
+			return TimeAverageMs(1, [] { CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS); });
+		};
+
+		auto GetShotVelocity = [](int32 Frame, int32 Shot)
+		{
+			const float Angle = (Frame * 7 + Shot) * 0.37f;
+			return FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Speed;
+		};
+
+		// Pool
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		{
+			FProjectilePool Pool;
+			Pool.Initialize(ShotsPerFrame * LifetimeFrames);
+
+			FPeakTracker Peak;
+			FScopedAllocationCounter Allocations;
+			const double TotalMs = TimeAverageMs(1, [&]
+			{
+				for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+				{
+					for (int32 Shot = 0; Shot < ShotsPerFrame; ++Shot)
+					{
+						Pool.Spawn(FVector3f(FieldOrigin), FVector3f(GetShotVelocity(Frame, Shot)), LifetimeFrames * DeltaTime, 20.0f, 5.0f, nullptr, 0);
+					}
+					Pool.Step(DeltaTime);
+					Peak.Sample();
+				}
+			});
+			Record(TEXT("Pool"), TotalMs, Allocations, Peak, CollectGarbageMs());
+		}
+
+		// One actor per shot, destroyed when it expires
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		{
+			TArray<AActor*> LiveActors;
+			LiveActors.Reserve(ShotsPerFrame * (LifetimeFrames + 1));
+
+			FPeakTracker Peak;
+			FScopedAllocationCounter Allocations;
+			const double TotalMs = TimeAverageMs(1, [&]
+			{
+				for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+				{
+					for (int32 Shot = 0; Shot < ShotsPerFrame; ++Shot)
+					{
+						AActor* Actor = World->SpawnActor<AActor>();
+						USphereComponent* Sphere = NewObject<USphereComponent>(Actor);
+						Sphere->InitSphereRadius(20.0f);
+						Actor->SetRootComponent(Sphere);
+						Sphere->RegisterComponent();
+						Actor->SetActorLocation(FieldOrigin);
+
+						UPaperSpriteComponent* SpriteComponent = NewObject<UPaperSpriteComponent>(Actor);
+						SpriteComponent->SetupAttachment(Sphere);
+						SpriteComponent->RegisterComponent();
+
+						UProjectileMovementComponent* Movement = NewObject<UProjectileMovementComponent>(Actor);
+						Movement->ProjectileGravityScale = 0.0f;
+						Movement->Velocity = GetShotVelocity(Frame, Shot);
+						Movement->RegisterComponent();
+
+						LiveActors.Add(Actor);
+					}
+
+					if (LiveActors.Num() > ShotsPerFrame * LifetimeFrames)
+					{
+						for (int32 Index = 0; Index < ShotsPerFrame; ++Index)
+						{
+							LiveActors[Index]->Destroy();
+						}
+						LiveActors.RemoveAt(0, ShotsPerFrame, EAllowShrinking::No);
+					}
+					Peak.Sample();
+				}
+
+				for (AActor* Actor : LiveActors)
+				{
+					Actor->Destroy();
+				}
+			});
+			Record(TEXT("SpawnActor"), TotalMs, Allocations, Peak, CollectGarbageMs());
+		}
+
+		Csv.Save();
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs ProjectileBenchmarkCommand(
+		TEXT("NF.Benchmark.Projectiles"),
+		TEXT("Fires the same shots through the projectile pool and as spawned actors, comparing frame cost, allocations, peak memory and GC time, and writes Projectiles.csv. Usage: NF.Benchmark.Projectiles [Frames=600] [ShotsPerFrame=16]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunProjectileBenchmark));
+}
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectilePool.h"
+#include "Night_Fisherman.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Step"), STAT_ProjectileStep, STATGROUP_NightFisherman);
+
+void FProjectilePool::Initialize(int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 0);
+	NumDropped = 0;
+
+	Positions.Empty(Capacity);
+	Velocities.Empty(Capacity);
+	Lifetimes.Empty(Capacity);
+	Radii.Empty(Capacity);
+	Damage.Empty(Capacity);
+	Teams.Empty(Capacity);
+	Instigators.Empty(Capacity);
+}
+
+int32 FProjectilePool::Spawn(const FVector3f& Location, const FVector3f& Velocity, float Lifetime, float Radius, float InDamage, AActor* Instigator, uint8 Team)
+{
+	if (Num() >= Capacity)
+	{
+		++NumDropped;
+		return INDEX_NONE;
+	}
+
+	Positions.Add(Location);
+	Velocities.Add(Velocity);
+	Lifetimes.Add(Lifetime);
+	Radii.Add(Radius);
+	Damage.Add(InDamage);
+	Teams.Add(Team);
+	return Instigators.Add(Instigator);
+}
+
+void FProjectilePool::Expire(int32 Index)
+{
+	Lifetimes[Index] = 0.0f;
+}
+
+void FProjectilePool::Step(float DeltaTime, bool bParallel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileStep);
+
+	const int32 NumProjectiles = Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumProjectiles, ChunkSize);
+	ParallelFor(NumChunks, [this, NumProjectiles, DeltaTime](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * ChunkSize;
+		StepRange(Begin, FMath::Min(Begin + ChunkSize, NumProjectiles), DeltaTime);
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	// Walk backwards so the projectile swapped into a freed slot has already been checked
+	for (int32 Index = NumProjectiles - 1; Index >= 0; --Index)
+	{
+		if (Lifetimes[Index] <= 0.0f)
+		{
+			RemoveAtSwap(Index);
+		}
+	}
+}
+
+SIZE_T FProjectilePool::GetAllocatedSize() const
+{
+	return Positions.GetAllocatedSize() + Velocities.GetAllocatedSize() + Lifetimes.GetAllocatedSize() + Radii.GetAllocatedSize()
+		+ Damage.GetAllocatedSize() + Teams.GetAllocatedSize() + Instigators.GetAllocatedSize();
+}
+
+void FProjectilePool::StepRange(int32 Begin, int32 End, float DeltaTime)
+{
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		Positions[Index] += Velocities[Index] * DeltaTime;
+		Lifetimes[Index] -= DeltaTime;
+	}
+}
+
+void FProjectilePool::RemoveAtSwap(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Lifetimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Damage.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Teams.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
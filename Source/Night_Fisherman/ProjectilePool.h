@@ -0,0 +1,63 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class AActor;
+
+/**
+ * Projectile state stored as structure-of-arrays in storage reserved up front, so firing and expiring
+ * projectiles never allocates. Live projectiles are packed at the front: expired ones are swapped out
+ * at the end of each step, so indices are only stable between steps.
+ */
+class NIGHT_FISHERMAN_API FProjectilePool
+{
+public:
+	/** Projectiles per ParallelFor work item */
+	static constexpr int32 ChunkSize = 1024;
+
+	/** Removes every projectile and reserves room for Capacity of them */
+	void Initialize(int32 InCapacity);
+
+	/** Returns the projectile index, or INDEX_NONE when the pool is full */
+	int32 Spawn(const FVector3f& Location, const FVector3f& Velocity, float Lifetime, float Radius, float Damage, AActor* Instigator, uint8 Team);
+
+	/** Removes a projectile at the next step, e.g. once it hit something */
+	void Expire(int32 Index);
+
+	/** Moves every projectile by DeltaTime, then removes those whose lifetime ran out */
+	void Step(float DeltaTime, bool bParallel = true);
+
+	int32 Num() const { return Positions.Num(); }
+	int32 GetCapacity() const { return Capacity; }
+
+	/** Spawns refused because the pool was full */
+	int32 GetNumDropped() const { return NumDropped; }
+
+	SIZE_T GetAllocatedSize() const;
+
+	TConstArrayView<FVector3f> GetPositions() const { return Positions; }
+	TConstArrayView<FVector3f> GetVelocities() const { return Velocities; }
+	TConstArrayView<float> GetRadii() const { return Radii; }
+	TConstArrayView<float> GetDamage() const { return Damage; }
+	TConstArrayView<uint8> GetTeams() const { return Teams; }
+	TConstArrayView<TWeakObjectPtr<AActor>> GetInstigators() const { return Instigators; }
+
+private:
+	void StepRange(int32 Begin, int32 End, float DeltaTime);
+
+	void RemoveAtSwap(int32 Index);
+
+	TArray<FVector3f> Positions;
+	TArray<FVector3f> Velocities;
+	TArray<float> Lifetimes;
+	TArray<float> Radii;
+	TArray<float> Damage;
+	TArray<uint8> Teams;
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+
+	int32 Capacity = 0;
+	int32 NumDropped = 0;
+};
@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectileSpriteComponent.h"
+
+void UProjectileSpriteComponent::UpdateInstanceLocations(TConstArrayView<FVector3f> Locations, int32 NumInstances)
+{
+	check(Locations.Num() <= NumInstances && NumInstances <= PerInstanceSpriteData.Num());
+
+	// Instance transforms are relative to the component
+	const FTransform& ComponentTransform = GetComponentTransform();
+	for (int32 Index = 0; Index < Locations.Num(); ++Index)
+	{
+		PerInstanceSpriteData[Index].Transform = FTransform(FVector(Locations[Index])).GetRelativeTransform(ComponentTransform).ToMatrixWithScale();
+	}
+	for (int32 Index = Locations.Num(); Index < NumInstances; ++Index)
+	{
+		PerInstanceSpriteData[Index].Transform = FScaleMatrix(FVector::ZeroVector);
+	}
+
+	MarkRenderStateDirty();
+}
@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PaperGroupedSpriteComponent.h"
+#include "ProjectileSpriteComponent.generated.h"
+
+/**
+ * Grouped sprite component whose instances are all moved at once. UpdateInstanceLocations writes every
+ * instance's transform in one pass and marks the render state dirty once, with none of the per-call index
+ * checks and physics body updates of UpdateInstanceTransform, so its instances must not have collision.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UProjectileSpriteComponent : public UPaperGroupedSpriteComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Moves the first Locations.Num() instances to Locations, in world space, and scales the rest of the first NumInstances to nothing */
+	void UpdateInstanceLocations(TConstArrayView<FVector3f> Locations, int32 NumInstances);
+};
@@ -0,0 +1,161 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ProjectileSubsystem.h"
+#include "CombatHitSubsystem.h"
+#include "Night_Fisherman.h"
+#include "PaperSprite.h"
+#include "ProjectileSpriteComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Live Projectiles"), STAT_LiveProjectiles, STATGROUP_NightFisherman);
+
+static TAutoConsoleVariable<int32> CVarProjectileCapacity(
+	TEXT("NF.Projectiles.Capacity"),
+	4096,
+	TEXT("Projectiles preallocated per world; firing beyond this is refused. Read when the world starts."));
+
+static TAutoConsoleVariable<bool> CVarProjectileParallel(
+	TEXT("NF.Projectiles.Parallel"),
+	true,
+	TEXT("Step projectiles across task graph workers."));
+
+bool UProjectileSubsystem::Fire(AActor* Instigator, const FVector& Location, const FVector& Velocity, float Lifetime, float Radius, float Damage, uint8 Team)
+{
+	return Pool.Spawn(FVector3f(Location), FVector3f(Velocity), Lifetime, Radius, Damage, Instigator, Team) != INDEX_NONE;
+}
+
+void UProjectileSubsystem::SetSprite(UPaperSprite* InSprite)
+{
+	if (Sprite != InSprite)
+	{
+		Sprite = InSprite;
+		if (SpriteInstances)
+		{
+			SpriteInstances->ClearInstances();
+			NumVisibleInstances = 0;
+		}
+	}
+}
+
+void UProjectileSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Pool.Initialize(CVarProjectileCapacity.GetValueOnGameThread());
+
+	CombatHits = Collection.InitializeDependency<UCombatHitSubsystem>();
+	if (CombatHits)
+	{
+		AttacksResolvedHandle = CombatHits->OnAttacksResolved.AddUObject(this, &UProjectileSubsystem::HandleAttacksResolved);
+	}
+}
+
+void UProjectileSubsystem::Deinitialize()
+{
+	if (CombatHits)
+	{
+		CombatHits->OnAttacksResolved.Remove(AttacksResolvedHandle);
+		CombatHits = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UProjectileSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Pool.Num() > 0)
+	{
+		Pool.Step(DeltaTime, CVarProjectileParallel.GetValueOnGameThread());
+		QueueHitTests();
+	}
+
+	UpdateSprites();
+
+	SET_DWORD_STAT(STAT_LiveProjectiles, Pool.Num());
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void UProjectileSubsystem::QueueHitTests()
+{
+	NumQueuedAttacks = 0;
+	if (!CombatHits)
+	{
+		return;
+	}
+
+	const TConstArrayView<FVector3f> Positions = Pool.GetPositions();
+	const TConstArrayView<float> Radii = Pool.GetRadii();
+	const TConstArrayView<float> Damage = Pool.GetDamage();
+	const TConstArrayView<uint8> Teams = Pool.GetTeams();
+	const TConstArrayView<TWeakObjectPtr<AActor>> Instigators = Pool.GetInstigators();
+	for (int32 Index = 0; Index < Pool.Num(); ++Index)
+	{
+		const int32 AttackIndex = CombatHits->QueueAttack(Instigators[Index].Get(), FVector(Positions[Index]), Radii[Index], Damage[Index], Teams[Index]);
+		if (Index == 0)
+		{
+			FirstQueuedAttack = AttackIndex;
+		}
+	}
+	NumQueuedAttacks = Pool.Num();
+}
+
+void UProjectileSubsystem::HandleAttacksResolved()
+{
+	// Only Step reorders the pool and it never runs between queueing and resolving, so indices still match
+	for (const FCombatHit& Hit : CombatHits->GetLastHits())
+	{
+		const int32 Index = Hit.AttackIndex - FirstQueuedAttack;
+		if (Index >= 0 && Index < NumQueuedAttacks)
+		{
+			Pool.Expire(Index);
+		}
+	}
+	NumQueuedAttacks = 0;
+}
+
+void UProjectileSubsystem::UpdateSprites()
+{
+	const int32 NumProjectiles = Pool.Num();
+	if (!Sprite || (NumProjectiles == 0 && NumVisibleInstances == 0))
+	{
+		return;
+	}
+
+	if (!SpriteInstances)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		AActor* Owner = GetWorld()->SpawnActor<AActor>(SpawnParams);
+
+		SpriteInstances = NewObject<UProjectileSpriteComponent>(Owner, TEXT("ProjectileSprites"));
+		SpriteInstances->SetMobility(EComponentMobility::Movable);
+		SpriteInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Owner->SetRootComponent(SpriteInstances);
+		SpriteInstances->RegisterComponent();
+	}
+
+	// Instances grow to the peak projectile count once and are reused after that; spare ones are scaled to nothing
+	const FTransform HiddenTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+	while (SpriteInstances->GetInstanceCount() < NumProjectiles)
+	{
+		SpriteInstances->AddInstance(HiddenTransform, Sprite, true);
+	}
+
+	SpriteInstances->UpdateInstanceLocations(Pool.GetPositions(), FMath::Max(NumProjectiles, NumVisibleInstances));
+	NumVisibleInstances = NumProjectiles;
+
+	SpriteInstances->UpdateBounds();
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "ProjectilePool.h"
+#include "ProjectileSubsystem.generated.h"
+
+class UPaperSprite;
+class UProjectileSpriteComponent;
+class UCombatHitSubsystem;
+
+/**
+ * Owns every projectile in the world as plain data in a preallocated FProjectilePool rather than as actors.
+ * Projectiles are stepped on worker threads, hit hurtboxes through UCombatHitSubsystem and are drawn as
+ * instances of one grouped sprite component, so firing never creates a UObject.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UProjectileSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Fires a projectile, returning false when the pool is full */
+	bool Fire(AActor* Instigator, const FVector& Location, const FVector& Velocity, float Lifetime, float Radius, float Damage, uint8 Team = 0);
+
+	/** Sprite drawn for every projectile; nothing is drawn until one is set */
+	UFUNCTION(BlueprintCallable, Category = Combat)
+	void SetSprite(UPaperSprite* InSprite);
+
+	const FProjectilePool& GetPool() const { return Pool; }
+
+	// USubsystem implementation
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** Queues every live projectile as a swing with the combat subsystem */
+	void QueueHitTests();
+
+	/** Expires the projectiles whose swings hit something */
+	void HandleAttacksResolved();
+
+	/** Moves the sprite instances to the live projectiles, hiding instances past the last one */
+	void UpdateSprites();
+
+	FProjectilePool Pool;
+
+	UPROPERTY()
+	TObjectPtr<UPaperSprite> Sprite;
+
+	UPROPERTY()
+	TObjectPtr<UProjectileSpriteComponent> SpriteInstances;
+
+	/** Instances that were showing a projectile after the last UpdateSprites */
+	int32 NumVisibleInstances = 0;
+
+	UPROPERTY()
+	TObjectPtr<UCombatHitSubsystem> CombatHits;
+
+	/** Attack index of projectile 0 in the batch queued with CombatHits; projectiles are queued in order */
+	int32 FirstQueuedAttack = INDEX_NONE;
+	int32 NumQueuedAttacks = 0;
+
+	FDelegateHandle AttacksResolvedHandle;
+};
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkSubsystem.h"
+#include "DeterminismSubsystem.h"
+#include "InputReplaySubsystem.h"
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	/** Replays a recorded play session on the player character, one recorded frame per benchmark frame */
+	class FReplayScenario : public FScenario
+	{
+	public:
+		FReplayScenario(const FString& InName, FInputRecording&& InRecording)
+			: Name(InName)
+			, Recording(MoveTemp(InRecording))
+		{
+		}
+
+		virtual FString GetName() const override
+		{
+			return FString::Printf(TEXT("Replay_%s"), *Name);
+		}
+
+		virtual void PreFrame(UWorld& World, int32 FrameIndex, float DeltaTime) override
+		{
+			// Starting once warmup is over lines recorded frame 0 up with benchmark frame 0
+			if (FrameIndex != 0)
+			{
+				return;
+			}
+
+			Replays = World.GetSubsystem<UInputReplaySubsystem>();
+			Determinism = World.GetSubsystem<UDeterminismSubsystem>();
+			const APlayerController* PlayerController = World.GetFirstPlayerController();
+			ATopDownCharacter* Character = PlayerController ? Cast<ATopDownCharacter>(PlayerController->GetPawn()) : nullptr;
+			if (!Replays || !Character || !Replays->StartReplay(Character, MoveTemp(Recording)))
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("Benchmark %s: no player character to replay on"), *GetName());
+			}
+		}
+
+		virtual void GetExtraColumns(TArray<FString>& OutColumns) const override
+		{
+			OutColumns.Add(TEXT("ReplayFrame"));
+			OutColumns.Add(TEXT("StateHash"));
+		}
+
+		virtual void GetExtraValues(TArray<FString>& OutValues) const override
+		{
+			OutValues.Add(LexToString(Replays.IsValid() && Replays->IsReplaying() ? Replays->GetReplayFrame() : -1));
+
+			// Two deterministic runs of a replay match row for row; the first differing row shows where they diverged
+			OutValues.Add(Determinism.IsValid() ? FString::Printf(TEXT("%08x"), Determinism->ComputeStateHash()) : FString());
+		}
+
+		virtual void Teardown(UWorld& World) override
+		{
+			if (Replays.IsValid())
+			{
+				Replays->StopReplay();
+			}
+		}
+
+	private:
+		FString Name;
+		FInputRecording Recording;
+		TWeakObjectPtr<UInputReplaySubsystem> Replays;
+		TWeakObjectPtr<UDeterminismSubsystem> Determinism;
+	};
+
+	static FAutoConsoleCommandWithWorldAndArgs ReplayBenchmarkCommand(
+		TEXT("NF.Benchmark.Replay"),
+		TEXT("Replays a recorded play session from Saved/Replays on the player character at its fixed timestep and records every frame with its state hash; run with -Deterministic to compare runs. Usage: NF.Benchmark.Replay [Name=Session]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<UBenchmarkSubsystem>() : nullptr;
+			if (!Benchmark)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.Replay needs a game world"));
+				return;
+			}
+
+			const FString Name = Args.IsValidIndex(0) ? Args[0] : FString(TEXT("Session"));
+			FInputRecording Recording;
+			if (!Recording.LoadFromFile(FInputRecording::GetPath(Name)))
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.Replay cannot load %s"), *FInputRecording::GetPath(Name));
+				return;
+			}
+
+			const int32 NumFrames = Recording.NumFrames();
+			Benchmark->StartScenario(MakeUnique<FReplayScenario>(Name, MoveTemp(Recording)), NumFrames);
+		}));
+}
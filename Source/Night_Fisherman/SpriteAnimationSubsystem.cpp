@@ -0,0 +1,80 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpriteAnimationSubsystem.h"
+#include "SpriteAnimatorComponent.h"
+#include "Night_Fisherman.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sprite Animation"), STAT_SpriteAnimation, STATGROUP_NightFisherman);
+
+void USpriteAnimationSubsystem::RegisterAnimator(USpriteAnimatorComponent* Animator)
+{
+	check(Animator);
+	if (Animator->AnimatorIndex == INDEX_NONE)
+	{
+		Animator->AnimatorIndex = Animators.Add(Animator);
+	}
+}
+
+void USpriteAnimationSubsystem::UnregisterAnimator(USpriteAnimatorComponent* Animator)
+{
+	check(Animator);
+	const int32 Index = Animator->AnimatorIndex;
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	Animators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Animators.IsValidIndex(Index))
+	{
+		Animators[Index]->AnimatorIndex = Index;
+	}
+	Animator->AnimatorIndex = INDEX_NONE;
+}
+
+bool USpriteAnimationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USpriteAnimationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Animators.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SpriteAnimation);
+
+	// Facings are relative to the local player's view, so "up" stays up on screen when the camera turns
+	const UWorld* World = GetWorld();
+	double ViewYaw = 0.0;
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+	{
+		if (PlayerController->PlayerCameraManager)
+		{
+			ViewYaw = PlayerController->PlayerCameraManager->GetCameraRotation().Yaw;
+		}
+	}
+
+	double Sin, Cos;
+	FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(ViewYaw));
+	const FVector2D ViewForward(Cos, Sin);
+	const FVector2D ViewRight(-Sin, Cos);
+	const double Time = World->GetTimeSeconds();
+
+	for (USpriteAnimatorComponent* Animator : Animators)
+	{
+		Animator->Evaluate(ViewForward, ViewRight, Time);
+	}
+}
+
+TStatId USpriteAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpriteAnimationSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "SpriteAnimationSubsystem.generated.h"
+
+class USpriteAnimatorComponent;
+
+/**
+ * Evaluates every USpriteAnimatorComponent in the world once per frame, after actors have moved.
+ * The view basis is computed once for all of them, and the animators themselves never tick.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API USpriteAnimationSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterAnimator(USpriteAnimatorComponent* Animator);
+	void UnregisterAnimator(USpriteAnimatorComponent* Animator);
+
+	int32 NumAnimators() const { return Animators.Num(); }
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	TArray<USpriteAnimatorComponent*> Animators;
+};
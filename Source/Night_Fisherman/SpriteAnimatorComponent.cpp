@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpriteAnimatorComponent.h"
+#include "SpriteAnimationSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "PaperFlipbook.h"
+#include "PaperFlipbookComponent.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sprite Flipbook Switches"), STAT_SpriteFlipbookSwitches, STATGROUP_NightFisherman);
+
+namespace
+{
+	/** States whose flipbook loops; the others play once and stop on their last frame */
+	constexpr bool StateLoops[] = { true, true, true, false, true, false, false };
+	static_assert(UE_ARRAY_COUNT(StateLoops) == static_cast<int32>(ESpriteAnimState::Count), "StateLoops must cover every ESpriteAnimState");
+
+	UPaperFlipbook* GetFlipbook(const FDirectionalFlipbooks& Flipbooks, ESpriteDirection Direction)
+	{
+		switch (Direction)
+		{
+		case ESpriteDirection::Up:
+			return Flipbooks.Up;
+		case ESpriteDirection::Left:
+			return Flipbooks.Left;
+		case ESpriteDirection::Right:
+			return Flipbooks.Right;
+		default:
+			return Flipbooks.Down;
+		}
+	}
+}
+
+USpriteAnimatorComponent::USpriteAnimatorComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	for (UPaperFlipbook*& Flipbook : FlipbookTable)
+	{
+		Flipbook = nullptr;
+	}
+}
+
+void USpriteAnimatorComponent::SetSprite(UPaperFlipbookComponent* InSprite)
+{
+	Sprite = InSprite;
+	AppliedIndex = INDEX_NONE;
+}
+
+void USpriteAnimatorComponent::PlayAction(ESpriteAnimState State, float Duration)
+{
+	if (State == ESpriteAnimState::Death)
+	{
+		Duration = 0.0f;
+	}
+	else if (Duration < 0.0f)
+	{
+		const UPaperFlipbook* Flipbook = FlipbookTable[static_cast<int32>(State) * NumDirections + static_cast<int32>(CurrentDirection)];
+		Duration = Flipbook ? FMath::Max(Flipbook->GetTotalDuration(), UE_KINDA_SMALL_NUMBER) : UE_KINDA_SMALL_NUMBER;
+	}
+
+	const UWorld* World = GetWorld();
+	bActionActive = true;
+	ActionState = State;
+	ActionEndTime = Duration > 0.0f && World ? World->GetTimeSeconds() + Duration : -1.0;
+}
+
+void USpriteAnimatorComponent::StopAction()
+{
+	bActionActive = false;
+}
+
+void USpriteAnimatorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!Sprite)
+	{
+		Sprite = GetOwner()->FindComponentByClass<UPaperFlipbookComponent>();
+	}
+
+	BuildTable();
+	AppliedIndex = INDEX_NONE;
+
+	if (bPlaySpawnOnBeginPlay && Spawn)
+	{
+		PlayAction(ESpriteAnimState::Spawn);
+	}
+
+	if (USpriteAnimationSubsystem* SpriteAnimation = GetWorld()->GetSubsystem<USpriteAnimationSubsystem>())
+	{
+		SpriteAnimation->RegisterAnimator(this);
+	}
+}
+
+void USpriteAnimatorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USpriteAnimationSubsystem* SpriteAnimation = GetWorld()->GetSubsystem<USpriteAnimationSubsystem>())
+	{
+		SpriteAnimation->UnregisterAnimator(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void USpriteAnimatorComponent::BuildTable()
+{
+	auto Fill = [this](ESpriteAnimState State, const FDirectionalFlipbooks& Flipbooks, const FDirectionalFlipbooks* Fallback)
+	{
+		for (int32 Direction = 0; Direction < NumDirections; ++Direction)
+		{
+			UPaperFlipbook* Flipbook = GetFlipbook(Flipbooks, static_cast<ESpriteDirection>(Direction));
+			if (!Flipbook && Fallback)
+			{
+				Flipbook = GetFlipbook(*Fallback, static_cast<ESpriteDirection>(Direction));
+			}
+			FlipbookTable[static_cast<int32>(State) * NumDirections + Direction] = Flipbook;
+		}
+	};
+
+	Fill(ESpriteAnimState::Idle, Idle, nullptr);
+	Fill(ESpriteAnimState::Walk, Walk, &Idle);
+	Fill(ESpriteAnimState::Push, Push, &Walk);
+	Fill(ESpriteAnimState::Use, Use, &Idle);
+	Fill(ESpriteAnimState::Frozen, Frozen, &Idle);
+
+	for (int32 Direction = 0; Direction < NumDirections; ++Direction)
+	{
+		FlipbookTable[static_cast<int32>(ESpriteAnimState::Spawn) * NumDirections + Direction] = Spawn;
+		FlipbookTable[static_cast<int32>(ESpriteAnimState::Death) * NumDirections + Direction] = Death;
+	}
+}
+
+void USpriteAnimatorComponent::Evaluate(const FVector2D& ViewForward, const FVector2D& ViewRight, double Time)
+{
+	if (bActionActive && ActionEndTime >= 0.0 && Time >= ActionEndTime)
+	{
+		bActionActive = false;
+	}
+
+	// Velocity in view space; facing is kept while standing still
+	const FVector Velocity = GetOwner()->GetVelocity();
+	const FVector2D Velocity2D(Velocity.X, Velocity.Y);
+	const bool bMoving = Velocity2D.SizeSquared() > FMath::Square(WalkSpeedThreshold);
+	const ESpriteDirection Direction = bMoving ? ChooseDirection(Velocity2D | ViewForward, Velocity2D | ViewRight) : CurrentDirection;
+
+	const ESpriteAnimState State = bActionActive ? ActionState : bMoving ? ESpriteAnimState::Walk : ESpriteAnimState::Idle;
+	const bool bStateChanged = State != CurrentState;
+	CurrentState = State;
+	CurrentDirection = Direction;
+
+	if (static_cast<int32>(State) * NumDirections + static_cast<int32>(Direction) != AppliedIndex)
+	{
+		ApplyFlipbook(bStateChanged || AppliedIndex == INDEX_NONE);
+	}
+}
+
+ESpriteDirection USpriteAnimatorComponent::ChooseDirection(double Along, double Side) const
+{
+	// Stay on the current axis until the other one dominates by DirectionHysteresis, so diagonals do not flicker
+	const bool bVertical = CurrentDirection == ESpriteDirection::Up || CurrentDirection == ESpriteDirection::Down;
+	const double Bias = 1.0 + DirectionHysteresis;
+	const bool bChooseVertical = bVertical ? FMath::Abs(Side) <= FMath::Abs(Along) * Bias : FMath::Abs(Along) > FMath::Abs(Side) * Bias;
+
+	if (bChooseVertical)
+	{
+		return Along >= 0.0 ? ESpriteDirection::Up : ESpriteDirection::Down;
+	}
+	return Side >= 0.0 ? ESpriteDirection::Right : ESpriteDirection::Left;
+}
+
+void USpriteAnimatorComponent::ApplyFlipbook(bool bStateChanged)
+{
+	if (!Sprite)
+	{
+		return;
+	}
+
+	AppliedIndex = static_cast<int32>(CurrentState) * NumDirections + static_cast<int32>(CurrentDirection);
+	UPaperFlipbook* Flipbook = FlipbookTable[AppliedIndex];
+	if (!Flipbook || Flipbook == Sprite->GetFlipbook())
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_SpriteFlipbookSwitches);
+
+	// Turning mid-state carries the playback position over so the walk cycle does not restart
+	const float PlaybackPosition = Sprite->GetPlaybackPosition();
+	Sprite->SetFlipbook(Flipbook);
+	Sprite->SetLooping(StateLoops[static_cast<int32>(CurrentState)]);
+	if (bStateChanged)
+	{
+		Sprite->PlayFromStart();
+	}
+	else
+	{
+		Sprite->SetPlaybackPosition(FMath::Min(PlaybackPosition, Flipbook->GetTotalDuration()), false);
+		Sprite->Play();
+	}
+}
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Containers/StaticArray.h"
+#include "SpriteAnimatorComponent.generated.h"
+
+class UPaperFlipbook;
+class UPaperFlipbookComponent;
+
+/** Screen direction a sprite character faces, relative to the view */
+UENUM(BlueprintType)
+enum class ESpriteDirection : uint8
+{
+	Up,
+	Down,
+	Left,
+	Right,
+	Count UMETA(Hidden)
+};
+
+/** What a sprite character is doing, in the order the flipbook table is laid out */
+UENUM(BlueprintType)
+enum class ESpriteAnimState : uint8
+{
+	Idle,
+	Walk,
+	Push,
+	Use,
+	Frozen,
+	Spawn,
+	Death,
+	Count UMETA(Hidden)
+};
+
+/** One flipbook per facing */
+USTRUCT(BlueprintType)
+struct NIGHT_FISHERMAN_API FDirectionalFlipbooks
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	UPaperFlipbook* Up = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	UPaperFlipbook* Down = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	UPaperFlipbook* Left = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	UPaperFlipbook* Right = nullptr;
+};
+
+/**
+ * Picks the owner's flipbook from its velocity and current action and sets it on a flipbook component.
+ *
+ * The flipbooks are flattened into a state-by-direction table at BeginPlay, so choosing one is an index
+ * computation, and the flipbook component is only touched when the index changes. The component does not
+ * tick; USpriteAnimationSubsystem evaluates every animator in the world in one pass after movement.
+ * Directions are taken relative to the local player's view yaw, so they follow a rotated camera.
+ */
+UCLASS(ClassGroup = (Animation), meta = (BlueprintSpawnableComponent))
+class NIGHT_FISHERMAN_API USpriteAnimatorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USpriteAnimatorComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	FDirectionalFlipbooks Idle;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	FDirectionalFlipbooks Walk;
+
+	/** Falls back to Walk for missing directions */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	FDirectionalFlipbooks Push;
+
+	/** Falls back to Idle for missing directions */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	FDirectionalFlipbooks Use;
+
+	/** Falls back to Idle for missing directions */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	FDirectionalFlipbooks Frozen;
+
+	/** Played once, facing any direction */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	UPaperFlipbook* Spawn;
+
+	/** Played once and held, facing any direction */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	UPaperFlipbook* Death;
+
+	/** Horizontal speed above which the owner walks instead of idling */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation, meta = (ClampMin = "0.0"))
+	float WalkSpeedThreshold = 10.0f;
+
+	/** How much the other axis has to dominate before a diagonal move swaps between up/down and left/right facings */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation, meta = (ClampMin = "0.0"))
+	float DirectionHysteresis = 0.15f;
+
+	/** Whether the Spawn flipbook plays when the owner begins play */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation)
+	bool bPlaySpawnOnBeginPlay = true;
+
+	/** Sets the component the flipbooks are played on. The owner's first flipbook component is used when unset. */
+	void SetSprite(UPaperFlipbookComponent* InSprite);
+
+	/**
+	 * Overrides the locomotion state with State. A negative Duration plays the state's flipbook once,
+	 * zero holds it until StopAction. Death is always held.
+	 */
+	void PlayAction(ESpriteAnimState State, float Duration = -1.0f);
+
+	/** Returns to idle or walk */
+	void StopAction();
+
+	ESpriteAnimState GetState() const { return CurrentState; }
+	ESpriteDirection GetDirection() const { return CurrentDirection; }
+
+protected:
+	// UActorComponent implementation
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	friend class USpriteAnimationSubsystem;
+
+	static constexpr int32 NumDirections = static_cast<int32>(ESpriteDirection::Count);
+	static constexpr int32 NumStates = static_cast<int32>(ESpriteAnimState::Count);
+
+	/** Flattens the flipbook properties into FlipbookTable, filling gaps with fallbacks */
+	void BuildTable();
+
+	/** Updates the facing and state for this frame, switching the flipbook if either changed */
+	void Evaluate(const FVector2D& ViewForward, const FVector2D& ViewRight, double Time);
+
+	/** Facing for a horizontal velocity in view space, biased towards the current facing */
+	ESpriteDirection ChooseDirection(double Along, double Side) const;
+
+	/** Sets the flipbook for the current state and facing */
+	void ApplyFlipbook(bool bStateChanged);
+
+	/** [State * NumDirections + Direction], referenced by the flipbook properties above */
+	TStaticArray<UPaperFlipbook*, NumStates * NumDirections> FlipbookTable;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UPaperFlipbookComponent> Sprite;
+
+	ESpriteAnimState CurrentState = ESpriteAnimState::Idle;
+	ESpriteDirection CurrentDirection = ESpriteDirection::Down;
+
+	/** Table index last applied to Sprite, INDEX_NONE to force the next evaluation to apply */
+	int32 AppliedIndex = INDEX_NONE;
+
+	bool bActionActive = false;
+	ESpriteAnimState ActionState = ESpriteAnimState::Idle;
+
+	/** World time the action ends at, or a negative value when it is held */
+	double ActionEndTime = -1.0;
+
+	/** Index in USpriteAnimationSubsystem's animator list, INDEX_NONE while unregistered */
+	int32 AnimatorIndex = INDEX_NONE;
+};
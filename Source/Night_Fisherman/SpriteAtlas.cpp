@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpriteAtlas.h"
+
+int32 USpriteAtlas::GetFrameIndex(ESpriteAnimState State, ESpriteDirection Direction, float Time) const
+{
+	const FSpriteAtlasClip& Clip = GetClip(State, Direction);
+	if (Clip.NumFrames == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Frame = FMath::Max(FMath::FloorToInt32(Time * Clip.FramesPerSecond), 0) % Clip.NumFrames;
+	return ClipFrames[Clip.FirstFrame + Frame];
+}
+
+FBox2f USpriteAtlas::GetFrameUVs(int32 FrameIndex) const
+{
+	const FSpriteAtlasFrame& Frame = Frames[FrameIndex];
+	const FVector2f InvSize(1.0f / FMath::Max(TextureSize.X, 1), 1.0f / FMath::Max(TextureSize.Y, 1));
+	return FBox2f(FVector2f(Frame.X, Frame.Y) * InvSize, FVector2f(Frame.X + Frame.Width, Frame.Y + Frame.Height) * InvSize);
+}
@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SpriteAnimatorComponent.h"
+#include "SpriteAtlas.generated.h"
+
+class UTexture2D;
+
+/** Trimmed rectangle of one frame in the atlas texture, in texels */
+USTRUCT()
+struct NIGHT_FISHERMAN_API FSpriteAtlasFrame
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	uint16 X = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	uint16 Y = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	uint16 Width = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	uint16 Height = 0;
+
+	/** Sprite pivot relative to the trimmed rectangle's top left corner, so trimmed frames stay aligned */
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	int16 PivotX = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	int16 PivotY = 0;
+};
+
+/** Run of entries in USpriteAtlas::ClipFrames played for one state and direction */
+USTRUCT()
+struct NIGHT_FISHERMAN_API FSpriteAtlasClip
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	uint16 FirstFrame = 0;
+
+	/** Zero when the source had no flipbook for this state and direction */
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	uint16 NumFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	float FramesPerSecond = 0.0f;
+};
+
+/**
+ * Every frame of a sprite character packed into one texture, written by the SpriteAtlas commandlet.
+ * Clips is laid out [State * NumDirections + Direction], so looking a frame up is two array reads;
+ * frames shared between clips are stored once.
+ */
+UCLASS(BlueprintType)
+class NIGHT_FISHERMAN_API USpriteAtlas : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumDirections = static_cast<int32>(ESpriteDirection::Count);
+	static constexpr int32 NumStates = static_cast<int32>(ESpriteAnimState::Count);
+
+	/** Packed frames */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Atlas)
+	UTexture2D* Texture;
+
+	/** Size of Texture in texels */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Atlas)
+	FIntPoint TextureSize = FIntPoint::ZeroValue;
+
+	/** Unique frames */
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	TArray<FSpriteAtlasFrame> Frames;
+
+	/** Frame indices of every clip back to back, one per displayed frame */
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	TArray<uint16> ClipFrames;
+
+	/** NumStates * NumDirections clips */
+	UPROPERTY(VisibleAnywhere, Category = Atlas)
+	TArray<FSpriteAtlasClip> Clips;
+
+	const FSpriteAtlasClip& GetClip(ESpriteAnimState State, ESpriteDirection Direction) const
+	{
+		return Clips[static_cast<int32>(State) * NumDirections + static_cast<int32>(Direction)];
+	}
+
+	/** Index into Frames shown Time seconds into a clip, looping, or INDEX_NONE if the clip is empty */
+	int32 GetFrameIndex(ESpriteAnimState State, ESpriteDirection Direction, float Time) const;
+
+	/** Texture coordinates of a frame's trimmed rectangle */
+	FBox2f GetFrameUVs(int32 FrameIndex) const;
+};
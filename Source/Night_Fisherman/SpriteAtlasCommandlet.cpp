@@ -0,0 +1,387 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpriteAtlasCommandlet.h"
+#include "SpriteAtlas.h"
+#include "Night_Fisherman.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Texture2D.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "PaperFlipbook.h"
+#include "PaperSprite.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+#if WITH_EDITOR
+namespace SpriteAtlas
+{
+	struct FNameToken
+	{
+		const TCHAR* Token;
+		int32 Value;
+	};
+
+	// Name fragments of the source flipbooks, only used while packing
+	static const FNameToken DirectionTokens[] =
+	{
+		{ TEXT("Up"), static_cast<int32>(ESpriteDirection::Up) },
+		{ TEXT("Down"), static_cast<int32>(ESpriteDirection::Down) },
+		{ TEXT("Left"), static_cast<int32>(ESpriteDirection::Left) },
+		{ TEXT("Right"), static_cast<int32>(ESpriteDirection::Right) },
+	};
+
+	static const FNameToken StateTokens[] =
+	{
+		{ TEXT("Idle"), static_cast<int32>(ESpriteAnimState::Idle) },
+		{ TEXT("Walk"), static_cast<int32>(ESpriteAnimState::Walk) },
+		{ TEXT("Push"), static_cast<int32>(ESpriteAnimState::Push) },
+		{ TEXT("Use"), static_cast<int32>(ESpriteAnimState::Use) },
+		{ TEXT("Frz"), static_cast<int32>(ESpriteAnimState::Frozen) },
+		{ TEXT("Spawning"), static_cast<int32>(ESpriteAnimState::Spawn) },
+		{ TEXT("Dying"), static_cast<int32>(ESpriteAnimState::Death) },
+	};
+
+	/** A trimmed frame waiting to be placed */
+	struct FPackEntry
+	{
+		int32 FrameIndex;
+		int32 Width;
+		int32 Height;
+		int32 X = 0;
+		int32 Y = 0;
+	};
+
+	/** BGRA8 pixels of a source texture */
+	struct FSourcePixels
+	{
+		TArray64<uint8> Data;
+		int32 Width = 0;
+		int32 Height = 0;
+	};
+
+	/** Parses <Prefix><Direction>_<State>_Flipbook; Direction is INDEX_NONE for sets shared by every direction */
+	static bool ParseFlipbookName(const FString& Name, int32& OutState, int32& OutDirection)
+	{
+		TArray<FString> Parts;
+		Name.ParseIntoArray(Parts, TEXT("_"));
+		if (Parts.Num() < 2)
+		{
+			return false;
+		}
+
+		OutState = INDEX_NONE;
+		for (const FNameToken& Token : StateTokens)
+		{
+			if (Parts[1].Equals(Token.Token, ESearchCase::IgnoreCase))
+			{
+				OutState = Token.Value;
+			}
+		}
+
+		OutDirection = INDEX_NONE;
+		for (const FNameToken& Token : DirectionTokens)
+		{
+			if (Parts[0].EndsWith(Token.Token, ESearchCase::IgnoreCase))
+			{
+				OutDirection = Token.Value;
+			}
+		}
+
+		const bool bSharedState = OutState == static_cast<int32>(ESpriteAnimState::Spawn) || OutState == static_cast<int32>(ESpriteAnimState::Death);
+		return OutState != INDEX_NONE && (OutDirection != INDEX_NONE || bSharedState);
+	}
+
+	/** Places Entries (sorted tallest first) on shelves AtlasWidth wide, returning the height used or INDEX_NONE if one does not fit */
+	static int32 PackShelves(TArray<FPackEntry>& Entries, int32 AtlasWidth, int32 Padding)
+	{
+		int32 X = Padding;
+		int32 Y = Padding;
+		int32 ShelfHeight = 0;
+		for (FPackEntry& Entry : Entries)
+		{
+			if (Entry.Width + 2 * Padding > AtlasWidth)
+			{
+				return INDEX_NONE;
+			}
+			if (X + Entry.Width + Padding > AtlasWidth)
+			{
+				X = Padding;
+				Y += ShelfHeight + Padding;
+				ShelfHeight = 0;
+			}
+			Entry.X = X;
+			Entry.Y = Y;
+			X += Entry.Width + Padding;
+			ShelfHeight = FMath::Max(ShelfHeight, Entry.Height);
+		}
+		return Y + ShelfHeight + Padding;
+	}
+
+	/** Finds or creates the package and asset to overwrite */
+	template <typename AssetType>
+	static AssetType* CreateAsset(const FString& PackageName)
+	{
+		UPackage* Package = FPackageName::DoesPackageExist(PackageName)
+			? LoadPackage(nullptr, *PackageName, LOAD_None)
+			: CreatePackage(*PackageName);
+		check(Package);
+
+		const FString AssetName = FPackageName::GetShortName(PackageName);
+		AssetType* Asset = FindObject<AssetType>(Package, *AssetName);
+		if (!Asset)
+		{
+			Asset = NewObject<AssetType>(Package, *AssetName, RF_Public | RF_Standalone);
+			IAssetRegistry::GetChecked().AssetCreated(Asset);
+		}
+		return Asset;
+	}
+
+	static bool SaveAsset(UObject* Asset)
+	{
+		UPackage* Package = Asset->GetPackage();
+		Package->MarkPackageDirty();
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		if (!UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("SpriteAtlas: failed to save %s"), *Filename);
+			return false;
+		}
+		return true;
+	}
+}
+#endif
+
+USpriteAtlasCommandlet::USpriteAtlasCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+	HelpDescription = TEXT("Packs a sprite character's flipbook frames into one trimmed atlas and a USpriteAtlas frame table.");
+}
+
+int32 USpriteAtlasCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	using namespace SpriteAtlas;
+
+	FString SourcePath = TEXT("/Game/Characters/Guy/Assets");
+	FString OutputPath = TEXT("/Game/Characters/Guy/BeastlyGuyAtlas");
+	int32 Padding = 1;
+	int32 MaxSize = 4096;
+	FParse::Value(*Params, TEXT("Source="), SourcePath);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	FParse::Value(*Params, TEXT("Padding="), Padding);
+	FParse::Value(*Params, TEXT("MaxSize="), MaxSize);
+	Padding = FMath::Max(Padding, 0);
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(*SourcePath));
+	Filter.ClassPaths.Add(UPaperFlipbook::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	TArray<FAssetData> FlipbookAssets;
+	AssetRegistry.GetAssets(Filter, FlipbookAssets);
+
+	// Gather the clips, storing each sprite once however many flipbooks use it
+	USpriteAtlas* Atlas = CreateAsset<USpriteAtlas>(OutputPath);
+	Atlas->Frames.Reset();
+	Atlas->ClipFrames.Reset();
+	Atlas->Clips.Reset();
+	Atlas->Clips.SetNum(USpriteAtlas::NumStates * USpriteAtlas::NumDirections);
+
+	TArray<UPaperSprite*> Sprites;
+	TMap<UPaperSprite*, int32> SpriteFrames;
+	for (const FAssetData& FlipbookAsset : FlipbookAssets)
+	{
+		int32 State, Direction;
+		if (!ParseFlipbookName(FlipbookAsset.AssetName.ToString(), State, Direction))
+		{
+			UE_LOG(LogNightFisherman, Warning, TEXT("SpriteAtlas: skipping %s, its name has no known state and direction"), *FlipbookAsset.AssetName.ToString());
+			continue;
+		}
+
+		const UPaperFlipbook* Flipbook = Cast<UPaperFlipbook>(FlipbookAsset.GetAsset());
+		if (!Flipbook)
+		{
+			continue;
+		}
+
+		FSpriteAtlasClip Clip;
+		Clip.FirstFrame = static_cast<uint16>(Atlas->ClipFrames.Num());
+		Clip.FramesPerSecond = Flipbook->GetFramesPerSecond();
+		for (int32 KeyFrameIndex = 0; KeyFrameIndex < Flipbook->GetNumKeyFrames(); ++KeyFrameIndex)
+		{
+			const FPaperFlipbookKeyFrame& KeyFrame = Flipbook->GetKeyFrameChecked(KeyFrameIndex);
+			if (!KeyFrame.Sprite)
+			{
+				continue;
+			}
+
+			int32* FrameIndex = SpriteFrames.Find(KeyFrame.Sprite);
+			if (!FrameIndex)
+			{
+				FrameIndex = &SpriteFrames.Add(KeyFrame.Sprite, Sprites.Add(KeyFrame.Sprite));
+			}
+
+			// Frames held for several runs are repeated so the runtime can index by time directly
+			for (int32 Run = 0; Run < FMath::Max(KeyFrame.FrameRun, 1); ++Run)
+			{
+				Atlas->ClipFrames.Add(static_cast<uint16>(*FrameIndex));
+			}
+		}
+		Clip.NumFrames = static_cast<uint16>(Atlas->ClipFrames.Num() - Clip.FirstFrame);
+
+		for (int32 ClipDirection = 0; ClipDirection < USpriteAtlas::NumDirections; ++ClipDirection)
+		{
+			if (Direction == INDEX_NONE || Direction == ClipDirection)
+			{
+				Atlas->Clips[State * USpriteAtlas::NumDirections + ClipDirection] = Clip;
+			}
+		}
+	}
+
+	if (Sprites.IsEmpty())
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("SpriteAtlas: no flipbook frames found under %s"), *SourcePath);
+		return 1;
+	}
+	check(Sprites.Num() <= MAX_uint16 && Atlas->ClipFrames.Num() <= MAX_uint16);
+
+	// Trim every frame to its opaque texels
+	TMap<UTexture2D*, FSourcePixels> SourceTextures;
+	TArray<FPackEntry> Entries;
+	TArray<FIntRect> TrimmedRects;
+	// Pixels are looked up by texture once gathered; adding to SourceTextures moves the ones already in it
+	TArray<UTexture2D*> FrameTextures;
+	int64 SourceTexels = 0;
+	Atlas->Frames.SetNum(Sprites.Num());
+	for (int32 FrameIndex = 0; FrameIndex < Sprites.Num(); ++FrameIndex)
+	{
+		UPaperSprite* Sprite = Sprites[FrameIndex];
+		UTexture2D* SourceTexture = Sprite->GetSourceTexture();
+		if (!SourceTexture)
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("SpriteAtlas: %s has no source texture"), *Sprite->GetName());
+			return 1;
+		}
+
+		FSourcePixels* Pixels = SourceTextures.Find(SourceTexture);
+		if (!Pixels)
+		{
+			Pixels = &SourceTextures.Add(SourceTexture);
+			if (SourceTexture->Source.GetFormat() != TSF_BGRA8 || !SourceTexture->Source.GetMipData(Pixels->Data, 0, 0, 0))
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("SpriteAtlas: %s is not readable BGRA8 source art"), *SourceTexture->GetName());
+				return 1;
+			}
+			Pixels->Width = SourceTexture->Source.GetSizeX();
+			Pixels->Height = SourceTexture->Source.GetSizeY();
+			SourceTexels += static_cast<int64>(Pixels->Width) * Pixels->Height;
+		}
+
+		const FIntPoint Min(FMath::RoundToInt32(Sprite->GetSourceUV().X), FMath::RoundToInt32(Sprite->GetSourceUV().Y));
+		const FIntPoint Max = Min + FIntPoint(FMath::RoundToInt32(Sprite->GetSourceSize().X), FMath::RoundToInt32(Sprite->GetSourceSize().Y));
+		FIntRect Trimmed(Max, Min);
+		for (int32 Y = FMath::Max(Min.Y, 0); Y < FMath::Min(Max.Y, Pixels->Height); ++Y)
+		{
+			for (int32 X = FMath::Max(Min.X, 0); X < FMath::Min(Max.X, Pixels->Width); ++X)
+			{
+				if (Pixels->Data[(static_cast<int64>(Y) * Pixels->Width + X) * 4 + 3] != 0)
+				{
+					Trimmed.Min = Trimmed.Min.ComponentMin(FIntPoint(X, Y));
+					Trimmed.Max = Trimmed.Max.ComponentMax(FIntPoint(X + 1, Y + 1));
+				}
+			}
+		}
+		if (Trimmed.Min.X >= Trimmed.Max.X)
+		{
+			// Fully transparent frame, keep a single texel so it still has a rectangle
+			Trimmed = FIntRect(Min, Min + FIntPoint(1, 1));
+		}
+
+		const FVector2D Pivot = Sprite->GetPivotPosition();
+		FSpriteAtlasFrame& Frame = Atlas->Frames[FrameIndex];
+		Frame.PivotX = static_cast<int16>(FMath::RoundToInt32(Pivot.X) - Trimmed.Min.X);
+		Frame.PivotY = static_cast<int16>(FMath::RoundToInt32(Pivot.Y) - Trimmed.Min.Y);
+
+		Entries.Add({ FrameIndex, Trimmed.Width(), Trimmed.Height() });
+		TrimmedRects.Add(Trimmed);
+		FrameTextures.Add(SourceTexture);
+	}
+
+	// Try every power of two width and keep the smallest power of two atlas
+	Entries.Sort([](const FPackEntry& A, const FPackEntry& B) { return A.Height != B.Height ? A.Height > B.Height : A.Width > B.Width; });
+	FIntPoint AtlasSize(MAX_int32, MAX_int32);
+	for (int32 Width = 32; Width <= MaxSize; Width *= 2)
+	{
+		const int32 Height = PackShelves(Entries, Width, Padding);
+		if (Height == INDEX_NONE || Height > MaxSize)
+		{
+			continue;
+		}
+
+		const FIntPoint Size(Width, static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(Height))));
+		if (static_cast<int64>(Size.X) * Size.Y < static_cast<int64>(AtlasSize.X) * AtlasSize.Y)
+		{
+			AtlasSize = Size;
+		}
+	}
+	if (AtlasSize.X == MAX_int32)
+	{
+		UE_LOG(LogNightFisherman, Error, TEXT("SpriteAtlas: %d frames do not fit in %dx%d"), Entries.Num(), MaxSize, MaxSize);
+		return 1;
+	}
+	PackShelves(Entries, AtlasSize.X, Padding);
+
+	// Copy the trimmed frames into place
+	TArray64<uint8> AtlasPixels;
+	AtlasPixels.SetNumZeroed(static_cast<int64>(AtlasSize.X) * AtlasSize.Y * 4);
+	for (const FPackEntry& Entry : Entries)
+	{
+		const FIntRect& Trimmed = TrimmedRects[Entry.FrameIndex];
+		const FSourcePixels& Pixels = SourceTextures.FindChecked(FrameTextures[Entry.FrameIndex]);
+		for (int32 Row = 0; Row < Entry.Height; ++Row)
+		{
+			FMemory::Memcpy(&AtlasPixels[(static_cast<int64>(Entry.Y + Row) * AtlasSize.X + Entry.X) * 4],
+				&Pixels.Data[(static_cast<int64>(Trimmed.Min.Y + Row) * Pixels.Width + Trimmed.Min.X) * 4], Entry.Width * 4);
+		}
+
+		FSpriteAtlasFrame& Frame = Atlas->Frames[Entry.FrameIndex];
+		Frame.X = static_cast<uint16>(Entry.X);
+		Frame.Y = static_cast<uint16>(Entry.Y);
+		Frame.Width = static_cast<uint16>(Entry.Width);
+		Frame.Height = static_cast<uint16>(Entry.Height);
+	}
+
+	UTexture2D* Texture = CreateAsset<UTexture2D>(OutputPath + TEXT("_Texture"));
+	Texture->Source.Init(AtlasSize.X, AtlasSize.Y, 1, 1, TSF_BGRA8, AtlasPixels.GetData());
+	Texture->SRGB = true;
+	Texture->Filter = TF_Nearest;
+	Texture->LODGroup = TEXTUREGROUP_Pixels2D;
+	Texture->CompressionSettings = TC_EditorIcon;
+	Texture->MipGenSettings = TMGS_NoMipmaps;
+	Texture->PostEditChange();
+
+	Atlas->Texture = Texture;
+	Atlas->TextureSize = AtlasSize;
+
+	if (!SaveAsset(Texture) || !SaveAsset(Atlas))
+	{
+		return 1;
+	}
+
+	UE_LOG(LogNightFisherman, Display, TEXT("SpriteAtlas: packed %d frames from %d flipbooks and %d textures into %dx%d (%.1f%% of the source texels), table %d bytes"),
+		Sprites.Num(), FlipbookAssets.Num(), SourceTextures.Num(), AtlasSize.X, AtlasSize.Y,
+		100.0 * AtlasSize.X * AtlasSize.Y / FMath::Max<int64>(SourceTexels, 1),
+		static_cast<int32>(Atlas->Frames.GetAllocatedSize() + Atlas->ClipFrames.GetAllocatedSize() + Atlas->Clips.GetAllocatedSize()));
+	return 0;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpriteAtlasCommandlet.generated.h"
+
+/**
+ * Packs every frame of a sprite character's flipbooks into one trimmed atlas texture and a USpriteAtlas
+ * frame table. Flipbooks are matched by name, <Prefix><Direction>_<State>_Flipbook, with Spawning and
+ * Dying sets used for every direction.
+ *
+ *   UnrealEditor-Cmd Night_Fisherman.uproject -run=SpriteAtlas
+ *     [-Source=/Game/Characters/Guy/Assets] [-Output=/Game/Characters/Guy/BeastlyGuyAtlas] [-Padding=1] [-MaxSize=4096]
+ *
+ * Writes <Output> (the frame table) and <Output>_Texture.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API USpriteAtlasCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USpriteAtlasCommandlet();
+
+	// UCommandlet implementation
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpriteCrowd.h"
+#include "Night_Fisherman.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sprite Crowd Step"), STAT_SpriteCrowdStep, STATGROUP_NightFisherman);
+
+namespace SpriteCrowd
+{
+	/** Walking speed in cm/s */
+	static constexpr float WalkSpeed = 150.0f;
+	/** Seconds a walker keeps idling or walking before picking again */
+	static constexpr float MinStateTime = 1.0f;
+	static constexpr float MaxStateTime = 4.0f;
+
+	/** Cheap integer hash for per-walker noise that is independent of thread scheduling */
+	FORCEINLINE uint32 Hash(uint32 A, uint32 B)
+	{
+		uint32 H = A * 0x9E3779B9u ^ B * 0x85EBCA6Bu;
+		H ^= H >> 16;
+		H *= 0x7FEB352Du;
+		H ^= H >> 15;
+		H *= 0x846CA68Bu;
+		H ^= H >> 16;
+		return H;
+	}
+}
+
+void FSpriteCrowd::AddWalkers(const FVector3f& Center, float Radius, int32 NumWalkers, int32 Seed)
+{
+	check(Areas.Num() < MAX_uint16);
+	const int32 AreaIndex = Areas.Add({ Center, Radius });
+
+	const int32 FirstWalker = Positions.Num();
+	const int32 NewNum = FirstWalker + NumWalkers;
+	Positions.SetNumUninitialized(NewNum);
+	Headings.SetNumUninitialized(NewNum);
+	StateTimers.SetNumUninitialized(NewNum);
+	AnimTimes.SetNumUninitialized(NewNum);
+	States.SetNumUninitialized(NewNum);
+	Directions.SetNumUninitialized(NewNum);
+	AreaIndices.SetNumUninitialized(NewNum);
+	InstanceTransforms.SetNum(NewNum);
+	InstanceCustomData.SetNumZeroed(NewNum * NumCustomData);
+
+	FRandomStream Random(Seed);
+	for (int32 Index = FirstWalker; Index < NewNum; ++Index)
+	{
+		const float Angle = Random.FRand() * UE_TWO_PI;
+		const float Distance = FMath::Sqrt(Random.FRand()) * Radius;
+		Positions[Index] = Center + FVector3f(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Distance;
+		Headings[Index] = Random.FRand() * UE_TWO_PI;
+
+		// Staggered timers and animation phases so walkers do not change state or frame in lockstep
+		StateTimers[Index] = Random.FRandRange(0.0f, SpriteCrowd::MaxStateTime);
+		AnimTimes[Index] = Random.FRand();
+		States[Index] = static_cast<uint8>(ESpriteAnimState::Idle);
+		Directions[Index] = static_cast<uint8>(ESpriteDirection::Down);
+		AreaIndices[Index] = static_cast<uint16>(AreaIndex);
+	}
+}
+
+void FSpriteCrowd::Reset()
+{
+	Positions.Reset();
+	Headings.Reset();
+	StateTimers.Reset();
+	AnimTimes.Reset();
+	States.Reset();
+	Directions.Reset();
+	AreaIndices.Reset();
+	Areas.Reset();
+	InstanceTransforms.Reset();
+	InstanceCustomData.Reset();
+	StepCount = 0;
+}
+
+void FSpriteCrowd::SetClips(TConstArrayView<FSpriteCrowdClip> InClips)
+{
+	for (int32 Index = 0; Index < Clips.Num(); ++Index)
+	{
+		Clips[Index] = InClips.IsValidIndex(Index) ? InClips[Index] : FSpriteCrowdClip();
+	}
+}
+
+void FSpriteCrowd::Step(float DeltaTime, double ViewYaw, const FQuat& Facing, const FVector& Scale, bool bParallel)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SpriteCrowdStep);
+
+	float ViewSin, ViewCos;
+	FMath::SinCos(&ViewSin, &ViewCos, static_cast<float>(FMath::DegreesToRadians(ViewYaw)));
+	const FVector2f ViewForward(ViewCos, ViewSin);
+	const FVector2f ViewRight(-ViewSin, ViewCos);
+
+	const int32 NumWalkers = Num();
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumWalkers, ChunkSize);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 Begin = ChunkIndex * ChunkSize;
+		StepRange(Begin, FMath::Min(Begin + ChunkSize, NumWalkers), DeltaTime, ViewForward, ViewRight, Facing, Scale);
+	}, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	++StepCount;
+}
+
+void FSpriteCrowd::StepRange(int32 Begin, int32 End, float DeltaTime, const FVector2f& ViewForward, const FVector2f& ViewRight, const FQuat& Facing, const FVector& Scale)
+{
+	using namespace SpriteCrowd;
+
+	FVector3f* RESTRICT PositionData = Positions.GetData();
+	float* RESTRICT HeadingData = Headings.GetData();
+	float* RESTRICT TimerData = StateTimers.GetData();
+	float* RESTRICT AnimTimeData = AnimTimes.GetData();
+	uint8* RESTRICT StateData = States.GetData();
+	uint8* RESTRICT DirectionData = Directions.GetData();
+	FTransform* RESTRICT TransformData = InstanceTransforms.GetData();
+	float* RESTRICT CustomData = InstanceCustomData.GetData();
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		uint8 State = StateData[Index];
+		float Heading = HeadingData[Index];
+		float AnimTime = AnimTimeData[Index] + DeltaTime;
+		float Timer = TimerData[Index] - DeltaTime;
+
+		// Pick a new state and heading when the current one runs out; three in four picks walk
+		if (Timer <= 0.0f)
+		{
+			const uint32 Noise = Hash(Index, StepCount);
+			const uint8 NewState = static_cast<uint8>((Noise & 3) != 0 ? ESpriteAnimState::Walk : ESpriteAnimState::Idle);
+			Heading = ((Noise >> 8) & 0xFFFF) * (UE_TWO_PI / 65535.0f);
+			Timer = MinStateTime + (Noise >> 24) * ((MaxStateTime - MinStateTime) / 255.0f);
+			if (NewState != State)
+			{
+				State = NewState;
+				AnimTime = 0.0f;
+			}
+		}
+
+		FVector3f Position = PositionData[Index];
+		if (State == static_cast<uint8>(ESpriteAnimState::Walk))
+		{
+			// Head back towards the centre after leaving the area
+			const FArea& Area = Areas[AreaIndices[Index]];
+			const FVector2f FromCenter(Position.X - Area.Center.X, Position.Y - Area.Center.Y);
+			if (FromCenter.SizeSquared() > FMath::Square(Area.Radius))
+			{
+				Heading = FMath::Atan2(-FromCenter.Y, -FromCenter.X);
+			}
+
+			FVector2f Direction;
+			FMath::SinCos(&Direction.Y, &Direction.X, Heading);
+			Position.X += Direction.X * WalkSpeed * DeltaTime;
+			Position.Y += Direction.Y * WalkSpeed * DeltaTime;
+
+			const float Along = Direction | ViewForward;
+			const float Side = Direction | ViewRight;
+			DirectionData[Index] = static_cast<uint8>(FMath::Abs(Along) >= FMath::Abs(Side)
+				? (Along >= 0.0f ? ESpriteDirection::Up : ESpriteDirection::Down)
+				: (Side >= 0.0f ? ESpriteDirection::Right : ESpriteDirection::Left));
+		}
+
+		const FSpriteCrowdClip& Clip = Clips[State];
+		const int32 Frame = Clip.FirstFrame + (Clip.NumFrames > 0 ? FMath::FloorToInt32(AnimTime * Clip.FramesPerSecond) % Clip.NumFrames : 0);
+
+		PositionData[Index] = Position;
+		HeadingData[Index] = Heading;
+		TimerData[Index] = Timer;
+		AnimTimeData[Index] = AnimTime;
+		StateData[Index] = State;
+
+		TransformData[Index] = FTransform(Facing, FVector(Position), Scale);
+		CustomData[Index * NumCustomData] = static_cast<float>(Frame);
+		CustomData[Index * NumCustomData + 1] = static_cast<float>(DirectionData[Index]);
+	}
+}
+
+SIZE_T FSpriteCrowd::GetAllocatedSize() const
+{
+	return Positions.GetAllocatedSize() + Headings.GetAllocatedSize() + StateTimers.GetAllocatedSize() + AnimTimes.GetAllocatedSize()
+		+ States.GetAllocatedSize() + Directions.GetAllocatedSize() + AreaIndices.GetAllocatedSize() + Areas.GetAllocatedSize()
+		+ InstanceTransforms.GetAllocatedSize() + InstanceCustomData.GetAllocatedSize();
+}
@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpriteAnimatorComponent.h"
+#include "SpriteCrowd.generated.h"
+
+/** Run of frames in a crowd sprite atlas played for one ESpriteAnimState */
+USTRUCT(BlueprintType)
+struct NIGHT_FISHERMAN_API FSpriteCrowdClip
+{
+	GENERATED_BODY()
+
+	/** Atlas frame the clip starts at */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation, meta = (ClampMin = "0"))
+	int32 FirstFrame = 0;
+
+	/** Frames in the clip; zero holds FirstFrame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation, meta = (ClampMin = "0"))
+	int32 NumFrames = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Animation, meta = (ClampMin = "0.0"))
+	float FramesPerSecond = 8.0f;
+};
+
+/**
+ * Wandering sprite characters stored as structure-of-arrays, with per-instance render data produced in the
+ * same pass that moves them. Each walker alternates between idling and walking in a random heading inside
+ * a disc. Step runs fixed-size chunks with ParallelFor and writes, per walker, an instance transform facing
+ * the view and NumCustomData floats: the atlas frame and the ESpriteDirection relative to the view.
+ */
+class NIGHT_FISHERMAN_API FSpriteCrowd
+{
+public:
+	/** Walkers per ParallelFor work item */
+	static constexpr int32 ChunkSize = 1024;
+
+	/** Per-instance custom data floats written for each walker */
+	static constexpr int32 NumCustomData = 2;
+
+	/** Adds NumWalkers idle walkers scattered over a disc of Radius around Center */
+	void AddWalkers(const FVector3f& Center, float Radius, int32 NumWalkers, int32 Seed);
+
+	/** Removes every walker */
+	void Reset();
+
+	/** Sets the clip played for each ESpriteAnimState, indexed by the enum */
+	void SetClips(TConstArrayView<FSpriteCrowdClip> InClips);
+
+	/**
+	 * Advances every walker by DeltaTime and rewrites the instance data. ViewYaw (degrees) orients facings,
+	 * Facing rotates each quad towards the camera and Scale sizes it.
+	 */
+	void Step(float DeltaTime, double ViewYaw, const FQuat& Facing, const FVector& Scale, bool bParallel = true);
+
+	int32 Num() const { return Positions.Num(); }
+
+	SIZE_T GetAllocatedSize() const;
+
+	/** Instance transforms from the last Step, relative to the crowd */
+	const TArray<FTransform>& GetInstanceTransforms() const { return InstanceTransforms; }
+
+	/** NumCustomData floats per walker from the last Step */
+	TConstArrayView<float> GetInstanceCustomData() const { return InstanceCustomData; }
+
+private:
+	struct FArea
+	{
+		FVector3f Center;
+		float Radius;
+	};
+
+	void StepRange(int32 Begin, int32 End, float DeltaTime, const FVector2f& ViewForward, const FVector2f& ViewRight, const FQuat& Facing, const FVector& Scale);
+
+	TArray<FVector3f> Positions;
+	TArray<float> Headings;
+	TArray<float> StateTimers;
+	TArray<float> AnimTimes;
+	TArray<uint8> States;
+	TArray<uint8> Directions;
+	TArray<uint16> AreaIndices;
+
+	TArray<FArea> Areas;
+	TStaticArray<FSpriteCrowdClip, static_cast<int32>(ESpriteAnimState::Count)> Clips;
+
+	TArray<FTransform> InstanceTransforms;
+	TArray<float> InstanceCustomData;
+
+	uint32 StepCount = 0;
+};
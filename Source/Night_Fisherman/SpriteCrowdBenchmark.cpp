@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkSubsystem.h"
+#include "SpriteCrowdRenderer.h"
+#include "Night_Fisherman.h"
+#include "PaperFlipbook.h"
+#include "PaperFlipbookComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+#include "HAL/IConsoleManager.h"
+#include "EngineUtils.h"
+
+namespace NightFishermanBenchmark
+{
+	/**
+	 * Animates NumWalkers BeastlyGuy sprites wandering around the player start, either as one instanced
+	 * ASpriteCrowdRenderer or as one actor with a flipbook component each, moved from the game thread
+	 */
+	class FSpriteCrowdScenario : public FScenario
+	{
+	public:
+		FSpriteCrowdScenario(int32 InNumWalkers, bool bInFlipbooks)
+			: NumWalkers(InNumWalkers)
+			, bFlipbooks(bInFlipbooks)
+		{
+		}
+
+		virtual FString GetName() const override
+		{
+			return FString::Printf(TEXT("SpriteCrowd_%s_%d"), bFlipbooks ? TEXT("Flipbooks") : TEXT("Instanced"), NumWalkers);
+		}
+
+		virtual void Setup(UWorld& World) override
+		{
+			if (TActorIterator<APlayerStart> It(&World); It)
+			{
+				Origin = It->GetActorLocation();
+			}
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+			if (!bFlipbooks)
+			{
+				// Deferred so BeginPlay does not add the renderer's default walkers on top of the benchmark's
+				if (ASpriteCrowdRenderer* Renderer = World.SpawnActorDeferred<ASpriteCrowdRenderer>(ASpriteCrowdRenderer::StaticClass(), FTransform(Origin), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn))
+				{
+					Renderer->SetNumWalkers(0);
+					Renderer->FinishSpawning(FTransform(Origin));
+					Renderer->Populate(NumWalkers, Radius, NumWalkers);
+					Crowd = Renderer;
+				}
+				return;
+			}
+
+			UPaperFlipbook* Flipbook = LoadObject<UPaperFlipbook>(nullptr, FlipbookPath);
+			if (!Flipbook)
+			{
+				UE_LOG(LogNightFisherman, Warning, TEXT("Benchmark %s: %s not found, flipbook actors will be empty"), *GetName(), FlipbookPath);
+			}
+
+			FlipbookActors.Reserve(NumWalkers);
+			for (int32 Index = 0; Index < NumWalkers; ++Index)
+			{
+				AActor* Actor = World.SpawnActor<AActor>(GetWalkerLocation(Index, 0), FRotator::ZeroRotator, SpawnParams);
+				UPaperFlipbookComponent* Sprite = NewObject<UPaperFlipbookComponent>(Actor);
+				Sprite->SetMobility(EComponentMobility::Movable);
+				Sprite->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+				Sprite->SetFlipbook(Flipbook);
+				Actor->SetRootComponent(Sprite);
+				Sprite->RegisterComponent();
+				FlipbookActors.Add(Actor);
+			}
+		}
+
+		virtual void PreFrame(UWorld& World, int32 FrameIndex, float DeltaTime) override
+		{
+			// The instanced crowd moves itself; the actors need a transform update each
+			const uint64 UploadStart = FPlatformTime::Cycles64();
+			for (int32 Index = 0; Index < FlipbookActors.Num(); ++Index)
+			{
+				if (AActor* Actor = FlipbookActors[Index].Get())
+				{
+					Actor->SetActorLocation(GetWalkerLocation(Index, FrameIndex));
+				}
+			}
+			FlipbookUploadMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - UploadStart));
+		}
+
+		virtual void GetExtraColumns(TArray<FString>& OutColumns) const override
+		{
+			OutColumns.Add(TEXT("Walkers"));
+			OutColumns.Add(TEXT("UploadMs"));
+		}
+
+		virtual void GetExtraValues(TArray<FString>& OutValues) const override
+		{
+			OutValues.Add(LexToString(Crowd.IsValid() ? Crowd->GetCrowd().Num() : FlipbookActors.Num()));
+			OutValues.Add(LexToString(Crowd.IsValid() ? Crowd->GetLastUploadMs() : FlipbookUploadMs));
+		}
+
+		virtual void Teardown(UWorld& World) override
+		{
+			if (Crowd.IsValid())
+			{
+				Crowd->Destroy();
+			}
+			for (const TWeakObjectPtr<AActor>& Actor : FlipbookActors)
+			{
+				if (Actor.IsValid())
+				{
+					Actor->Destroy();
+				}
+			}
+			FlipbookActors.Reset();
+		}
+
+	private:
+		static constexpr float Radius = 5000.0f;
+		static constexpr const TCHAR* FlipbookPath = TEXT("/Game/Characters/Guy/Assets/BeastlyGuySDown_Walk_Flipbook.BeastlyGuySDown_Walk_Flipbook");
+
+		/** Each actor walks its own circle, deterministic per frame */
+		FVector GetWalkerLocation(int32 Index, int32 FrameIndex) const
+		{
+			const float Ring = Radius * FMath::Sqrt((Index + 0.5f) / NumWalkers);
+			const float Angle = Index * 2.39996f + FrameIndex * 150.0f / (60.0f * FMath::Max(Ring, 100.0f));
+			return Origin + FVector(FMath::Cos(Angle) * Ring, FMath::Sin(Angle) * Ring, 0.0f);
+		}
+
+		int32 NumWalkers;
+		bool bFlipbooks;
+		FVector Origin = FVector::ZeroVector;
+		TWeakObjectPtr<ASpriteCrowdRenderer> Crowd;
+		TArray<TWeakObjectPtr<AActor>> FlipbookActors;
+
+		/** Time the last frame spent moving the flipbook actors, the counterpart of the crowd's upload */
+		float FlipbookUploadMs = 0.0f;
+	};
+
+	static FAutoConsoleCommandWithWorldAndArgs SpriteCrowdBenchmarkCommand(
+		TEXT("NF.Benchmark.SpriteCrowd"),
+		TEXT("Animates N sprite characters, instanced or as flipbook actors, and records per-frame game and render thread cost to CSV. Usage: NF.Benchmark.SpriteCrowd [Count=5000] [Frames=600] [Instanced|Flipbooks]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<UBenchmarkSubsystem>() : nullptr;
+			if (!Benchmark)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.SpriteCrowd needs a game world"));
+				return;
+			}
+
+			const int32 NumWalkers = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 5000;
+			const int32 NumFrames = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 600;
+			const bool bFlipbooks = Args.IsValidIndex(2) && Args[2].Equals(TEXT("Flipbooks"), ESearchCase::IgnoreCase);
+
+			Benchmark->StartScenario(MakeUnique<FSpriteCrowdScenario>(FMath::Max(NumWalkers, 1), bFlipbooks), NumFrames);
+		}));
+}
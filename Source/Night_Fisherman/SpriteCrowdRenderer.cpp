@@ -0,0 +1,132 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SpriteCrowdRenderer.h"
+#include "DeterminismSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/ConstructorHelpers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sprite Crowd Upload"), STAT_SpriteCrowdUpload, STATGROUP_NightFisherman);
+
+static TAutoConsoleVariable<bool> CVarSpriteCrowdParallel(
+	TEXT("NF.SpriteCrowd.Parallel"),
+	true,
+	TEXT("Step sprite crowds and build their instance data across task graph workers."));
+
+ASpriteCrowdRenderer::ASpriteCrowdRenderer()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	// The engine plane is 100 cm square with +Z as its normal
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> PlaneMesh(TEXT("/Engine/BasicShapes/Plane.Plane"));
+
+	Instances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("Instances"));
+	Instances->SetStaticMesh(PlaneMesh.Object);
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetCastShadow(false);
+	Instances->NumCustomDataFloats = FSpriteCrowd::NumCustomData;
+	RootComponent = Instances;
+
+	// Frame runs within each BeastlyGuyS<Direction> sheet
+	Clips.SetNum(static_cast<int32>(ESpriteAnimState::Count));
+	auto SetClip = [this](ESpriteAnimState State, int32 FirstFrame, int32 NumFrames, float FramesPerSecond)
+	{
+		FSpriteCrowdClip& Clip = Clips[static_cast<int32>(State)];
+		Clip.FirstFrame = FirstFrame;
+		Clip.NumFrames = NumFrames;
+		Clip.FramesPerSecond = FramesPerSecond;
+	};
+	SetClip(ESpriteAnimState::Idle, 0, 6, 8.0f);
+	SetClip(ESpriteAnimState::Walk, 6, 4, 8.0f);
+	SetClip(ESpriteAnimState::Push, 10, 4, 8.0f);
+	SetClip(ESpriteAnimState::Use, 14, 4, 8.0f);
+	SetClip(ESpriteAnimState::Frozen, 18, 2, 4.0f);
+}
+
+void ASpriteCrowdRenderer::Populate(int32 InNumWalkers, float InRadius, int32 Seed)
+{
+	Crowd.AddWalkers(FVector3f::ZeroVector, InRadius, InNumWalkers, Seed);
+	SyncInstanceCount();
+}
+
+void ASpriteCrowdRenderer::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	if (AtlasMaterial)
+	{
+		Instances->SetMaterial(0, AtlasMaterial);
+	}
+}
+
+// Called when the game starts or when spawned
+void ASpriteCrowdRenderer::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Crowd.SetClips(Clips);
+	if (NumWalkers > 0)
+	{
+		// Unique IDs depend on load order; the name is the same every run
+		Populate(NumWalkers, Radius, UDeterminismSubsystem::MakeSeed(GetTypeHash(GetFName())));
+	}
+}
+
+void ASpriteCrowdRenderer::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Crowd.Num() == 0)
+	{
+		return;
+	}
+
+	// Every quad faces the camera the same way, so the rotation is computed once
+	FRotator ViewRotation(-60.0f, 0.0f, 0.0f);
+	if (const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		if (PlayerController->PlayerCameraManager)
+		{
+			ViewRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+		}
+	}
+	// Walkers live in actor space, so the facing and the view yaw are brought into it too
+	const FQuat WorldFacing = FRotationMatrix::MakeFromZX(-ViewRotation.Vector(), FVector::UpVector).ToQuat();
+	const FQuat Facing = GetActorQuat().Inverse() * WorldFacing;
+	const FVector Scale(SpriteSize / 100.0f);
+
+	Crowd.Step(DeltaTime, ViewRotation.Yaw - GetActorRotation().Yaw, Facing, Scale, CVarSpriteCrowdParallel.GetValueOnGameThread());
+
+	SCOPE_CYCLE_COUNTER(STAT_SpriteCrowdUpload);
+	const uint64 UploadStart = FPlatformTime::Cycles64();
+
+	Instances->BatchUpdateInstancesTransforms(0, Crowd.GetInstanceTransforms(), false, false, true);
+
+	// The crowd built its custom data in the component's layout, so it goes in as one block instead of a call per instance
+	const TConstArrayView<float> CustomData = Crowd.GetInstanceCustomData();
+	check(Instances->PerInstanceSMCustomData.Num() == CustomData.Num());
+	FMemory::Memcpy(Instances->PerInstanceSMCustomData.GetData(), CustomData.GetData(), CustomData.NumBytes());
+
+	// Written behind the component's back, so the instance data is rebuilt from its arrays once at the end of the frame
+	Instances->MarkRenderStateDirty();
+
+	LastUploadMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - UploadStart));
+}
+
+void ASpriteCrowdRenderer::SyncInstanceCount()
+{
+	const int32 NumMissing = Crowd.Num() - Instances->GetInstanceCount();
+	if (NumMissing > 0)
+	{
+		TArray<FTransform> NewTransforms;
+		NewTransforms.Init(FTransform::Identity, NumMissing);
+		Instances->AddInstances(NewTransforms, false, false, false);
+	}
+}
@@ -0,0 +1,79 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SpriteCrowd.h"
+#include "SpriteCrowdRenderer.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+
+/**
+ * Draws a crowd of wandering sprite characters as instances of one quad mesh: one draw for the whole crowd,
+ * no component per character. The simulation and the per-instance data are updated in parallel by FSpriteCrowd.
+ *
+ * The instance material picks the frame from per-instance custom data: index 0 is the frame within the
+ * character atlas (see Clips) and index 1 is the ESpriteDirection, relative to the view, selecting the
+ * direction's sheet.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API ASpriteCrowdRenderer : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ASpriteCrowdRenderer();
+
+	/** Adds NumWalkers walkers in a disc of Radius around the actor, on top of any already there */
+	void Populate(int32 NumWalkers, float Radius, int32 Seed);
+
+	/** Sets the walkers BeginPlay adds; only has an effect before play begins */
+	void SetNumWalkers(int32 InNumWalkers) { NumWalkers = InNumWalkers; }
+
+	const FSpriteCrowd& GetCrowd() const { return Crowd; }
+
+	/** Game thread time the last Tick took to hand the crowd's transforms and custom data to the instances */
+	float GetLastUploadMs() const { return LastUploadMs; }
+
+	// AActor implementation
+	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/** Quad instances, one per walker */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Rendering, meta = (AllowPrivateAccess = "true"))
+	UInstancedStaticMeshComponent* Instances;
+
+	/** Instance material sampling the character atlas with the custom data described above */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Rendering)
+	UMaterialInterface* AtlasMaterial = nullptr;
+
+	/** Walkers added when play begins */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crowd, meta = (ClampMin = "0"))
+	int32 NumWalkers = 500;
+
+	/** Radius of the area around the actor the walkers wander in */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crowd, meta = (ClampMin = "100.0"))
+	float Radius = 3000.0f;
+
+	/** World size of a walker's quad in cm */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Crowd, meta = (ClampMin = "1.0"))
+	float SpriteSize = 100.0f;
+
+	/** Atlas frames played for each ESpriteAnimState, in enum order; defaults match the BeastlyGuy direction sheets */
+	UPROPERTY(EditAnywhere, EditFixedSize, BlueprintReadOnly, Category = Crowd)
+	TArray<FSpriteCrowdClip> Clips;
+
+private:
+	/** Grows the instance count to match the crowd */
+	void SyncInstanceCount();
+
+	FSpriteCrowd Crowd;
+
+	float LastUploadMs = 0.0f;
+};
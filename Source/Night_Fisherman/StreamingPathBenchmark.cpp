@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkSubsystem.h"
+#include "StreamingTelemetrySubsystem.h"
+#include "Night_Fisherman.h"
+#include "TopDownCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+namespace NightFishermanBenchmark
+{
+	/**
+	 * Walks the player's ATopDownCharacter around a square of LegLength from where it stands, looping, while
+	 * UStreamingTelemetrySubsystem records what streams in and out. Run with -benchmark -fps=60 for a fixed
+	 * timestep so the same path is walked frame for frame on every build.
+	 *
+	 * Results are named after NF.Streaming.Predictive, so running once with it on and once off leaves both
+	 * sets of files to compare hitches and peak resident memory.
+	 */
+	class FStreamingPathScenario : public FScenario
+	{
+	public:
+		FStreamingPathScenario(float InLegLength, bool bInPredictive)
+			: LegLength(InLegLength)
+			, bPredictive(bInPredictive)
+		{
+		}
+
+		virtual FString GetName() const override
+		{
+			return bPredictive ? TEXT("StreamingPath_Predictive") : TEXT("StreamingPath_Default");
+		}
+
+		virtual void Setup(UWorld& World) override
+		{
+			const APlayerController* PlayerController = World.GetFirstPlayerController();
+			Character = PlayerController ? Cast<ATopDownCharacter>(PlayerController->GetPawn()) : nullptr;
+			if (!Character.IsValid())
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("Benchmark %s: the player is not controlling an ATopDownCharacter"), *GetName());
+				return;
+			}
+
+			const FVector Start = Character->GetActorLocation();
+			Waypoints = { Start + FVector(LegLength, 0.0, 0.0), Start + FVector(LegLength, LegLength, 0.0), Start + FVector(0.0, LegLength, 0.0), Start };
+			NextWaypoint = 0;
+
+			Telemetry = World.GetSubsystem<UStreamingTelemetrySubsystem>();
+			if (Telemetry.IsValid())
+			{
+				Telemetry->StartRecording();
+			}
+		}
+
+		virtual void PreFrame(UWorld& World, int32 FrameIndex, float DeltaTime) override
+		{
+			ATopDownCharacter* Walker = Character.Get();
+			if (!Walker)
+			{
+				return;
+			}
+
+			FVector ToWaypoint = Waypoints[NextWaypoint] - Walker->GetActorLocation();
+			ToWaypoint.Z = 0.0;
+			if (ToWaypoint.SizeSquared() < FMath::Square(ArriveDistance))
+			{
+				NextWaypoint = (NextWaypoint + 1) % Waypoints.Num();
+				ToWaypoint = Waypoints[NextWaypoint] - Walker->GetActorLocation();
+				ToWaypoint.Z = 0.0;
+			}
+			Walker->AddMovementInput(ToWaypoint.GetSafeNormal());
+		}
+
+		virtual void GetExtraColumns(TArray<FString>& OutColumns) const override
+		{
+			OutColumns.Add(TEXT("X"));
+			OutColumns.Add(TEXT("Y"));
+			OutColumns.Add(TEXT("Waypoint"));
+			OutColumns.Add(TEXT("Hitches"));
+			OutColumns.Add(TEXT("PeakResidentMB"));
+		}
+
+		virtual void GetExtraValues(TArray<FString>& OutValues) const override
+		{
+			const FVector Location = Character.IsValid() ? Character->GetActorLocation() : FVector::ZeroVector;
+			OutValues.Add(LexToString(Location.X));
+			OutValues.Add(LexToString(Location.Y));
+			OutValues.Add(LexToString(NextWaypoint));
+			OutValues.Add(LexToString(Telemetry.IsValid() ? Telemetry->GetNumHitches() : 0));
+			OutValues.Add(LexToString(Telemetry.IsValid() ? Telemetry->GetPeakUsedPhysical() / (1024.0 * 1024.0) : 0.0));
+		}
+
+		virtual void Teardown(UWorld& World) override
+		{
+			if (Telemetry.IsValid())
+			{
+				Telemetry->StopRecording(GetName());
+			}
+		}
+
+	private:
+		static constexpr float ArriveDistance = 100.0f;
+
+		float LegLength;
+		bool bPredictive;
+		TWeakObjectPtr<ATopDownCharacter> Character;
+		TWeakObjectPtr<UStreamingTelemetrySubsystem> Telemetry;
+		TArray<FVector> Waypoints;
+		int32 NextWaypoint = 0;
+	};
+
+	static FAutoConsoleCommandWithWorldAndArgs StreamingPathBenchmarkCommand(
+		TEXT("NF.Benchmark.StreamingPath"),
+		TEXT("Walks the player character around a square while recording level streaming telemetry and per-frame cost, hitches and peak resident memory. Usage: NF.Benchmark.StreamingPath [LegLength=20000] [Frames=3600]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<UBenchmarkSubsystem>() : nullptr;
+			if (!Benchmark)
+			{
+				UE_LOG(LogNightFisherman, Error, TEXT("NF.Benchmark.StreamingPath needs a game world"));
+				return;
+			}
+
+			const float LegLength = Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 20000.0f;
+			const int32 NumFrames = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 3600;
+			const IConsoleVariable* Predictive = IConsoleManager::Get().FindConsoleVariable(TEXT("NF.Streaming.Predictive"));
+
+			Benchmark->StartScenario(MakeUnique<FStreamingPathScenario>(FMath::Max(LegLength, 1000.0f), Predictive && Predictive->GetBool()), NumFrames);
+		}));
+}
@@ -0,0 +1,236 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "StreamingTelemetrySubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "IO/IoDispatcher.h"
+#include "IO/PackageId.h"
+#include "Streaming/LevelStreamingDelegates.h"
+#include "UObject/PackageResourceManager.h"
+
+void UStreamingTelemetrySubsystem::StartRecording()
+{
+	if (!IsRecording())
+	{
+		StateChangedHandle = FLevelStreamingDelegates::OnLevelStreamingStateChanged.AddUObject(this, &UStreamingTelemetrySubsystem::HandleStateChanged);
+	}
+
+	Cells.Reset();
+	Events = MakeUnique<NightFishermanBenchmark::FCsvWriter>(TEXT("StreamingEvents"),
+		TArray<FString>{ TEXT("Time"), TEXT("Frame"), TEXT("Cell"), TEXT("From"), TEXT("To"), TEXT("Bytes"), TEXT("Actors") });
+	CellsMakingVisible.Reset();
+	StartTime = FPlatformTime::Seconds();
+	StartFrame = GFrameCounter;
+	BaselineGameThreadMs = -1.0;
+	NumHitches = 0;
+	PeakUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+
+	UE_LOG(LogNightFisherman, Display, TEXT("Streaming telemetry: recording"));
+}
+
+bool UStreamingTelemetrySubsystem::StopRecording(const FString& Name)
+{
+	if (!IsRecording())
+	{
+		return false;
+	}
+
+	FLevelStreamingDelegates::OnLevelStreamingStateChanged.Remove(StateChangedHandle);
+	StateChangedHandle.Reset();
+
+	using namespace NightFishermanBenchmark;
+
+	Events->SetName(Name + TEXT("_StreamingEvents"));
+	Events->Save();
+
+	// Sorted by name so two builds' files line up
+	Cells.KeySort(FNameLexicalLess());
+	FCsvWriter CellTable(Name + TEXT("_StreamingCells"), { TEXT("Cell"), TEXT("Loads"), TEXT("Unloads"), TEXT("FirstRequestTime"), TEXT("LoadMs"), TEXT("MaxLoadMs"),
+		TEXT("MakingVisibleMs"), TEXT("MakingVisibleFrames"), TEXT("AddToWorldGameThreadMs"), TEXT("BytesRead"), TEXT("Actors") });
+	for (const TPair<FName, FCellRecord>& Cell : Cells)
+	{
+		const FCellRecord& Record = Cell.Value;
+		CellTable.AddRow(Cell.Key.ToString(), Record.Loads, Record.Unloads, Record.FirstRequestTime, Record.LoadMs, Record.MaxLoadMs,
+			Record.MakingVisibleMs, Record.MakingVisibleFrames, Record.AddToWorldGameThreadMs, Record.BytesRead, Record.NumActors);
+	}
+	CellTable.Save();
+
+	UE_LOG(LogNightFisherman, Display, TEXT("Streaming telemetry %s: %d cells, %d events, %d hitches, %.1f MB peak resident over %.1f s"),
+		*Name, Cells.Num(), Events->NumRows(), NumHitches, PeakUsedPhysical / (1024.0 * 1024.0), GetRecordingTime());
+	Events.Reset();
+	return true;
+}
+
+void UStreamingTelemetrySubsystem::Deinitialize()
+{
+	if (IsRecording())
+	{
+		FLevelStreamingDelegates::OnLevelStreamingStateChanged.Remove(StateChangedHandle);
+		StateChangedHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+bool UStreamingTelemetrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStreamingTelemetrySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	// GGameThreadTime holds the last finished frame, the one the cells collected since the previous tick ran in
+	const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	NumHitches += GameThreadMs > HitchThresholdMs;
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+
+	if (CellsMakingVisible.IsEmpty())
+	{
+		BaselineGameThreadMs = BaselineGameThreadMs < 0.0 ? GameThreadMs : FMath::Lerp(BaselineGameThreadMs, GameThreadMs, 0.1);
+		return;
+	}
+
+	const double ExcessMs = FMath::Max(GameThreadMs - FMath::Max(BaselineGameThreadMs, 0.0), 0.0) / CellsMakingVisible.Num();
+	for (const FName Cell : CellsMakingVisible)
+	{
+		FCellRecord& Record = Cells.FindChecked(Cell);
+		Record.AddToWorldGameThreadMs += ExcessMs;
+		++Record.MakingVisibleFrames;
+	}
+
+	CellsMakingVisible.RemoveAll([this](FName Cell) { return !Cells.FindChecked(Cell).bMakingVisible; });
+}
+
+TStatId UStreamingTelemetrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStreamingTelemetrySubsystem, STATGROUP_Tickables);
+}
+
+void UStreamingTelemetrySubsystem::HandleStateChanged(UWorld* World, const ULevelStreaming* StreamingLevel, ULevel* LevelIfLoaded, ELevelStreamingState PreviousState, ELevelStreamingState NewState)
+{
+	if (World != GetWorld() || !StreamingLevel)
+	{
+		return;
+	}
+
+	const FName PackageName = StreamingLevel->GetWorldAssetPackageFName();
+	FCellRecord& Record = Cells.FindOrAdd(PackageName);
+	const double Time = GetRecordingTime();
+
+	int64 Bytes = 0;
+	switch (NewState)
+	{
+	case ELevelStreamingState::Loading:
+		Record.LoadingStartTime = Time;
+		if (Record.FirstRequestTime < 0.0)
+		{
+			Record.FirstRequestTime = Time;
+		}
+		break;
+
+	case ELevelStreamingState::LoadedNotVisible:
+		if (PreviousState == ELevelStreamingState::Loading && Record.LoadingStartTime >= 0.0)
+		{
+			const double LoadMs = (Time - Record.LoadingStartTime) * 1000.0;
+			Record.LoadMs += LoadMs;
+			Record.MaxLoadMs = FMath::Max(Record.MaxLoadMs, LoadMs);
+			Record.LoadingStartTime = -1.0;
+			++Record.Loads;
+
+			Bytes = FMath::Max(GetPackageBytes(PackageName), int64(0));
+			Record.BytesRead += Bytes;
+		}
+		break;
+
+	case ELevelStreamingState::MakingVisible:
+		Record.MakingVisibleStartTime = Time;
+		Record.bMakingVisible = true;
+		CellsMakingVisible.AddUnique(PackageName);
+		break;
+
+	case ELevelStreamingState::Unloaded:
+	case ELevelStreamingState::Removed:
+		Record.Unloads += PreviousState != ELevelStreamingState::Unloaded && PreviousState != ELevelStreamingState::Removed;
+		break;
+
+	default:
+		break;
+	}
+
+	// Leaving MakingVisible, whether it finished or was cancelled
+	if (PreviousState == ELevelStreamingState::MakingVisible && Record.bMakingVisible)
+	{
+		Record.MakingVisibleMs += (Time - Record.MakingVisibleStartTime) * 1000.0;
+		Record.bMakingVisible = false;
+	}
+
+	if (LevelIfLoaded)
+	{
+		Record.NumActors = LevelIfLoaded->Actors.Num();
+	}
+
+	Events->AddRow(Time, GFrameCounter - StartFrame, PackageName.ToString(), FString(EnumToString(PreviousState)), FString(EnumToString(NewState)), Bytes, Record.NumActors);
+}
+
+int64 UStreamingTelemetrySubsystem::GetPackageBytes(FName PackageName)
+{
+	// Cooked builds read packages from IoStore containers
+	if (FIoDispatcher::IsInitialized())
+	{
+		const TIoStatusOr<uint64> Size = FIoDispatcher::Get().GetSizeForChunk(CreatePackageDataChunkId(FPackageId::FromName(PackageName)));
+		if (Size.IsOk())
+		{
+			return static_cast<int64>(Size.ValueOrDie());
+		}
+	}
+
+	FPackagePath PackagePath;
+	if (!FPackagePath::TryFromPackageName(PackageName, PackagePath))
+	{
+		return INDEX_NONE;
+	}
+
+	IPackageResourceManager& Resources = IPackageResourceManager::Get();
+	const int64 HeaderBytes = Resources.FileSize(PackagePath, EPackageSegment::Header);
+	if (HeaderBytes < 0)
+	{
+		return INDEX_NONE;
+	}
+	return HeaderBytes + FMath::Max(Resources.FileSize(PackagePath, EPackageSegment::Exports), int64(0));
+}
+
+double UStreamingTelemetrySubsystem::GetRecordingTime() const
+{
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs StreamingTelemetryCommand(
+	TEXT("NF.Streaming.Telemetry"),
+	TEXT("Starts or stops recording level streaming telemetry. Usage: NF.Streaming.Telemetry Start | Stop [Name=Streaming]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UStreamingTelemetrySubsystem* Telemetry = World ? World->GetSubsystem<UStreamingTelemetrySubsystem>() : nullptr;
+		if (!Telemetry)
+		{
+			UE_LOG(LogNightFisherman, Error, TEXT("NF.Streaming.Telemetry needs a game world"));
+			return;
+		}
+
+		if (Args.IsValidIndex(0) && Args[0].Equals(TEXT("Stop"), ESearchCase::IgnoreCase))
+		{
+			Telemetry->StopRecording(Args.IsValidIndex(1) ? Args[1] : TEXT("Streaming"));
+		}
+		else
+		{
+			Telemetry->StartRecording();
+		}
+	}));
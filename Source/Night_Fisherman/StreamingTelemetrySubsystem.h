@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/LevelStreaming.h"
+#include "NightFishermanBenchmark.h"
+#include "StreamingTelemetrySubsystem.generated.h"
+
+class ULevel;
+
+/**
+ * Records when streaming levels (World Partition runtime cells included) load, become visible and unload,
+ * with the package bytes read per load and the game thread time spent making each cell visible. Hitches and
+ * peak resident memory are tracked over the whole recording.
+ *
+ * The game thread cost of AddToWorld is estimated per frame: game thread time above a running baseline of
+ * frames with nothing becoming visible, split between the cells that were being made visible in that frame.
+ *
+ * StopRecording writes two CSVs next to the benchmark output: <Name>_StreamingEvents (every state change, in
+ * order) and <Name>_StreamingCells (one row per cell, sorted by name, for diffing builds).
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UStreamingTelemetrySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Starts a new recording, discarding any unsaved one */
+	void StartRecording();
+
+	/** Stops recording and writes the trace files; returns false if nothing was recording */
+	bool StopRecording(const FString& Name);
+
+	bool IsRecording() const { return StateChangedHandle.IsValid(); }
+
+	/** Frames since StartRecording whose game thread time exceeded HitchThresholdMs */
+	int32 GetNumHitches() const { return NumHitches; }
+
+	/** Highest resident memory of the process sampled since StartRecording, in bytes */
+	uint64 GetPeakUsedPhysical() const { return PeakUsedPhysical; }
+
+	/** Game thread frame time above which a frame counts as a hitch */
+	static constexpr float HitchThresholdMs = 50.0f;
+
+	// USubsystem implementation
+	virtual void Deinitialize() override;
+
+	// UWorldSubsystem implementation
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FCellRecord
+	{
+		int32 Loads = 0;
+		int32 Unloads = 0;
+		int64 BytesRead = 0;
+		int32 NumActors = 0;
+
+		/** Seconds from the start of the recording */
+		double FirstRequestTime = -1.0;
+		double LoadingStartTime = -1.0;
+		double MakingVisibleStartTime = -1.0;
+
+		double LoadMs = 0.0;
+		double MaxLoadMs = 0.0;
+		double MakingVisibleMs = 0.0;
+		int32 MakingVisibleFrames = 0;
+		double AddToWorldGameThreadMs = 0.0;
+
+		bool bMakingVisible = false;
+	};
+
+	void HandleStateChanged(UWorld* World, const ULevelStreaming* StreamingLevel, ULevel* LevelIfLoaded, ELevelStreamingState PreviousState, ELevelStreamingState NewState);
+
+	/** Size of a package as stored on disk or in the container, or INDEX_NONE if unknown (e.g. cells generated for PIE) */
+	static int64 GetPackageBytes(FName PackageName);
+
+	double GetRecordingTime() const;
+
+	FDelegateHandle StateChangedHandle;
+
+	TMap<FName, FCellRecord> Cells;
+	TUniquePtr<NightFishermanBenchmark::FCsvWriter> Events;
+
+	/** Cells being made visible at some point since the last tick */
+	TArray<FName> CellsMakingVisible;
+
+	double StartTime = 0.0;
+	uint64 StartFrame = 0;
+	double BaselineGameThreadMs = -1.0;
+	int32 NumHitches = 0;
+	uint64 PeakUsedPhysical = 0;
+};
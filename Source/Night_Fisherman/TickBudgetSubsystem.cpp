@@ -0,0 +1,240 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TickBudgetSubsystem.h"
+#include "DeterminismSubsystem.h"
+#include "Night_Fisherman.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tick Budget"), STAT_TickBudget, STATGROUP_NightFisherman);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budgeted Ticks"), STAT_TickBudget_Ticked, STATGROUP_NightFisherman);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Budgeted Ticks Deferred"), STAT_TickBudget_Deferred, STATGROUP_NightFisherman);
+
+static TAutoConsoleVariable<float> CVarTickBudgetMs(
+	TEXT("NF.TickBudget.BudgetMs"),
+	2.0f,
+	TEXT("Game thread milliseconds per frame for time-sliced budgeted ticks. Critical ticks are not counted against it."));
+
+static TAutoConsoleVariable<float> CVarTickBudgetFarDistance(
+	TEXT("NF.TickBudget.FarDistance"),
+	3000.0f,
+	TEXT("Distance from the local view beyond which Normal priority ticks are throttled."));
+
+static TAutoConsoleVariable<float> CVarTickBudgetFarInterval(
+	TEXT("NF.TickBudget.FarInterval"),
+	0.1f,
+	TEXT("Minimum seconds between ticks for Normal priority objects beyond NF.TickBudget.FarDistance."));
+
+static TAutoConsoleVariable<float> CVarTickBudgetBackgroundInterval(
+	TEXT("NF.TickBudget.BackgroundInterval"),
+	0.25f,
+	TEXT("Minimum seconds between ticks for Background priority objects."));
+
+void UTickBudgetSubsystem::Register(UObject* Object, ETickBudgetPriority Priority)
+{
+	IBudgetedTickable* Tickable = Cast<IBudgetedTickable>(Object);
+	if (!ensureMsgf(Tickable, TEXT("%s does not implement IBudgetedTickable"), *GetNameSafe(Object)))
+	{
+		return;
+	}
+
+	TArray<FEntry>& Entries = Priority == ETickBudgetPriority::Critical ? CriticalEntries : SlicedEntries;
+	for (FEntry& Entry : Entries)
+	{
+		if (Entry.Tickable == Tickable)
+		{
+			Entry.Priority = Priority;
+			return;
+		}
+	}
+
+	// Moving between the critical and sliced lists
+	Unregister(Object);
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Object = Object;
+	Entry.Tickable = Tickable;
+	Entry.Actor = Cast<AActor>(Object);
+	Entry.Priority = Priority;
+}
+
+void UTickBudgetSubsystem::Unregister(UObject* Object)
+{
+	const IBudgetedTickable* Tickable = Cast<IBudgetedTickable>(Object);
+	if (!Tickable)
+	{
+		return;
+	}
+
+	for (TArray<FEntry>* Entries : { &CriticalEntries, &SlicedEntries })
+	{
+		const int32 Index = Entries->IndexOfByPredicate([Tickable](const FEntry& Entry) { return Entry.Tickable == Tickable; });
+		if (Index == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (bIsTicking)
+		{
+			(*Entries)[Index].Tickable = nullptr;
+			bNeedsCompaction = true;
+		}
+		else
+		{
+			Entries->RemoveAt(Index, 1, EAllowShrinking::No);
+			if (Entries == &SlicedEntries && Index < SliceCursor)
+			{
+				--SliceCursor;
+			}
+		}
+	}
+}
+
+bool UTickBudgetSubsystem::IsRegistered(const UObject* Object) const
+{
+	auto Matches = [Object](const FEntry& Entry) { return Entry.Tickable && Entry.Object.Get() == Object; };
+	return Object && (CriticalEntries.ContainsByPredicate(Matches) || SlicedEntries.ContainsByPredicate(Matches));
+}
+
+void UTickBudgetSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TickBudget);
+	Super::Tick(DeltaTime);
+
+	TGuardValue<bool> TickingGuard(bIsTicking, true);
+
+	// Entries may be added while ticking, so iterate by index and never hold a reference across BudgetedTick
+	for (int32 Index = 0; Index < CriticalEntries.Num(); ++Index)
+	{
+		if (CriticalEntries[Index].IsLive())
+		{
+			CriticalEntries[Index].Tickable->BudgetedTick(DeltaTime);
+		}
+		else
+		{
+			bNeedsCompaction = true;
+		}
+	}
+
+	FVector ViewLocation;
+	const FVector* ViewLocationPtr = nullptr;
+	if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		ViewLocationPtr = &ViewLocation;
+	}
+
+	const int32 NumSliced = SlicedEntries.Num();
+	for (FEntry& Entry : SlicedEntries)
+	{
+		Entry.PendingDeltaTime += DeltaTime;
+	}
+
+	const uint64 BudgetCycles = static_cast<uint64>(CVarTickBudgetMs.GetValueOnGameThread() / 1000.0 / FPlatformTime::GetSecondsPerCycle64());
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// A wall-clock budget makes which objects tick depend on the machine, so deterministic runs tick everything due
+	const bool bTimeSliced = !UDeterminismSubsystem::IsEnabled();
+	int32 NumVisited = 0;
+	int32 NumTicked = 0;
+	int32 NumDue = 0;
+
+	while (NumVisited < NumSliced)
+	{
+		if (SliceCursor >= NumSliced)
+		{
+			SliceCursor = 0;
+		}
+
+		const int32 Index = SliceCursor++;
+		++NumVisited;
+
+		const FEntry& Entry = SlicedEntries[Index];
+		if (!Entry.IsLive())
+		{
+			bNeedsCompaction = true;
+			continue;
+		}
+
+		if (Entry.PendingDeltaTime < GetInterval(Entry, ViewLocationPtr))
+		{
+			continue;
+		}
+
+		++NumDue;
+		if (bTimeSliced && NumTicked > 0 && FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+		{
+			// Out of budget: resume from this entry next frame, its DeltaTime keeps accumulating
+			--SliceCursor;
+			break;
+		}
+
+		const float EntryDeltaTime = Entry.PendingDeltaTime;
+		SlicedEntries[Index].PendingDeltaTime = 0.0f;
+		SlicedEntries[Index].Tickable->BudgetedTick(EntryDeltaTime);
+		++NumTicked;
+	}
+
+	SET_DWORD_STAT(STAT_TickBudget_Ticked, CriticalEntries.Num() + NumTicked);
+	SET_DWORD_STAT(STAT_TickBudget_Deferred, NumDue - NumTicked);
+
+	if (bNeedsCompaction)
+	{
+		Compact();
+	}
+}
+
+TStatId UTickBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTickBudgetSubsystem, STATGROUP_Tickables);
+}
+
+float UTickBudgetSubsystem::GetInterval(const FEntry& Entry, const FVector* ViewLocation) const
+{
+	if (Entry.Priority == ETickBudgetPriority::Background)
+	{
+		return CVarTickBudgetBackgroundInterval.GetValueOnGameThread();
+	}
+
+	if (ViewLocation && Entry.Actor)
+	{
+		const float FarDistance = CVarTickBudgetFarDistance.GetValueOnGameThread();
+		if (FVector::DistSquared(*ViewLocation, Entry.Actor->GetActorLocation()) > FMath::Square(FarDistance))
+		{
+			return CVarTickBudgetFarInterval.GetValueOnGameThread();
+		}
+	}
+
+	return 0.0f;
+}
+
+void UTickBudgetSubsystem::Compact()
+{
+	bNeedsCompaction = false;
+
+	CriticalEntries.RemoveAll([](const FEntry& Entry) { return !Entry.IsLive(); });
+
+	int32 NumLive = 0;
+	int32 NewCursor = 0;
+	for (int32 Index = 0; Index < SlicedEntries.Num(); ++Index)
+	{
+		if (Index == SliceCursor)
+		{
+			NewCursor = NumLive;
+		}
+		if (SlicedEntries[Index].IsLive())
+		{
+			SlicedEntries[NumLive++] = SlicedEntries[Index];
+		}
+	}
+	if (SliceCursor >= SlicedEntries.Num())
+	{
+		NewCursor = NumLive;
+	}
+
+	SlicedEntries.SetNum(NumLive, EAllowShrinking::No);
+	SliceCursor = NewCursor;
+}
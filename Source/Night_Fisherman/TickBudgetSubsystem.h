@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PausableWorldSubsystem.h"
+#include "UObject/Interface.h"
+#include "TickBudgetSubsystem.generated.h"
+
+/** How UTickBudgetSubsystem schedules a registered object */
+UENUM()
+enum class ETickBudgetPriority : uint8
+{
+	/** Ticked every frame regardless of budget, e.g. the locally controlled character */
+	Critical,
+	/** Time-sliced within NF.TickBudget.BudgetMs and throttled beyond NF.TickBudget.FarDistance from the view */
+	Normal,
+	/** Time-sliced and never ticked more often than NF.TickBudget.BackgroundInterval */
+	Background,
+};
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UBudgetedTickable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/** Implemented by gameplay objects that let UTickBudgetSubsystem batch their per-frame work */
+class NIGHT_FISHERMAN_API IBudgetedTickable
+{
+	GENERATED_BODY()
+
+public:
+	/** DeltaTime covers every frame since the previous call, so throttled objects still integrate correctly */
+	virtual void BudgetedTick(float DeltaTime) = 0;
+};
+
+/**
+ * Ticks registered gameplay objects from one batched loop instead of one tick function each.
+ * Critical objects run every frame; the rest are round-robin time-sliced within a per-frame budget
+ * and throttled with distance from the local view. Objects that miss a frame accumulate its DeltaTime.
+ * In deterministic mode (UDeterminismSubsystem) the budget is lifted and every due object ticks in registration order.
+ */
+UCLASS()
+class NIGHT_FISHERMAN_API UTickBudgetSubsystem : public UPausableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Starts ticking Object, which must implement IBudgetedTickable. Re-registering changes the priority. */
+	void Register(UObject* Object, ETickBudgetPriority Priority);
+
+	/** Stops ticking Object. Safe to call from inside BudgetedTick. */
+	void Unregister(UObject* Object);
+
+	bool IsRegistered(const UObject* Object) const;
+
+	// FTickableGameObject implementation
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UObject> Object;
+		IBudgetedTickable* Tickable = nullptr;
+		AActor* Actor = nullptr;
+		float PendingDeltaTime = 0.0f;
+		ETickBudgetPriority Priority = ETickBudgetPriority::Normal;
+
+		bool IsLive() const { return Tickable != nullptr && Object.IsValid(); }
+	};
+
+	/** Minimum time between ticks for a sliced entry */
+	float GetInterval(const FEntry& Entry, const FVector* ViewLocation) const;
+
+	/** Drops entries unregistered or destroyed while ticking, keeping the slice cursor on the same entry */
+	void Compact();
+
+	TArray<FEntry> CriticalEntries;
+	TArray<FEntry> SlicedEntries;
+
+	/** Index of the next sliced entry to consider, so slicing resumes where the previous frame ran out */
+	int32 SliceCursor = 0;
+
+	bool bIsTicking = false;
+	bool bNeedsCompaction = false;
+};
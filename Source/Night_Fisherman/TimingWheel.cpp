@@ -0,0 +1,181 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TimingWheel.h"
+
+FTimingWheel::FTimingWheel()
+{
+	Reset();
+}
+
+void FTimingWheel::Reset(uint64 Tick)
+{
+	Events.Reset();
+	FirstFree = INDEX_NONE;
+	NumPending = 0;
+
+	for (int32& Head : Heads)
+	{
+		Head = INDEX_NONE;
+	}
+	for (uint64& Mask : Occupied)
+	{
+		Mask = 0;
+	}
+	CurrentTick = Tick;
+}
+
+FTimingWheelHandle FTimingWheel::Schedule(uint64 Tick, uint32 Payload)
+{
+	int32 Index = FirstFree;
+	if (Index != INDEX_NONE)
+	{
+		FirstFree = Events[Index].Next;
+	}
+	else
+	{
+		Index = Events.AddUninitialized();
+		Events[Index].Serial = 0;
+	}
+
+	FEvent& Event = Events[Index];
+	Event.Tick = FMath::Max(Tick, CurrentTick);
+	Event.Payload = Payload;
+	Link(Index);
+	++NumPending;
+
+	return { Index, Event.Serial };
+}
+
+bool FTimingWheel::Cancel(FTimingWheelHandle Handle)
+{
+	if (!IsPending(Handle))
+	{
+		return false;
+	}
+
+	Unlink(Handle.Index);
+	Release(Handle.Index);
+	return true;
+}
+
+bool FTimingWheel::IsPending(FTimingWheelHandle Handle) const
+{
+	return Events.IsValidIndex(Handle.Index) && Events[Handle.Index].Serial == Handle.Serial && Events[Handle.Index].Slot != FreeSlot;
+}
+
+void FTimingWheel::Advance(uint64 Tick, TArray<uint32>& OutFired)
+{
+	while (CurrentTick <= Tick)
+	{
+		const uint64 Slot = CurrentTick & SlotMask;
+
+		// Starting a turn of the lowest wheel: bring the events of the slot now current on each level above down
+		if (Slot == 0)
+		{
+			for (int32 Level = 1; Level < NumLevels; ++Level)
+			{
+				const uint64 LevelSlot = (CurrentTick >> (SlotBits * Level)) & SlotMask;
+				for (int32 Index = DetachSlot(Level * NumSlots + static_cast<int32>(LevelSlot)); Index != INDEX_NONE;)
+				{
+					const int32 Next = Events[Index].Next;
+					Link(Index);
+					Index = Next;
+				}
+				if (LevelSlot != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		// Jump to the next occupied slot of this turn, or to the start of the next turn
+		const uint64 Pending = Occupied[0] >> Slot;
+		const uint64 TurnEnd = CurrentTick - Slot + NumSlots;
+		const uint64 NextTick = Pending ? CurrentTick + FMath::CountTrailingZeros64(Pending) : TurnEnd;
+		if (NextTick > Tick)
+		{
+			CurrentTick = FMath::Min(TurnEnd, Tick + 1);
+			continue;
+		}
+		if (NextTick == TurnEnd)
+		{
+			CurrentTick = TurnEnd;
+			continue;
+		}
+
+		for (int32 Index = DetachSlot(static_cast<int32>(NextTick & SlotMask)); Index != INDEX_NONE;)
+		{
+			const int32 Next = Events[Index].Next;
+			OutFired.Add(Events[Index].Payload);
+			Release(Index);
+			Index = Next;
+		}
+		CurrentTick = NextTick + 1;
+	}
+}
+
+void FTimingWheel::Link(int32 Index)
+{
+	FEvent& Event = Events[Index];
+	const uint64 Delta = Event.Tick - CurrentTick;
+
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && Delta >> (SlotBits * (Level + 1)) != 0)
+	{
+		++Level;
+	}
+
+	// Beyond the top wheel's reach: park at its far end, to be rescheduled from there
+	constexpr uint64 MaxDelta = (uint64(1) << (SlotBits * NumLevels)) - 1;
+	const uint64 PlacedTick = Delta > MaxDelta ? CurrentTick + MaxDelta : Event.Tick;
+
+	const int32 Slot = Level * NumSlots + static_cast<int32>((PlacedTick >> (SlotBits * Level)) & SlotMask);
+	Event.Slot = static_cast<uint16>(Slot);
+	Event.Prev = INDEX_NONE;
+	Event.Next = Heads[Slot];
+	if (Event.Next != INDEX_NONE)
+	{
+		Events[Event.Next].Prev = Index;
+	}
+	Heads[Slot] = Index;
+	Occupied[Level] |= uint64(1) << (Slot & SlotMask);
+}
+
+void FTimingWheel::Unlink(int32 Index)
+{
+	const FEvent& Event = Events[Index];
+	if (Event.Prev != INDEX_NONE)
+	{
+		Events[Event.Prev].Next = Event.Next;
+	}
+	else
+	{
+		Heads[Event.Slot] = Event.Next;
+		if (Event.Next == INDEX_NONE)
+		{
+			Occupied[Event.Slot / NumSlots] &= ~(uint64(1) << (Event.Slot & SlotMask));
+		}
+	}
+	if (Event.Next != INDEX_NONE)
+	{
+		Events[Event.Next].Prev = Event.Prev;
+	}
+}
+
+void FTimingWheel::Release(int32 Index)
+{
+	FEvent& Event = Events[Index];
+	++Event.Serial;
+	Event.Slot = FreeSlot;
+	Event.Next = FirstFree;
+	FirstFree = Index;
+	--NumPending;
+}
+
+int32 FTimingWheel::DetachSlot(int32 Slot)
+{
+	const int32 First = Heads[Slot];
+	Heads[Slot] = INDEX_NONE;
+	Occupied[Slot / NumSlots] &= ~(uint64(1) << (Slot & SlotMask));
+	return First;
+}
@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Names an event scheduled on an FTimingWheel; goes stale once the event fires or is cancelled */
+struct FTimingWheelHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	void Reset() { *this = FTimingWheelHandle(); }
+};
+
+/**
+ * Hierarchical timing wheel over integer ticks: NumLevels wheels of NumSlots slots, each slot of a level
+ * spanning a whole turn of the level below. Events live in one pooled array and are threaded into their
+ * slot's intrusive list, so scheduling and cancelling are O(1) and never allocate once the pool has grown.
+ *
+ * Advancing costs a few bit operations per turn of the lowest wheel plus the events that fire or move down a
+ * level, however many are pending: empty slots are skipped with the per-level occupancy masks. Events further
+ * out than the top wheel reaches are parked at its far end and rescheduled each time it comes round.
+ */
+class NIGHT_FISHERMAN_API FTimingWheel
+{
+public:
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 NumSlots = 1 << SlotBits;
+	static constexpr int32 NumLevels = 4;
+
+	FTimingWheel();
+
+	/** Drops every event and restarts the wheel at Tick */
+	void Reset(uint64 Tick = 0);
+
+	/** Schedules Payload to fire at Tick, or at the next Advance if Tick has already passed */
+	FTimingWheelHandle Schedule(uint64 Tick, uint32 Payload);
+
+	/** Removes a pending event, returning false if it already fired or was cancelled */
+	bool Cancel(FTimingWheelHandle Handle);
+
+	bool IsPending(FTimingWheelHandle Handle) const;
+
+	/** Fires every event due up to and including Tick, appending their payloads tick by tick; events due at the same tick come in no particular order */
+	void Advance(uint64 Tick, TArray<uint32>& OutFired);
+
+	/** The next tick Advance will fire */
+	uint64 GetCurrentTick() const { return CurrentTick; }
+
+	int32 Num() const { return NumPending; }
+
+	SIZE_T GetAllocatedSize() const { return Events.GetAllocatedSize(); }
+
+private:
+	static constexpr uint64 SlotMask = NumSlots - 1;
+	static constexpr uint16 FreeSlot = MAX_uint16;
+
+	struct FEvent
+	{
+		uint64 Tick;
+		uint32 Payload;
+		uint32 Serial;
+		int32 Prev;
+		/** Next event in the slot, or in the free list once fired */
+		int32 Next;
+		/** Level * NumSlots + slot, or FreeSlot */
+		uint16 Slot;
+	};
+
+	/** Threads an event into the slot its tick falls in as seen from CurrentTick */
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+	void Release(int32 Index);
+
+	/** Unthreads every event of a slot, returning the first one */
+	int32 DetachSlot(int32 Slot);
+
+	TArray<FEvent> Events;
+	int32 FirstFree = INDEX_NONE;
+	int32 NumPending = 0;
+
+	int32 Heads[NumLevels * NumSlots];
+	uint64 Occupied[NumLevels];
+	uint64 CurrentTick = 0;
+};
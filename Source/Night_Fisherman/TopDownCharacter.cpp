@@ -1,18 +1,42 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TopDownCharacter.h"
+#include "Night_Fisherman.h"
+#include "ActionLatencySubsystem.h"
+#include "BiteSubsystem.h"
+#include "CameraOcclusionComponent.h"
+#include "CameraRigComponent.h"
+#include "CombatHitSubsystem.h"
+#include "DashComponent.h"
+#include "FishingLineSubsystem.h"
+#include "FishPopulationSubsystem.h"
+#include "GameplayEventTrace.h"
+#include "HurtboxComponent.h"
+#include "InteractableComponent.h"
+#include "InteractionSubsystem.h"
+#include "InputReplaySubsystem.h"
+#include "InventoryComponent.h"
+#include "MovementBasisComponent.h"
+#include "PauseSubsystem.h"
+#include "PredictiveStreamingSourceComponent.h"
+#include "ProjectileSubsystem.h"
+#include "SpriteAnimatorComponent.h"
+#include "NightFishermanBenchmark.h"
 #include "Camera/CameraComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "InputAction.h"
 #include "InputActionValue.h"
 
 // Sets default values
 ATopDownCharacter::ATopDownCharacter()
 {
-	// Set this character to call Tick() every frame
+	// Tick only while there is per-frame work, see SetTickWork
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// Don't rotate character to camera direction
 	bUseControllerRotationPitch = false;
@@ -37,6 +61,36 @@ ATopDownCharacter::ATopDownCharacter()
 	TopDownCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("TopDownCamera"));
 	TopDownCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	TopDownCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
+
+	// Coalesce camera input into one boom update per frame
+	CameraRig = CreateDefaultSubobject<UCameraRigComponent>(TEXT("CameraRig"));
+	CameraRig->SetBoom(CameraBoom);
+
+	// Fade occluders instead of pulling the camera in with per-frame collision tests
+	CameraOcclusion = CreateDefaultSubobject<UCameraOcclusionComponent>(TEXT("CameraOcclusion"));
+	CameraOcclusion->SetCamera(TopDownCamera);
+
+	// Drive the sprite flipbooks from a state table instead of an animation graph
+	SpriteAnimator = CreateDefaultSubobject<USpriteAnimatorComponent>(TEXT("SpriteAnimator"));
+
+	// Cache the movement axes instead of rebuilding them on every move event
+	MovementBasis = CreateDefaultSubobject<UMovementBasisComponent>(TEXT("MovementBasis"));
+
+	// Dodge dashes along a precomputed curve instead of root motion
+	Dash = CreateDefaultSubobject<UDashComponent>(TEXT("Dash"));
+
+	// Stream World Partition cells along the way the character is heading, dashes included
+	StreamingSource = CreateDefaultSubobject<UPredictiveStreamingSourceComponent>(TEXT("StreamingSource"));
+	StreamingSource->SetDash(Dash);
+
+	// Fixed-size item storage backed by the shared item table
+	Inventory = CreateDefaultSubobject<UInventoryComponent>(TEXT("Inventory"));
+
+	// Create a hurtbox matching the capsule
+	Hurtbox = CreateDefaultSubobject<UHurtboxComponent>(TEXT("Hurtbox"));
+	Hurtbox->SetupAttachment(RootComponent);
+	Hurtbox->Radius = GetCapsuleComponent()->GetUnscaledCapsuleRadius();
+	Hurtbox->HalfHeight = GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight() - Hurtbox->Radius;
 }
 
 // Called when the game starts or when spawned
@@ -52,166 +106,465 @@ void ATopDownCharacter::BeginPlay()
 			Subsystem->AddMappingContext(DefaultMappingContext, 0);
 		}
 	}
+
+	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(ATopDownCharacter, ReceiveTick)))
+	{
+		ActiveTickWork |= ETopDownTickWork::Blueprint;
+	}
+	UpdateTickRegistration();
+}
+
+// Called when the game ends or the character is removed
+void ATopDownCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ActiveTickWork = ETopDownTickWork::None;
+	UpdateTickRegistration();
+
+	// Lines left in the water would keep their slot until their next bite
+	if (UBiteSubsystem* Bites = GetWorld()->GetSubsystem<UBiteSubsystem>())
+	{
+		FFishSighting Unused;
+		Bites->ReelIn(BiteLine, Unused);
+	}
+	if (UFishingLineSubsystem* Lines = GetWorld()->GetSubsystem<UFishingLineSubsystem>())
+	{
+		Lines->RemoveLine(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// Called when the controller changes, which changes the character's tick budget priority
+void ATopDownCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	// Only the view's own character needs occlusion handling
+	const bool bLocallyControlled = IsLocallyControlled();
+	if (!bLocallyControlled)
+	{
+		CameraOcclusion->ClearOccluders();
+	}
+	SetTickWork(ETopDownTickWork::Occlusion, bLocallyControlled);
+
+	// The local player's world streams from its character rather than its view
+	StreamingSource->SetPlayerController(bLocallyControlled ? Cast<APlayerController>(Controller) : nullptr);
+
+	UpdateTickRegistration();
+}
+
+void ATopDownCharacter::SetTickWork(ETopDownTickWork Work, bool bActive)
+{
+	const ETopDownTickWork PreviousTickWork = ActiveTickWork;
+	if (bActive)
+	{
+		ActiveTickWork |= Work;
+	}
+	else
+	{
+		ActiveTickWork &= ~Work;
+	}
+
+	if (ActiveTickWork != PreviousTickWork && HasActorBegunPlay())
+	{
+		UpdateTickRegistration();
+	}
 }
 
-// Called every frame
+void ATopDownCharacter::UpdateTickRegistration()
+{
+	SetActorTickEnabled(EnumHasAnyFlags(ActiveTickWork, ETopDownTickWork::Blueprint));
+
+	UTickBudgetSubsystem* TickBudget = GetWorld() ? GetWorld()->GetSubsystem<UTickBudgetSubsystem>() : nullptr;
+	if (!TickBudget)
+	{
+		return;
+	}
+
+	// Everything except Blueprint Event Tick runs batched; the local player is never time-sliced
+	if (EnumHasAnyFlags(ActiveTickWork, ~ETopDownTickWork::Blueprint))
+	{
+		TickBudget->Register(this, IsLocallyControlled() ? ETickBudgetPriority::Critical : ETickBudgetPriority::Normal);
+	}
+	else if (TickBudget->IsRegistered(this))
+	{
+		TickBudget->Unregister(this);
+	}
+}
+
+// Called every frame while a Blueprint subclass needs Event Tick
 void ATopDownCharacter::Tick(float DeltaTime)
 {
+	NF_BENCHMARK_CHARACTER_TICK_SCOPE();
+
 	Super::Tick(DeltaTime);
 }
 
+// Called by the tick budget subsystem while the character has per-frame work
+void ATopDownCharacter::BudgetedTick(float DeltaTime)
+{
+	NF_BENCHMARK_CHARACTER_TICK_SCOPE();
+
+	if (EnumHasAnyFlags(ActiveTickWork, ETopDownTickWork::Camera) && !CameraRig->Update(DeltaTime))
+	{
+		SetTickWork(ETopDownTickWork::Camera, false);
+	}
+
+	if (EnumHasAnyFlags(ActiveTickWork, ETopDownTickWork::Occlusion))
+	{
+		CameraOcclusion->Update(DeltaTime);
+	}
+
+	if (EnumHasAnyFlags(ActiveTickWork, ETopDownTickWork::Dash))
+	{
+		const bool bStillDashing = Dash->Advance(DeltaTime);
+		Hurtbox->bInvulnerable = Dash->IsInvulnerable();
+		if (!bStillDashing)
+		{
+			SetTickWork(ETopDownTickWork::Dash, false);
+		}
+	}
+}
+
 // Called to bind functionality to input
 void ATopDownCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
 
+	// Button actions are timed from press to visible effect
+	UActionLatencySubsystem* Latency = GetWorld()->GetSubsystem<UActionLatencySubsystem>();
+	auto TrackLatency = [this, Latency](ETopDownInputAction Action, const UInputAction* InputAction)
+	{
+		if (Latency)
+		{
+			Latency->TrackAction(Action, InputAction, DefaultMappingContext);
+		}
+	};
+
 	// Set up action bindings
 	if (UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent))
 	{
 		// Moving
 		if (MoveAction)
 		{
-			EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &ATopDownCharacter::Move);
+			EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::Move);
 		}
 
 		// Camera Control
 		if (CameraControlAction)
 		{
-			EnhancedInputComponent->BindAction(CameraControlAction, ETriggerEvent::Triggered, this, &ATopDownCharacter::CameraControl);
+			EnhancedInputComponent->BindAction(CameraControlAction, ETriggerEvent::Triggered, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::CameraControl);
 		}
 
 		// Interact
 		if (InteractAction)
 		{
-			EnhancedInputComponent->BindAction(InteractAction, ETriggerEvent::Started, this, &ATopDownCharacter::Interact);
+			EnhancedInputComponent->BindAction(InteractAction, ETriggerEvent::Started, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::Interact);
+			TrackLatency(ETopDownInputAction::Interact, InteractAction);
 		}
 
 		// Attack
 		if (AttackAction)
 		{
-			EnhancedInputComponent->BindAction(AttackAction, ETriggerEvent::Started, this, &ATopDownCharacter::Attack);
+			EnhancedInputComponent->BindAction(AttackAction, ETriggerEvent::Started, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::Attack);
+			TrackLatency(ETopDownInputAction::Attack, AttackAction);
 		}
 
 		// Heavy Attack
 		if (HeavyAttackAction)
 		{
-			EnhancedInputComponent->BindAction(HeavyAttackAction, ETriggerEvent::Started, this, &ATopDownCharacter::HeavyAttack);
+			EnhancedInputComponent->BindAction(HeavyAttackAction, ETriggerEvent::Started, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::HeavyAttack);
+			TrackLatency(ETopDownInputAction::HeavyAttack, HeavyAttackAction);
 		}
 
 		// Dodge
 		if (DodgeAction)
 		{
-			EnhancedInputComponent->BindAction(DodgeAction, ETriggerEvent::Started, this, &ATopDownCharacter::Dodge);
+			EnhancedInputComponent->BindAction(DodgeAction, ETriggerEvent::Started, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::Dodge);
+			TrackLatency(ETopDownInputAction::Dodge, DodgeAction);
 		}
 
 		// Use Item
 		if (UseItemAction)
 		{
-			EnhancedInputComponent->BindAction(UseItemAction, ETriggerEvent::Started, this, &ATopDownCharacter::UseItem);
+			EnhancedInputComponent->BindAction(UseItemAction, ETriggerEvent::Started, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::UseItem);
+			TrackLatency(ETopDownInputAction::UseItem, UseItemAction);
 		}
 
 		// Pause Menu
 		if (PauseMenuAction)
 		{
-			EnhancedInputComponent->BindAction(PauseMenuAction, ETriggerEvent::Started, this, &ATopDownCharacter::PauseMenu);
+			// Enhanced Input skips actions while the game is paused unless the asset opts in, and this one has to resume it
+			if (!PauseMenuAction->bTriggerWhenPaused)
+			{
+				UE_LOG(LogNightFisherman, Warning, TEXT("%s does not have Trigger when Paused set, so the game cannot be resumed with it"), *PauseMenuAction->GetName());
+			}
+			EnhancedInputComponent->BindAction(PauseMenuAction, ETriggerEvent::Started, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::PauseMenu);
+			TrackLatency(ETopDownInputAction::PauseMenu, PauseMenuAction);
+		}
+
+		// Zoom
+		if (ZoomAction)
+		{
+			EnhancedInputComponent->BindAction(ZoomAction, ETriggerEvent::Triggered, this, &ATopDownCharacter::HandleBoundInput, ETopDownInputAction::Zoom);
 		}
 	}
 }
 
-void ATopDownCharacter::Move(const FInputActionValue& Value)
+void ATopDownCharacter::HandleBoundInput(const FInputActionValue& Value, ETopDownInputAction Action)
 {
-	// Input is a Vector2D
-	FVector2D MovementVector = Value.Get<FVector2D>();
+	if (UInputReplaySubsystem* Replays = GetWorld()->GetSubsystem<UInputReplaySubsystem>())
+	{
+		// A replay owns the character's input; live input would make it diverge
+		if (Replays->IsReplaying(this))
+		{
+			return;
+		}
+		Replays->RecordInput(this, Action, Value);
+	}
 
-	if (Controller != nullptr)
+	if (UActionLatencySubsystem* Latency = GetWorld()->GetSubsystem<UActionLatencySubsystem>())
 	{
-		// Find out which way is forward
-		const FRotator Rotation = Controller->GetControlRotation();
-		const FRotator YawRotation(0, Rotation.Yaw, 0);
+		Latency->BeginAction(Action);
+	}
 
-		// Get forward vector
-		const FVector ForwardDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
-	
-		// Get right vector 
-		const FVector RightDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
+	InjectInput(Action, Value);
+}
 
-		// Add movement 
-		AddMovementInput(ForwardDirection, MovementVector.Y);
-		AddMovementInput(RightDirection, MovementVector.X);
+void ATopDownCharacter::InjectInput(ETopDownInputAction Action, const FInputActionValue& Value)
+{
+	switch (Action)
+	{
+	case ETopDownInputAction::Move:
+		Move(Value);
+		break;
+	case ETopDownInputAction::CameraControl:
+		CameraControl(Value);
+		break;
+	case ETopDownInputAction::Interact:
+		Interact(Value);
+		break;
+	case ETopDownInputAction::Attack:
+		Attack(Value);
+		break;
+	case ETopDownInputAction::HeavyAttack:
+		HeavyAttack(Value);
+		break;
+	case ETopDownInputAction::Dodge:
+		Dodge(Value);
+		break;
+	case ETopDownInputAction::UseItem:
+		UseItem(Value);
+		break;
+	case ETopDownInputAction::PauseMenu:
+		PauseMenu(Value);
+		break;
+	case ETopDownInputAction::Zoom:
+		Zoom(Value);
+		break;
+	default:
+		checkNoEntry();
+		break;
 	}
 }
 
+void ATopDownCharacter::Move(const FInputActionValue& Value)
+{
+	// The dash owns the character's position until it finishes
+	if (Dash->IsDashing())
+	{
+		return;
+	}
+
+	// Input is a Vector2D
+	FVector2D MovementVector = Value.Get<FVector2D>();
+
+	// Add movement along the cached control yaw axes
+	MovementBasis->AddMovementInput(MovementVector);
+}
+
 void ATopDownCharacter::CameraControl(const FInputActionValue& Value)
 {
 	// Input is a Vector2D
 	FVector2D CameraVector = Value.Get<FVector2D>();
 
-	// Implement camera rotation or zoom logic here
-	// Example: Rotate camera boom around character
-	if (CameraBoom)
-	{
-		// Rotate the camera boom based on input
-		FRotator NewRotation = CameraBoom->GetRelativeRotation();
-		NewRotation.Yaw += CameraVector.X * 2.0f; // Horizontal rotation
-		
-		// Optionally adjust pitch (vertical angle) with limits
-		float NewPitch = NewRotation.Pitch + CameraVector.Y * 2.0f;
-		NewPitch = FMath::Clamp(NewPitch, -80.0f, -20.0f); // Limit camera angle
-		NewRotation.Pitch = NewPitch;
-		
-		CameraBoom->SetRelativeRotation(NewRotation);
-	}
+	// Rotate the camera boom around the character, applied once per frame in BudgetedTick
+	CameraRig->AddRotationInput(CameraVector);
+	SetTickWork(ETopDownTickWork::Camera, true);
 }
 
 void ATopDownCharacter::Interact(const FInputActionValue& Value)
 {
-	// Implement interaction logic here
-	UE_LOG(LogTemp, Warning, TEXT("Interact action triggered!"));
+	NF_GAMEPLAY_EVENT(InputAction, this, ETopDownInputAction::Interact);
 	
-	// Example: Perform a line trace to detect interactable objects
-	// Then call their interaction function
+	UFishPopulationSubsystem* FishPopulation = GetWorld()->GetSubsystem<UFishPopulationSubsystem>();
+	UBiteSubsystem* Bites = GetWorld()->GetSubsystem<UBiteSubsystem>();
+	UFishingLineSubsystem* Lines = GetWorld()->GetSubsystem<UFishingLineSubsystem>();
+
+	// A cast line is reeled in before anything else, landing the fish on the hook if there is one
+	if (FishPopulation && FishPopulation->HasLineCast(this))
+	{
+		FishPopulation->ReelIn(this);
+
+		FFishSighting Hooked;
+		const bool bCaught = Bites && Bites->ReelIn(BiteLine, Hooked);
+		BiteLine.Reset();
+		if (Lines)
+		{
+			Lines->ReelIn(this);
+		}
+
+		const FItemTable* Items = Inventory->GetItemTable();
+		if (bCaught && Items && Inventory->AddItem(Items->GetFishItem(Hooked.Species)) > 0)
+		{
+			FishPopulation->CatchFish(Hooked.FishIndex);
+		}
+		MarkActionEffect(ETopDownInputAction::Interact);
+		return;
+	}
+
+	// Use the nearest interactable in front of the character
+	if (UInteractionSubsystem* Interaction = GetWorld()->GetSubsystem<UInteractionSubsystem>())
+	{
+		if (UInteractableComponent* Interactable = Interaction->FindInCone(GetActorLocation(), GetActorForwardVector(), InteractDistance, InteractHalfAngle, this))
+		{
+			Interactable->Interact(this);
+			MarkActionEffect(ETopDownInputAction::Interact);
+			return;
+		}
+	}
+
+	// Otherwise cast the fishing line ahead of the character
+	if (FishPopulation)
+	{
+		NearbyFish.Reset();
+		LureLocation = GetActorLocation() + GetActorForwardVector() * CastDistance;
+		FishPopulation->CastLine(this, LureLocation, LureRadius);
+		FishPopulation->GetFishNear(LureLocation, LureRadius, NearbyFish);
+		if (Bites)
+		{
+			BiteLine = Bites->CastLine(this, NearbyFish, bBaited ? BaitedCatchReadiness : CatchReadiness);
+			bBaited = false;
+		}
+		if (Lines)
+		{
+			Lines->CastLine(this, RodTipOffset, LureLocation);
+		}
+		SpriteAnimator->PlayAction(ESpriteAnimState::Use);
+		MarkActionEffect(ETopDownInputAction::Interact);
+	}
 }
 
 void ATopDownCharacter::Attack(const FInputActionValue& Value)
 {
-	// Implement attack logic here
-	UE_LOG(LogTemp, Warning, TEXT("Attack action triggered!"));
+	NF_GAMEPLAY_EVENT(InputAction, this, ETopDownInputAction::Attack);
 	
-	// Example: Play attack animation, spawn projectile, etc.
+	if (bAttackFiresProjectile)
+	{
+		FireProjectile();
+	}
+	else
+	{
+		QueueSwing(AttackRadius, AttackDamage);
+	}
+	MarkActionEffect(ETopDownInputAction::Attack);
 }
 
 void ATopDownCharacter::HeavyAttack(const FInputActionValue& Value)
 {
-	// Implement heavy attack logic here
-	UE_LOG(LogTemp, Warning, TEXT("Heavy Attack action triggered!"));
+	NF_GAMEPLAY_EVENT(InputAction, this, ETopDownInputAction::HeavyAttack);
 	
-	// Example: Play heavy attack animation, deal more damage, etc.
+	QueueSwing(HeavyAttackRadius, HeavyAttackDamage);
+	MarkActionEffect(ETopDownInputAction::HeavyAttack);
 }
 
 void ATopDownCharacter::Dodge(const FInputActionValue& Value)
 {
-	// Implement dodge/roll logic here
-	UE_LOG(LogTemp, Warning, TEXT("Dodge action triggered!"));
+	NF_GAMEPLAY_EVENT(InputAction, this, ETopDownInputAction::Dodge);
 	
-	// Example: Play dodge animation, add temporary invincibility, dash in movement direction
+	// Dash in the movement direction, or straight ahead when standing still
+	const FVector InputDirection = GetLastMovementInputVector();
+	if (Dash->StartDash(InputDirection.IsNearlyZero() ? GetActorForwardVector() : InputDirection))
+	{
+		Hurtbox->bInvulnerable = Dash->IsInvulnerable();
+		SetTickWork(ETopDownTickWork::Dash, true);
+		MarkActionEffect(ETopDownInputAction::Dodge);
+	}
 }
 
 void ATopDownCharacter::UseItem(const FInputActionValue& Value)
 {
-	// Implement item usage logic here
-	UE_LOG(LogTemp, Warning, TEXT("Use Item action triggered!"));
+	NF_GAMEPLAY_EVENT(InputAction, this, ETopDownInputAction::UseItem);
 	
-	// Example: Use currently equipped item (potion, consumable, etc.)
+	// Consume one of the selected item
+	const FItemId Used = Inventory->UseSelectedItem();
+	const FItemTable* Items = Inventory->GetItemTable();
+	if (Used == NoItem || !Items)
+	{
+		return;
+	}
+
+	// Bait readies the next cast; every other effect is up to the listeners
+	const FItemTable::FEntry& Item = Items->Get(Used);
+	if (Item.Kind == EItemKind::Bait)
+	{
+		bBaited = true;
+	}
+	OnItemUsed.Broadcast(Item.Name, Item.Kind);
+
+	SpriteAnimator->PlayAction(ESpriteAnimState::Use);
+	MarkActionEffect(ETopDownInputAction::UseItem);
 }
 
 void ATopDownCharacter::PauseMenu(const FInputActionValue& Value)
 {
-	// Implement pause menu logic here
-	UE_LOG(LogTemp, Warning, TEXT("Pause Menu action triggered!"));
+	NF_GAMEPLAY_EVENT(InputAction, this, ETopDownInputAction::PauseMenu);
 	
-	// Example: Open pause menu widget, pause game
 	if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
 	{
-		// Toggle pause or open menu widget
+		// Toggle pause for the whole world; the PauseMenuAction asset has Trigger when Paused set so this runs while paused too
+		if (UPauseSubsystem* Pause = GetWorld()->GetSubsystem<UPauseSubsystem>())
+		{
+			Pause->SetPaused(!Pause->IsPaused());
+			MarkActionEffect(ETopDownInputAction::PauseMenu);
+		}
+	}
+}
+
+void ATopDownCharacter::Zoom(const FInputActionValue& Value)
+{
+	// Mouse wheel is a float axis; positive zooms in, applied once per frame in BudgetedTick
+	CameraRig->AddZoomInput(Value.Get<float>());
+	SetTickWork(ETopDownTickWork::Camera, true);
+}
+
+void ATopDownCharacter::QueueSwing(float Radius, float Damage)
+{
+	if (UCombatHitSubsystem* CombatHits = GetWorld()->GetSubsystem<UCombatHitSubsystem>())
+	{
+		const FVector Center = GetActorLocation() + GetActorForwardVector() * AttackReach;
+		CombatHits->QueueAttack(this, Center, Radius, Damage, Hurtbox->Team);
+	}
+}
+
+void ATopDownCharacter::FireProjectile()
+{
+	if (UProjectileSubsystem* Projectiles = GetWorld()->GetSubsystem<UProjectileSubsystem>())
+	{
+		if (ProjectileSprite)
+		{
+			Projectiles->SetSprite(ProjectileSprite);
+		}
+
+		const FVector Forward = GetActorForwardVector();
+		Projectiles->Fire(this, GetActorLocation() + Forward * AttackReach, Forward * ProjectileSpeed, ProjectileLifetime, ProjectileRadius, ProjectileDamage, Hurtbox->Team);
+	}
+}
+
+void ATopDownCharacter::MarkActionEffect(ETopDownInputAction Action)
+{
+	if (UActionLatencySubsystem* Latency = GetWorld()->GetSubsystem<UActionLatencySubsystem>())
+	{
+		Latency->MarkEffect(Action);
 	}
 }
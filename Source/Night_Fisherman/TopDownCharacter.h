@@ -5,15 +5,61 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "BiteSubsystem.h"
+#include "FishPopulation.h"
+#include "ItemTable.h"
+#include "TickBudgetSubsystem.h"
 #include "TopDownCharacter.generated.h"
 
 class UInputMappingContext;
 class UInputAction;
 class USpringArmComponent;
 class UCameraComponent;
+class UCameraRigComponent;
+class UCameraOcclusionComponent;
+class UMovementBasisComponent;
+class UDashComponent;
+class UInventoryComponent;
+class UPredictiveStreamingSourceComponent;
+class UHurtboxComponent;
+class USpriteAnimatorComponent;
+class UPaperSprite;
+
+/** Input actions bound by ATopDownCharacter, used to address handlers outside of Enhanced Input */
+UENUM(BlueprintType)
+enum class ETopDownInputAction : uint8
+{
+	Move,
+	CameraControl,
+	Interact,
+	Attack,
+	HeavyAttack,
+	Dodge,
+	UseItem,
+	PauseMenu,
+	Zoom,
+	Count UMETA(Hidden)
+};
+
+/** Per-frame work that keeps ATopDownCharacter ticking; with none active the character costs nothing per frame */
+enum class ETopDownTickWork : uint8
+{
+	None = 0,
+	/** A Blueprint subclass implements Event Tick, which needs the regular actor tick */
+	Blueprint = 1 << 0,
+	/** A dodge is moving the character */
+	Dash = 1 << 1,
+	/** Camera input is being applied to the boom */
+	Camera = 1 << 2,
+	/** The locally controlled character fades out whatever hides it from the camera */
+	Occlusion = 1 << 3,
+};
+ENUM_CLASS_FLAGS(ETopDownTickWork)
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FItemUsedSignature, FName, ItemName, EItemKind, Kind);
 
 UCLASS()
-class NIGHT_FISHERMAN_API ATopDownCharacter : public ACharacter
+class NIGHT_FISHERMAN_API ATopDownCharacter : public ACharacter, public IBudgetedTickable
 {
 	GENERATED_BODY()
 
@@ -21,10 +67,26 @@ public:
 	// Sets default values for this character's properties
 	ATopDownCharacter();
 
+	/** Broadcast after UseItem consumed an item; consumables apply their effect here */
+	UPROPERTY(BlueprintAssignable, Category = Inventory)
+	FItemUsedSignature OnItemUsed;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the game ends or the character is removed
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Called when the controller changes, which changes the character's tick budget priority
+	virtual void NotifyControllerChanged() override;
+
+	/** Marks per-frame work as active or finished, ticking the character only while some is active */
+	void SetTickWork(ETopDownTickWork Work, bool bActive);
+
+	/** Registers with the actor tick or the tick budget subsystem to match ActiveTickWork */
+	void UpdateTickRegistration();
+
 	/** Camera boom positioning the camera above the character */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	USpringArmComponent* CameraBoom;
@@ -33,6 +95,114 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* TopDownCamera;
 
+	/** Applies camera input to the boom once per frame */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	UCameraRigComponent* CameraRig;
+
+	/** Fades out scenery between the camera and the character */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	UCameraOcclusionComponent* CameraOcclusion;
+
+	/** Picks the sprite flipbook from velocity and the current action */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Animation, meta = (AllowPrivateAccess = "true"))
+	USpriteAnimatorComponent* SpriteAnimator;
+
+	/** Cached movement axes shared with AI-driven characters */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
+	UMovementBasisComponent* MovementBasis;
+
+	/** Dash performed by Dodge */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
+	UDashComponent* Dash;
+
+	/** Streams the world in ahead of the character while it is the local player's */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Streaming, meta = (AllowPrivateAccess = "true"))
+	UPredictiveStreamingSourceComponent* StreamingSource;
+
+	/** Items carried by the character */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
+	UInventoryComponent* Inventory;
+
+	/** Capsule that melee swings from other characters can hit */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	UHurtboxComponent* Hurtbox;
+
+	/** How far ahead of the character a swing is centred */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float AttackReach = 100.0f;
+
+	/** Radius of an attack swing */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float AttackRadius = 80.0f;
+
+	/** Damage dealt by an attack swing */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float AttackDamage = 10.0f;
+
+	/** Radius of a heavy attack swing */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float HeavyAttackRadius = 140.0f;
+
+	/** Damage dealt by a heavy attack swing */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	float HeavyAttackDamage = 25.0f;
+
+	/** Whether Attack fires a projectile instead of swinging */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true"))
+	bool bAttackFiresProjectile = false;
+
+	/** Speed of a fired projectile */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true", EditCondition = "bAttackFiresProjectile"))
+	float ProjectileSpeed = 1200.0f;
+
+	/** Seconds a fired projectile flies before it expires */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true", EditCondition = "bAttackFiresProjectile"))
+	float ProjectileLifetime = 1.5f;
+
+	/** Radius of a fired projectile */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true", EditCondition = "bAttackFiresProjectile"))
+	float ProjectileRadius = 20.0f;
+
+	/** Damage dealt by a fired projectile */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true", EditCondition = "bAttackFiresProjectile"))
+	float ProjectileDamage = 5.0f;
+
+	/** Sprite drawn for every projectile in the world */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Combat, meta = (AllowPrivateAccess = "true", EditCondition = "bAttackFiresProjectile"))
+	UPaperSprite* ProjectileSprite;
+
+	/** How far away an interactable can be and still be used */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Interaction, meta = (AllowPrivateAccess = "true"))
+	float InteractDistance = 250.0f;
+
+	/** Half angle of the cone in front of the character searched for interactables */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Interaction, meta = (AllowPrivateAccess = "true", ClampMin = "0.0", ClampMax = "180.0"))
+	float InteractHalfAngle = 60.0f;
+
+	/** How far ahead of the character Interact casts the fishing line */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (AllowPrivateAccess = "true"))
+	float CastDistance = 400.0f;
+
+	/** Radius around the lure in which fish notice it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (AllowPrivateAccess = "true"))
+	float LureRadius = 600.0f;
+
+	/** Where the fishing line leaves the rod, relative to the character */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (AllowPrivateAccess = "true"))
+	FVector RodTipOffset = FVector(40.0f, 0.0f, 60.0f);
+
+	/** Bite readiness a fish near the lure needs when the line is cast to bite at all */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (AllowPrivateAccess = "true", ClampMin = "0.0", ClampMax = "1.0"))
+	float CatchReadiness = 0.75f;
+
+	/** Bite readiness asked of fish on the first cast after using bait, so less eager fish bite too */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Fishing, meta = (AllowPrivateAccess = "true", ClampMin = "0.0", ClampMax = "1.0"))
+	float BaitedCatchReadiness = 0.25f;
+
+	/** Fish near the lure when the line was last cast, nearest first */
+	UPROPERTY(BlueprintReadOnly, Category = Fishing, meta = (AllowPrivateAccess = "true"))
+	TArray<FFishSighting> NearbyFish;
+
 	/** MappingContext */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputMappingContext* DefaultMappingContext;
@@ -65,10 +235,17 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputAction* UseItemAction;
 
-	/** Pause Menu Input Action */
+	/** Pause Menu Input Action; needs Trigger when Paused set on the asset to resume the game */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputAction* PauseMenuAction;
 
+	/** Zoom Input Action */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
+	UInputAction* ZoomAction;
+
+	/** Every Enhanced Input binding lands here: records the value for UInputReplaySubsystem, or drops it during a replay, then calls the handler */
+	void HandleBoundInput(const FInputActionValue& Value, ETopDownInputAction Action);
+
 	/** Called for movement input */
 	void Move(const FInputActionValue& Value);
 
@@ -93,15 +270,64 @@ protected:
 	/** Called for pause menu input */
 	void PauseMenu(const FInputActionValue& Value);
 
+	/** Called for zoom input */
+	void Zoom(const FInputActionValue& Value);
+
+	/** Queues a swing ahead of the character, resolved with every other swing at the end of the frame */
+	void QueueSwing(float Radius, float Damage);
+
+	/** Fires a pooled projectile along the character's facing */
+	void FireProjectile();
+
+	/** Tells UActionLatencySubsystem a pressed action just had its first visible effect */
+	void MarkActionEffect(ETopDownInputAction Action);
+
+private:
+	/** Where the lure went in when the line was last cast */
+	FVector LureLocation = FVector::ZeroVector;
+
+	/** The cast line waiting for a bite */
+	FBiteLineHandle BiteLine;
+
+	/** Bait was used since the line was last cast */
+	bool bBaited = false;
+
+	/** Per-frame work currently keeping the character ticking */
+	ETopDownTickWork ActiveTickWork = ETopDownTickWork::None;
+
 public:
-	// Called every frame
+	// Called every frame while a Blueprint subclass needs Event Tick
 	virtual void Tick(float DeltaTime) override;
 
+	// Called by the tick budget subsystem while the character has per-frame work
+	virtual void BudgetedTick(float DeltaTime) override;
+
 	// Called to bind functionality to input
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
+	/** Routes an input value to the matching action handler as if Enhanced Input had triggered it */
+	void InjectInput(ETopDownInputAction Action, const FInputActionValue& Value);
+
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	/** Returns TopDownCamera subobject **/
 	FORCEINLINE UCameraComponent* GetTopDownCamera() const { return TopDownCamera; }
+	/** Returns CameraRig subobject **/
+	FORCEINLINE UCameraRigComponent* GetCameraRig() const { return CameraRig; }
+	/** Returns CameraOcclusion subobject **/
+	FORCEINLINE UCameraOcclusionComponent* GetCameraOcclusion() const { return CameraOcclusion; }
+	/** Returns SpriteAnimator subobject **/
+	FORCEINLINE USpriteAnimatorComponent* GetSpriteAnimator() const { return SpriteAnimator; }
+	/** Returns MovementBasis subobject **/
+	FORCEINLINE UMovementBasisComponent* GetMovementBasis() const { return MovementBasis; }
+	/** Returns Dash subobject **/
+	FORCEINLINE UDashComponent* GetDash() const { return Dash; }
+	/** Returns StreamingSource subobject **/
+	FORCEINLINE UPredictiveStreamingSourceComponent* GetStreamingSource() const { return StreamingSource; }
+	/** Returns Inventory subobject **/
+	FORCEINLINE UInventoryComponent* GetInventory() const { return Inventory; }
+	/** Returns Hurtbox subobject **/
+	FORCEINLINE UHurtboxComponent* GetHurtbox() const { return Hurtbox; }
+	/** Returns the character's line in UBiteSubsystem, invalid while none is cast **/
+	FORCEINLINE FBiteLineHandle GetBiteLine() const { return BiteLine; }
 };